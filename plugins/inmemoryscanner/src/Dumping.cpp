@@ -5,6 +5,11 @@
 #include <algorithm>
 #include <iostream>
 
+namespace
+{
+    constexpr size_t pageSizeInBytes = 4096;
+}
+
 Dumping::Dumping(const Plugin::PluginInterface* pluginInterface, std::shared_ptr<IConfig> configuration)
     : pluginInterface(pluginInterface), configuration(std::move(configuration))
 {
@@ -16,7 +21,7 @@ Dumping::Dumping(const Plugin::PluginInterface* pluginInterface, std::shared_ptr
 void Dumping::dumpMemoryRegion(const std::string& processName,
                                pid_t pid,
                                const MemoryRegion& memoryRegionDescriptor,
-                               const std::vector<uint8_t>& data)
+                               const IMemoryMapping& memoryMapping)
 {
     auto memoryRegionInformation =
         createMemoryRegionInformation(processName, pid, memoryRegionDescriptor, getNextRegionId());
@@ -29,7 +34,7 @@ void Dumping::dumpMemoryRegion(const std::string& processName,
                                     " from Process: " + processName + " : " + std::to_string(pid) +
                                     " Module: " + memoryRegionInformation->moduleName + " to " + inMemDumpFileName);
 
-    pluginInterface->writeToFile(dumpingPath / inMemDumpFileName, data);
+    pluginInterface->writeToFile(dumpingPath / inMemDumpFileName, createPaddedDump(memoryMapping));
 
     auto inMemRegionInfo = memoryRegionInformation->toString();
 
@@ -65,6 +70,28 @@ std::unique_ptr<MemoryRegionInformation> Dumping::createMemoryRegionInformation(
     return memRegionInformationUniquePointer;
 }
 
+// Keeps the dump layout of readProcessMemoryRegion: every run of unmapped pages is replaced by a single zero page.
+std::vector<uint8_t> Dumping::createPaddedDump(const IMemoryMapping& memoryMapping)
+{
+    std::vector<uint8_t> data;
+    data.reserve(memoryMapping.getSizeInGuest());
+    auto nextExpectedVA = memoryMapping.getBaseVA();
+    for (const auto& mappedRegion : memoryMapping.getMappedRegions())
+    {
+        if (mappedRegion.guestBaseVA != nextExpectedVA)
+        {
+            data.insert(data.end(), pageSizeInBytes, 0x0);
+        }
+        data.insert(data.end(), mappedRegion.mapping.begin(), mappedRegion.mapping.end());
+        nextExpectedVA = mappedRegion.guestBaseVA + mappedRegion.mapping.size();
+    }
+    if (nextExpectedVA != memoryMapping.getBaseVA() + memoryMapping.getSizeInGuest())
+    {
+        data.insert(data.end(), pageSizeInBytes, 0x0);
+    }
+    return data;
+}
+
 int Dumping::getNextRegionId()
 {
     std::scoped_lock guard(counterLock);
@@ -119,7 +119,7 @@ class IDumping
     virtual void dumpMemoryRegion(const std::string& processName,
                                   pid_t pid,
                                   const MemoryRegion& memoryRegionDescriptor,
-                                  const std::vector<uint8_t>& data) = 0;
+                                  const IMemoryMapping& memoryMapping) = 0;
 
     virtual std::vector<std::string> getAllMemoryRegionInformation() = 0;
 
@@ -138,7 +138,7 @@ class Dumping : public IDumping
     void dumpMemoryRegion(const std::string& processName,
                           pid_t pid,
                           const MemoryRegion& memoryRegionDescriptor,
-                          const std::vector<uint8_t>& data) override;
+                          const IMemoryMapping& memoryMapping) override;
 
     std::vector<std::string> getAllMemoryRegionInformation() override;
 
@@ -156,6 +156,8 @@ class Dumping : public IDumping
     static std::unique_ptr<MemoryRegionInformation> createMemoryRegionInformation(
         const std::string& processName, pid_t pid, const MemoryRegion& memoryRegionDescriptor, int regionId);
 
+    static std::vector<uint8_t> createPaddedDump(const IMemoryMapping& memoryMapping);
+
     int getNextRegionId();
 
     void appendRegionInfo(const std::string& regionInfo);
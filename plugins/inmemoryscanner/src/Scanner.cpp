@@ -63,17 +63,18 @@ void Scanner::scanMemoryRegion(pid_t pid, const std::string& processName, const
         }
 
         pluginInterface->logMessage(
-            Plugin::LogLevel::debug, LOG_FILENAME, "Start getProcessMemoryRegion with size: " + intToHex(scanSize));
+            Plugin::LogLevel::debug, LOG_FILENAME, "Start mapProcessMemoryRegion with size: " + intToHex(scanSize));
 
-        auto memoryRegion = pluginInterface->readProcessMemoryRegion(pid, memoryRegionDescriptor.base, scanSize);
+        auto memoryMapping = pluginInterface->mapProcessMemoryRegion(pid, memoryRegionDescriptor.base, scanSize);
 
         pluginInterface->logMessage(Plugin::LogLevel::debug,
                                     LOG_FILENAME,
-                                    "End getProcessMemoryRegion with size: " + intToHex(memoryRegion->size()));
-        if (memoryRegion->empty())
+                                    "End mapProcessMemoryRegion with " +
+                                        std::to_string(memoryMapping->getMappedRegions().size()) + " mapped regions");
+        if (memoryMapping->getMappedRegions().empty())
         {
             pluginInterface->logMessage(
-                Plugin::LogLevel::debug, LOG_FILENAME, "Extracted memory region has size 0, skipping");
+                Plugin::LogLevel::debug, LOG_FILENAME, "No page of the memory region is mapped, skipping");
         }
         else
         {
@@ -81,18 +82,18 @@ void Scanner::scanMemoryRegion(pid_t pid, const std::string& processName, const
             {
                 pluginInterface->logMessage(Plugin::LogLevel::debug,
                                             LOG_FILENAME,
-                                            "Start dumpVadRegionToFile with size: " + intToHex(memoryRegion->size()));
-                dumping->dumpMemoryRegion(processName, pid, memoryRegionDescriptor, *memoryRegion);
+                                            "Start dumpVadRegionToFile with size: " + intToHex(scanSize));
+                dumping->dumpMemoryRegion(processName, pid, memoryRegionDescriptor, *memoryMapping);
                 pluginInterface->logMessage(Plugin::LogLevel::debug, LOG_FILENAME, "End dumpVadRegionToFile");
             }
 
             pluginInterface->logMessage(
-                Plugin::LogLevel::debug, LOG_FILENAME, "Start scanMemory with size: " + intToHex(memoryRegion->size()));
+                Plugin::LogLevel::debug, LOG_FILENAME, "Start scanMemory with size: " + intToHex(scanSize));
 
             // The semaphore protects the yara rules from being accessed more than YR_MAX_THREADS (32 atm.) times in
             // parallel.
             semaphore.wait();
-            auto results = yaraEngine->scanMemory(*memoryRegion);
+            auto results = yaraEngine->scanMemory(*memoryMapping);
             semaphore.notify();
 
             pluginInterface->logMessage(Plugin::LogLevel::debug, LOG_FILENAME, "End scanMemory");
@@ -111,6 +112,12 @@ void Scanner::scanMemoryRegion(pid_t pid, const std::string& processName, const
 }
 
 void Scanner::scanProcess(std::shared_ptr<const ActiveProcessInformation> processInformation)
+{
+    scanProcessWithMemoryRegions(std::move(processInformation), nullptr);
+}
+
+void Scanner::scanProcessWithMemoryRegions(std::shared_ptr<const ActiveProcessInformation> processInformation,
+                                           std::unique_ptr<std::list<MemoryRegion>> memoryRegions)
 {
     if (processInformation->pid == 0)
     {
@@ -131,7 +138,10 @@ void Scanner::scanProcess(std::shared_ptr<const ActiveProcessInformation> proces
                                         *processInformation->fullName + "\"");
         try
         {
-            auto memoryRegions = processInformation->memoryRegionExtractor->extractAllMemoryRegions();
+            if (!memoryRegions)
+            {
+                memoryRegions = processInformation->memoryRegionExtractor->extractAllMemoryRegions();
+            }
 
             for (const auto& memoryRegionDescriptor : *memoryRegions)
             {
@@ -164,13 +174,29 @@ void Scanner::scanProcess(std::shared_ptr<const ActiveProcessInformation> proces
 void Scanner::scanAllProcesses()
 {
     auto processes = pluginInterface->getRunningProcesses();
+    std::vector<std::shared_ptr<const ActiveProcessInformation>> processesToScan;
     std::vector<std::future<void>> scanProcessAsyncTasks;
     for (const auto& process : *processes)
     {
-        if (process->pid != 0)
+        if (process->pid == 0)
+        {
+            continue;
+        }
+        if (configuration->isProcessIgnored(*process->fullName))
         {
             scanProcessAsyncTasks.push_back(std::async(&Scanner::scanProcess, this, process));
         }
+        else
+        {
+            processesToScan.push_back(process);
+        }
+    }
+    // Walking the memory regions of all processes together lets vmicore batch the guest reads
+    auto memoryRegions = pluginInterface->extractAllMemoryRegions(processesToScan);
+    for (size_t i = 0; i < processesToScan.size(); i++)
+    {
+        scanProcessAsyncTasks.push_back(std::async(
+            &Scanner::scanProcessWithMemoryRegions, this, processesToScan[i], std::move(memoryRegions[i])));
     }
     for (auto& currentTask : scanProcessAsyncTasks)
     {
@@ -36,6 +36,10 @@ class Scanner
     Semaphore<std::mutex, std::condition_variable> semaphore =
         Semaphore<std::mutex, std::condition_variable>(YR_MAX_THREADS);
 
+    // Scans the given memory regions, or extracts them first if there are none
+    void scanProcessWithMemoryRegions(std::shared_ptr<const ActiveProcessInformation> processInformation,
+                                      std::unique_ptr<std::list<MemoryRegion>> memoryRegions);
+
     bool shouldRegionBeScanned(const MemoryRegion& memoryRegionDescriptor);
 
     void scanMemoryRegion(pid_t pid, const std::string& processName, const MemoryRegion& memoryRegionDescriptor);
@@ -1,5 +1,15 @@
 #include "Yara.h"
 
+namespace
+{
+    struct MemoryBlockIteratorContext
+    {
+        const IMemoryMapping& memoryMapping;
+        size_t nextRegionIndex;
+        YR_MEMORY_BLOCK currentBlock;
+    };
+}
+
 Yara::Yara(const std::string& rulesFile)
 {
     int err = 0;
@@ -23,12 +33,17 @@ Yara::~Yara()
     yr_finalize();
 }
 
-std::unique_ptr<std::vector<Rule>> Yara::scanMemory(std::vector<uint8_t>& buffer)
+std::unique_ptr<std::vector<Rule>> Yara::scanMemory(const IMemoryMapping& memoryMapping)
 {
     auto results = std::make_unique<std::vector<Rule>>();
     int err = 0;
 
-    err = yr_rules_scan_mem(rules, buffer.data(), buffer.size(), 0, yaraCallback, results.get(), 0);
+    // Each mapped region is passed to yara as a separate block, so the guest memory is scanned in place
+    MemoryBlockIteratorContext iteratorContext{memoryMapping, 0, {}};
+    YR_MEMORY_BLOCK_ITERATOR iterator{
+        &iteratorContext, getFirstMemoryBlock, getNextMemoryBlock, getScannedSize, ERROR_SUCCESS};
+
+    err = yr_rules_scan_mem_blocks(rules, &iterator, 0, yaraCallback, results.get(), 0);
     if (err != ERROR_SUCCESS)
     {
         throw YaraException("Error scanning memory. Error code: " + std::to_string(err));
@@ -37,6 +52,43 @@ std::unique_ptr<std::vector<Rule>> Yara::scanMemory(std::vector<uint8_t>& buffer
     return results;
 }
 
+YR_MEMORY_BLOCK* Yara::getFirstMemoryBlock(YR_MEMORY_BLOCK_ITERATOR* iterator)
+{
+    static_cast<MemoryBlockIteratorContext*>(iterator->context)->nextRegionIndex = 0;
+    return getNextMemoryBlock(iterator);
+}
+
+YR_MEMORY_BLOCK* Yara::getNextMemoryBlock(YR_MEMORY_BLOCK_ITERATOR* iterator)
+{
+    auto* context = static_cast<MemoryBlockIteratorContext*>(iterator->context);
+    const auto& mappedRegions = context->memoryMapping.getMappedRegions();
+    if (context->nextRegionIndex >= mappedRegions.size())
+    {
+        return nullptr;
+    }
+    const auto& mappedRegion = mappedRegions[context->nextRegionIndex++];
+
+    // Offsets are relative to the start of the memory region in order to keep rules like "uint16(0) == 0x5A4D" working
+    context->currentBlock.size = mappedRegion.mapping.size();
+    context->currentBlock.base = mappedRegion.guestBaseVA - context->memoryMapping.getBaseVA();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    context->currentBlock.context = const_cast<uint8_t*>(mappedRegion.mapping.data());
+    context->currentBlock.fetch_data = fetchMemoryBlockData;
+    return &context->currentBlock;
+}
+
+uint64_t Yara::getScannedSize(YR_MEMORY_BLOCK_ITERATOR* iterator)
+{
+    // This is the size of the guest region, which is what "filesize" evaluates to in rules. Before regions were mapped,
+    // it was the size of the copied buffer, in which every run of unmapped pages was collapsed into a single zero page.
+    return static_cast<MemoryBlockIteratorContext*>(iterator->context)->memoryMapping.getSizeInGuest();
+}
+
+const uint8_t* Yara::fetchMemoryBlockData(YR_MEMORY_BLOCK* memoryBlock)
+{
+    return static_cast<const uint8_t*>(memoryBlock->context);
+}
+
 int Yara::yaraCallback(YR_SCAN_CONTEXT* context, int message, void* message_data, void* user_data)
 {
     int ret = 0;
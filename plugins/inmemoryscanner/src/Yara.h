@@ -10,11 +10,19 @@ class Yara : public YaraInterface
 
     ~Yara() override;
 
-    std::unique_ptr<std::vector<Rule>> scanMemory(std::vector<uint8_t>& buffer) override;
+    std::unique_ptr<std::vector<Rule>> scanMemory(const IMemoryMapping& memoryMapping) override;
 
   private:
     YR_RULES* rules = nullptr;
 
+    static YR_MEMORY_BLOCK* getFirstMemoryBlock(YR_MEMORY_BLOCK_ITERATOR* iterator);
+
+    static YR_MEMORY_BLOCK* getNextMemoryBlock(YR_MEMORY_BLOCK_ITERATOR* iterator);
+
+    static uint64_t getScannedSize(YR_MEMORY_BLOCK_ITERATOR* iterator);
+
+    static const uint8_t* fetchMemoryBlockData(YR_MEMORY_BLOCK* memoryBlock);
+
     static int yaraCallback(YR_SCAN_CONTEXT* context, int message, void* message_data, void* user_data);
 
     static int handleRuleMatch(YR_SCAN_CONTEXT* context, YR_RULE* rule, std::vector<Rule>* results);
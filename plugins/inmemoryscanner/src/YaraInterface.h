@@ -2,6 +2,7 @@
 
 #include "Common.h"
 #include <memory>
+#include <vmicore/vmi/IMemoryMapping.h>
 
 class YaraException : public std::runtime_error
 {
@@ -14,7 +15,7 @@ class YaraInterface
   public:
     virtual ~YaraInterface() = default;
 
-    virtual std::unique_ptr<std::vector<Rule>> scanMemory(std::vector<uint8_t>& buffer) = 0;
+    virtual std::unique_ptr<std::vector<Rule>> scanMemory(const IMemoryMapping& memoryMapping) = 0;
 
   protected:
     YaraInterface() = default;
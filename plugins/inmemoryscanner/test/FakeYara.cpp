@@ -2,7 +2,7 @@
 #include <thread>
 #include <yara/limits.h> // NOLINT(modernize-deprecated-headers)
 
-std::unique_ptr<std::vector<Rule>> FakeYara::scanMemory([[maybe_unused]] std::vector<uint8_t>& buffer)
+std::unique_ptr<std::vector<Rule>> FakeYara::scanMemory([[maybe_unused]] const IMemoryMapping& memoryMapping)
 {
     concurrentThreads++;
     if (concurrentThreads > YR_MAX_THREADS)
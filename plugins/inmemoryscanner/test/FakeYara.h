@@ -5,7 +5,7 @@
 class FakeYara : public YaraInterface
 {
   public:
-    std::unique_ptr<std::vector<Rule>> scanMemory(std::vector<uint8_t>& buffer) override;
+    std::unique_ptr<std::vector<Rule>> scanMemory(const IMemoryMapping& memoryMapping) override;
 
     bool max_threads_exceeded = false;
 
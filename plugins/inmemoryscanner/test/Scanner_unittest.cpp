@@ -8,14 +8,15 @@
 #include <vmicore/test/os/mock_MemoryRegionExtractor.h>
 #include <vmicore/test/os/mock_PageProtection.h>
 #include <vmicore/test/plugins/mock_PluginInterface.h>
+#include <vmicore/test/vmi/mock_MemoryMapping.h>
 
 using testing::_;
 using testing::An;
 using testing::AnyNumber;
-using testing::ByMove;
 using testing::ContainsRegex;
 using testing::NiceMock;
 using testing::Return;
+using testing::ReturnRef;
 using testing::Unused;
 
 class ScannerTestBaseFixture : public testing::Test
@@ -42,6 +43,9 @@ class ScannerTestBaseFixture : public testing::Test
     std::filesystem::path dumpedRegionsPath = inMemoryDumpsPath / dumpedRegionsDir;
     Plugin::virtual_address_t startAddress = 0x1234000;
     size_t size = 0x666;
+    std::vector<uint8_t> testPageContent = std::vector<uint8_t>(6, 9);
+    std::vector<MappedRegion> mappedRegions{{startAddress, testPageContent}};
+    std::vector<MappedRegion> noMappedRegions{};
 
     std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>> runningProcesses;
 
@@ -50,8 +54,8 @@ class ScannerTestBaseFixture : public testing::Test
         ON_CALL(*pluginInterface, getResultsDir()).WillByDefault([]() { return std::make_unique<std::string>(); });
         ON_CALL(*configuration, getMaximumScanSize()).WillByDefault(Return(maxScanSize));
         // make sure that we return a non-empty memory region or else we might skip important parts
-        ON_CALL(*pluginInterface, readProcessMemoryRegion(_, _, _))
-            .WillByDefault([]() { return std::make_unique<std::vector<uint8_t>>(6, 9); });
+        ON_CALL(*pluginInterface, mapProcessMemoryRegion(_, _, _))
+            .WillByDefault([this]() { return createMemoryMapping(mappedRegions, size); });
 
         ON_CALL(*pluginInterface, getResultsDir())
             .WillByDefault([vmiResultsOutputDir = vmiResultsOutputDir]()
@@ -59,6 +63,17 @@ class ScannerTestBaseFixture : public testing::Test
         ON_CALL(*configuration, getOutputPath())
             .WillByDefault([inMemOutputDir = inMemOutputDir]() { return inMemOutputDir + "/"; });
         ON_CALL(*configuration, getMaximumScanSize()).WillByDefault(Return(maxScanSize));
+        ON_CALL(*pluginInterface, extractAllMemoryRegions(_))
+            .WillByDefault(
+                [](const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes)
+                {
+                    std::vector<std::unique_ptr<std::list<MemoryRegion>>> memoryRegions;
+                    for (const auto& process : processes)
+                    {
+                        memoryRegions.push_back(process->memoryRegionExtractor->extractAllMemoryRegions());
+                    }
+                    return memoryRegions;
+                });
 
         runningProcesses = std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>();
         auto m1 = std::make_unique<MockMemoryRegionExtractor>();
@@ -85,6 +100,15 @@ class ScannerTestBaseFixture : public testing::Test
                                      std::move(m2)}));
     };
 
+    std::unique_ptr<IMemoryMapping> createMemoryMapping(const std::vector<MappedRegion>& regions, size_t sizeInGuest)
+    {
+        auto memoryMapping = std::make_unique<NiceMock<MockMemoryMapping>>();
+        ON_CALL(*memoryMapping, getBaseVA()).WillByDefault(Return(startAddress));
+        ON_CALL(*memoryMapping, getSizeInGuest()).WillByDefault(Return(sizeInGuest));
+        ON_CALL(*memoryMapping, getMappedRegions()).WillByDefault(ReturnRef(regions));
+        return memoryMapping;
+    }
+
     std::shared_ptr<const ActiveProcessInformation> getProcessInfoFromRunningProcesses(pid_t pid)
     {
         return *std::find_if(runningProcesses->cbegin(),
@@ -167,8 +191,8 @@ TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_largeMemoryRegion_trimToMa
                 return memoryRegions;
             });
 
-    EXPECT_CALL(*pluginInterface, readProcessMemoryRegion(testPid, startAddress, maxScanSize))
-        .WillOnce(Return(ByMove(std::make_unique<std::vector<uint8_t>>())));
+    EXPECT_CALL(*pluginInterface, mapProcessMemoryRegion(testPid, startAddress, maxScanSize))
+        .WillOnce([this]() { return createMemoryMapping(noMappedRegions, 0); });
     EXPECT_NO_THROW(scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid)));
 }
 
@@ -184,8 +208,8 @@ TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_smallMemoryRegion_original
                 return memoryRegions;
             });
 
-    EXPECT_CALL(*pluginInterface, readProcessMemoryRegion(testPid, startAddress, size))
-        .WillOnce(Return(ByMove(std::make_unique<std::vector<uint8_t>>())));
+    EXPECT_CALL(*pluginInterface, mapProcessMemoryRegion(testPid, startAddress, size))
+        .WillOnce([this]() { return createMemoryMapping(noMappedRegions, 0); });
     EXPECT_NO_THROW(scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid)));
 }
 
@@ -200,8 +224,8 @@ TEST_F(ScannerTestFixtureDumpingDisabled, scanProcess_disabledDumping_dumpingNot
                     startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
                 return memoryRegions;
             });
-    EXPECT_CALL(*pluginInterface, readProcessMemoryRegion(testPid, startAddress, size))
-        .WillOnce(Return(ByMove(std::make_unique<std::vector<uint8_t>>())));
+    EXPECT_CALL(*pluginInterface, mapProcessMemoryRegion(testPid, startAddress, size))
+        .WillOnce([this]() { return createMemoryMapping(noMappedRegions, 0); });
     EXPECT_CALL(*dumpingRawPointer, dumpMemoryRegion(_, _, _, _)).Times(0);
 
     EXPECT_NO_THROW(scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid)));
@@ -254,6 +278,22 @@ TEST_F(ScannerTestFixtureDumpingEnabled, scanProcess_shortProcessName_memoryDump
     EXPECT_NO_THROW(scanner->scanProcess(processWithShortName));
 }
 
+TEST_F(ScannerTestFixtureDumpingEnabled, scanProcess_memoryRegionWithUnmappedPage_dumpPaddedWithSingleZeroPage)
+{
+    const size_t pageSize = 0x1000;
+    std::vector<uint8_t> firstPage(pageSize, 0x1);
+    std::vector<uint8_t> thirdPage(pageSize, 0x3);
+    std::vector<MappedRegion> regionsWithGap{{startAddress, firstPage}, {startAddress + 2 * pageSize, thirdPage}};
+    ON_CALL(*pluginInterface, mapProcessMemoryRegion(_, _, _))
+        .WillByDefault([this, &regionsWithGap]() { return createMemoryMapping(regionsWithGap, 3 * pageSize); });
+    std::vector<uint8_t> expectedDump(firstPage);
+    expectedDump.insert(expectedDump.end(), pageSize, 0x0);
+    expectedDump.insert(expectedDump.end(), thirdPage.cbegin(), thirdPage.cend());
+
+    EXPECT_CALL(*pluginInterface, writeToFile(_, expectedDump)).Times(1);
+    EXPECT_NO_THROW(scanner->scanProcess(getProcessInfoFromRunningProcesses(testPid)));
+}
+
 TEST_F(ScannerTestFixtureDumpingDisabled, scanAllProcesses_MoreScanningThreadThanAllowedByYara_ThreadLimitNotExceeded)
 {
     auto yaraFake = std::make_unique<FakeYara>();
@@ -342,3 +382,37 @@ TEST_F(ScannerTestFixtureDumpingEnabled, scanAllProcesses_ProcessWithLongNameSca
     ASSERT_NO_THROW(scanner->scanAllProcesses());
     ASSERT_NO_THROW(scanner->saveOutput());
 }
+
+TEST_F(ScannerTestFixtureDumpingDisabled, scanAllProcesses_batchedMemoryRegions_processExtractorNotCalled)
+{
+    auto memoryRegionExtractor = std::make_unique<MockMemoryRegionExtractor>();
+    auto* memoryRegionExtractorRaw = memoryRegionExtractor.get();
+    auto processInfo =
+        std::make_shared<ActiveProcessInformation>(ActiveProcessInformation{0,
+                                                                            0,
+                                                                            testPid,
+                                                                            0,
+                                                                            "System.exe",
+                                                                            std::make_unique<std::string>("System.exe"),
+                                                                            std::make_unique<std::string>(""),
+                                                                            std::move(memoryRegionExtractor)});
+    ON_CALL(*pluginInterface, getRunningProcesses())
+        .WillByDefault(
+            [&processInfo]()
+            { return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(1, processInfo); });
+    EXPECT_CALL(*pluginInterface, extractAllMemoryRegions(_))
+        .WillOnce(
+            [startAddress = startAddress, size = size](Unused)
+            {
+                std::vector<std::unique_ptr<std::list<MemoryRegion>>> memoryRegions;
+                memoryRegions.push_back(std::make_unique<std::list<MemoryRegion>>());
+                memoryRegions.front()->emplace_back(
+                    startAddress, size, "", std::make_unique<MockPageProtection>(), false, false, false);
+                return memoryRegions;
+            });
+    EXPECT_CALL(*memoryRegionExtractorRaw, extractAllMemoryRegions()).Times(0);
+    EXPECT_CALL(*pluginInterface, mapProcessMemoryRegion(testPid, startAddress, size))
+        .WillOnce([this]() { return createMemoryMapping(noMappedRegions, 0); });
+
+    ASSERT_NO_THROW(scanner->scanAllProcesses());
+}
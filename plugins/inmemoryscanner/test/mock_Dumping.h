@@ -11,7 +11,7 @@ class MockDumping : public IDumping
                 (const std::string& processName,
                  pid_t pid,
                  const MemoryRegion& memoryRegionDescriptor,
-                 const std::vector<uint8_t>& data),
+                 const IMemoryMapping& memoryMapping),
                 (override));
 
     MOCK_METHOD(std::vector<std::string>, getAllMemoryRegionInformation, (), (override));
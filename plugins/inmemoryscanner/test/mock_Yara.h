@@ -6,5 +6,5 @@
 class MockYara : public YaraInterface
 {
   public:
-    MOCK_METHOD(std::unique_ptr<std::vector<Rule>>, scanMemory, (std::vector<uint8_t> & buffer), (override));
+    MOCK_METHOD(std::unique_ptr<std::vector<Rule>>, scanMemory, (const IMemoryMapping& memoryMapping), (override));
 };
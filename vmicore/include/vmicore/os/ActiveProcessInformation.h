@@ -2,6 +2,7 @@
 #define VMICORE_ACTIVEPROCESSINFORMATION_H
 
 #include "IMemoryRegionExtractor.h"
+#include "LazyValue.h"
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -14,9 +15,14 @@ struct ActiveProcessInformation
     pid_t pid;
     pid_t parentPid;
     std::string name;
-    std::unique_ptr<std::string> fullName;
-    std::unique_ptr<std::string> processPath;
-    std::unique_ptr<IMemoryRegionExtractor> memoryRegionExtractor;
+    // May only be resolved on first access, at the latest when the process is removed
+    LazyValue<std::string> fullName;
+    LazyValue<std::string> processPath;
+    LazyValue<IMemoryRegionExtractor> memoryRegionExtractor;
+    // Set while the start of a process registered from its vCPU has not been processed yet. Until then, processPath is
+    // empty and fullName holds the image name, which the guest may have truncated. Looking up the process again
+    // afterwards returns the complete information.
+    bool enrichmentPending = false;
 };
 
 #endif // VMICORE_ACTIVEPROCESSINFORMATION_H
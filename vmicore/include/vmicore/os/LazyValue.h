@@ -0,0 +1,92 @@
+#ifndef VMICORE_LAZYVALUE_H
+#define VMICORE_LAZYVALUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+// Owning pointer whose value is created by a factory on first access and kept afterwards. Concurrent first accesses
+// are safe and run the factory only once. If the factory throws, the next access tries again. A LazyValue that has
+// neither a value nor a factory behaves like a null pointer.
+// The factory may run long after creation and after the LazyValue has been moved, so it must only capture copies or
+// owning pointers. Values read from guest structures that may be freed in the meantime, like those of a process that
+// can exit, have to be resolved by the owner of the LazyValue before the structure goes away.
+template <typename T> class LazyValue
+{
+  public:
+    using Factory = std::function<std::unique_ptr<T>()>;
+
+    LazyValue() = default;
+
+    LazyValue(std::nullptr_t) {}
+
+    explicit LazyValue(Factory factory) : factory(std::move(factory)) {}
+
+    template <typename U>
+    LazyValue(std::unique_ptr<U> value) : value(std::move(value)), resolvedValue(this->value.get())
+    {
+    }
+
+    // Not thread safe. Only meant for moving a LazyValue into place before it is shared.
+    LazyValue(LazyValue&& other) noexcept
+        : value(std::move(other.value)), factory(std::move(other.factory)), resolvedValue(value.get())
+    {
+    }
+
+    LazyValue& operator=(LazyValue&& other) noexcept
+    {
+        value = std::move(other.value);
+        factory = std::move(other.factory);
+        resolvedValue = value.get();
+        return *this;
+    }
+
+    LazyValue(const LazyValue&) = delete;
+
+    LazyValue& operator=(const LazyValue&) = delete;
+
+    ~LazyValue() = default;
+
+    [[nodiscard]] T* get() const
+    {
+        if (auto* resolved = resolvedValue.load(std::memory_order_acquire))
+        {
+            return resolved;
+        }
+        // An exception thrown by the factory releases the lock and leaves the value unresolved
+        std::scoped_lock lock(*valueLock);
+        if (!value && factory)
+        {
+            value = factory();
+            resolvedValue.store(value.get(), std::memory_order_release);
+        }
+        return value.get();
+    }
+
+    T& operator*() const
+    {
+        return *get();
+    }
+
+    T* operator->() const
+    {
+        return get();
+    }
+
+    explicit operator bool() const
+    {
+        return get() != nullptr;
+    }
+
+  private:
+    mutable std::unique_ptr<T> value;
+    Factory factory;
+    // Only set once the value exists, so that accesses after the first one do not have to lock
+    mutable std::atomic<T*> resolvedValue = nullptr;
+    std::unique_ptr<std::mutex> valueLock = std::make_unique<std::mutex>();
+};
+
+#endif // VMICORE_LAZYVALUE_H
@@ -2,13 +2,15 @@
 #define VMICORE_PLUGININTERFACE_H
 
 #include "../os/ActiveProcessInformation.h"
+#include "../vmi/IMemoryMapping.h"
 #include "IPluginConfig.h"
+#include <list>
 #include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
-constexpr uint8_t VMI_PLUGIN_API_VERSION = 12;
+constexpr uint8_t VMI_PLUGIN_API_VERSION = 20;
 
 namespace Plugin
 {
@@ -41,11 +43,26 @@ namespace Plugin
         [[nodiscard]] virtual std::unique_ptr<std::vector<uint8_t>>
         readProcessMemoryRegion(pid_t pid, virtual_address_t address, size_t numberOfBytes) const = 0;
 
+        // Zero-copy alternative to readProcessMemoryRegion. The returned mapping has to be released by the plugin.
+        [[nodiscard]] virtual std::unique_ptr<IMemoryMapping>
+        mapProcessMemoryRegion(pid_t pid, virtual_address_t address, size_t numberOfBytes) const = 0;
+
         [[nodiscard]] virtual std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
         getRunningProcesses() const = 0;
 
+        // Same result as calling extractAllMemoryRegions on the memory region extractor of every process, but the guest
+        // structures of all processes are read together with batched reads. The result has one entry per process in the
+        // same order, which is null if the memory regions of that process could not be extracted.
+        [[nodiscard]] virtual std::vector<std::unique_ptr<std::list<MemoryRegion>>> extractAllMemoryRegions(
+            const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes) const = 0;
+
         virtual void registerProcessTerminationEvent(processTerminationCallback_f terminationCallback) = 0;
 
+        // Called after the terminating process has been resumed, so the callback must not read its memory anymore. With
+        // per vCPU event processing, callbacks for processes terminating on different vCPUs run in parallel and do not
+        // hold up other events.
+        virtual void registerDeferredProcessTerminationEvent(processTerminationCallback_f terminationCallback) = 0;
+
         virtual void registerShutdownEvent(shutdownCallback_f shutdownCallback) = 0;
 
         [[nodiscard]] virtual std::unique_ptr<std::string> getResultsDir() const = 0;
@@ -60,6 +77,9 @@ namespace Plugin
 
         virtual void sendInMemDetectionEvent(const std::string& message) const = 0;
 
+        // Ends the introspection. Safe to call from any plugin thread.
+        virtual void requestShutdown() const = 0;
+
       protected:
         PluginInterface() = default;
     };
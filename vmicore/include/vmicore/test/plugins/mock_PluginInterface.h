@@ -13,14 +13,26 @@ namespace Plugin
                     readProcessMemoryRegion,
                     (pid_t pid, virtual_address_t address, size_t numberOfBytes),
                     (const, override));
+        MOCK_METHOD(std::unique_ptr<IMemoryMapping>,
+                    mapProcessMemoryRegion,
+                    (pid_t pid, virtual_address_t address, size_t numberOfBytes),
+                    (const, override));
         MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
                     getRunningProcesses,
                     (),
                     (const, override));
+        MOCK_METHOD(std::vector<std::unique_ptr<std::list<MemoryRegion>>>,
+                    extractAllMemoryRegions,
+                    (const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes),
+                    (const, override));
         MOCK_METHOD(void,
                     registerProcessTerminationEvent,
                     (processTerminationCallback_f terminationCallback),
                     (override));
+        MOCK_METHOD(void,
+                    registerDeferredProcessTerminationEvent,
+                    (processTerminationCallback_f terminationCallback),
+                    (override));
         MOCK_METHOD(void, registerShutdownEvent, (shutdownCallback_f shutdownCallback), (override));
         MOCK_METHOD(std::unique_ptr<std::string>, getResultsDir, (), (const, override));
         MOCK_METHOD(void, writeToFile, (const std::string& filename, const std::string& message), (const, override));
@@ -34,5 +46,7 @@ namespace Plugin
                     (const, override));
         MOCK_METHOD(void, sendErrorEvent, (const std::string& message), (const, override));
         MOCK_METHOD(void, sendInMemDetectionEvent, (const std::string& message), (const, override));
+
+        MOCK_METHOD(void, requestShutdown, (), (const, override));
     };
 }
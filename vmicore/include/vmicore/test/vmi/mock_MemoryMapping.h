@@ -0,0 +1,17 @@
+#ifndef VMICORE_MOCK_MEMORYMAPPING_H
+#define VMICORE_MOCK_MEMORYMAPPING_H
+
+#include <gmock/gmock.h>
+#include <vmicore/vmi/IMemoryMapping.h>
+
+class MockMemoryMapping : public IMemoryMapping
+{
+  public:
+    MOCK_METHOD(uint64_t, getBaseVA, (), (const override));
+
+    MOCK_METHOD(size_t, getSizeInGuest, (), (const override));
+
+    MOCK_METHOD(const std::vector<MappedRegion>&, getMappedRegions, (), (const override));
+};
+
+#endif // VMICORE_MOCK_MEMORYMAPPING_H
@@ -0,0 +1,34 @@
+#ifndef VMICORE_IMEMORYMAPPING_H
+#define VMICORE_IMEMORYMAPPING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct MappedRegion
+{
+    uint64_t guestBaseVA;
+    std::span<const uint8_t> mapping;
+};
+
+// Read-only view of a guest memory region that is mapped into the address space of the host. The mapping is released
+// together with this object, so spans handed out by it must not outlive it.
+class IMemoryMapping
+{
+  public:
+    virtual ~IMemoryMapping() = default;
+
+    [[nodiscard]] virtual uint64_t getBaseVA() const = 0;
+
+    // Size of the whole region in the guest, including pages that are not mapped
+    [[nodiscard]] virtual size_t getSizeInGuest() const = 0;
+
+    // Runs of consecutive mapped guest pages in ascending order. Pages that are not mapped in the guest are omitted.
+    [[nodiscard]] virtual const std::vector<MappedRegion>& getMappedRegions() const = 0;
+
+  protected:
+    IMemoryMapping() = default;
+};
+
+#endif // VMICORE_IMEMORYMAPPING_H
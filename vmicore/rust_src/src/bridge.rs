@@ -22,6 +22,17 @@ pub mod ffi {
         Terminated,
     }
 
+    #[namespace = "grpc"]
+    struct EventLatency {
+        source: String,
+        count: u64,
+        total_ns: u64,
+        p50_ns: u64,
+        p90_ns: u64,
+        p99_ns: u64,
+        max_ns: u64,
+    }
+
     #[namespace = "logging"]
     extern "Rust" {
         fn convert_to_log_level(level: &CxxString) -> Result<Level>;
@@ -80,5 +91,11 @@ pub mod ffi {
         fn send_termination_event(self: &GRPCServer) -> Result<()>;
         fn send_error_event(self: &GRPCServer, message: &CxxString) -> Result<()>;
         fn send_in_mem_detection_event(self: &GRPCServer, message: &CxxString) -> Result<()>;
+        fn update_metrics(
+            self: &GRPCServer,
+            event_latencies: Vec<EventLatency>,
+            total_vm_pause_ns: u64,
+            vm_pause_count: u64,
+        );
     }
 }
@@ -1,4 +1,4 @@
-use crate::bridge::ffi::{Level, ProcessState};
+use crate::bridge::ffi::{EventLatency, Level, ProcessState};
 use crate::grpc_log_service::GRPCLogService;
 use crate::grpc_logger::GrpcLogger;
 use crate::grpc_vmi_service::GRPCVmiService;
@@ -7,7 +7,7 @@ use crate::hive_operations::logging::service::log_service_server::LogServiceServ
 use crate::hive_operations::logging::{LogField, LogMessage};
 use crate::hive_operations::vmi::{
     listen_for_events_response::Message, vmi_service_server::VmiServiceServer, BsodDetected, DumpMsgToFileResponse,
-    Event, ListenForEventsResponse, VmProcessEnd, VmProcessStart, VmiFinished, VmiReady,
+    Event, GetMetricsResponse, ListenForEventsResponse, VmProcessEnd, VmProcessStart, VmiFinished, VmiReady,
 };
 
 use async_std::channel::{unbounded, Receiver, Sender};
@@ -17,6 +17,7 @@ use futures::TryFutureExt;
 use std::error::Error;
 use std::pin::Pin;
 use std::result;
+use std::sync::{Arc, Mutex, PoisonError};
 use std::time::SystemTime;
 use tokio::net::UnixListener;
 use tonic::transport::Server;
@@ -38,6 +39,7 @@ pub struct GRPCServer {
     log_channel: AsyncQueue<LogMessage>,
     file_channel: AsyncQueue<DumpMsgToFileResponse>,
     event_channel: AsyncQueue<ListenForEventsResponse>,
+    metrics: Arc<Mutex<GetMetricsResponse>>,
 }
 
 pub fn new_server(listen_addr: &CxxString, enable_debug: bool) -> Box<GRPCServer> {
@@ -61,6 +63,7 @@ pub fn new_server(listen_addr: &CxxString, enable_debug: bool) -> Box<GRPCServer
         log_channel,
         file_channel,
         event_channel,
+        metrics: Arc::new(Mutex::new(GetMetricsResponse::default())),
     })
 }
 
@@ -68,7 +71,11 @@ impl GRPCServer {
     #[tokio::main]
     pub async fn start_server(&self) -> Result<(), Box<dyn Error>> {
         let log_service = GRPCLogService::new(self.log_channel.receiver.clone());
-        let vmi_service = GRPCVmiService::new(self.file_channel.receiver.clone(), self.event_channel.receiver.clone());
+        let vmi_service = GRPCVmiService::new(
+            self.file_channel.receiver.clone(),
+            self.event_channel.receiver.clone(),
+            self.metrics.clone(),
+        );
 
         let incoming = {
             let addr_ref = self.listen_addr.as_str();
@@ -227,6 +234,33 @@ impl GRPCServer {
         Ok(())
     }
 
+    pub fn update_metrics(
+        self: &GRPCServer,
+        event_latencies: Vec<EventLatency>,
+        total_vm_pause_ns: u64,
+        vm_pause_count: u64,
+    ) {
+        // Panicking here would unwind into the C++ caller. Every update replaces the whole snapshot, so a lock poisoned
+        // by a panicking holder does not leave inconsistent metrics behind.
+        *self.metrics.lock().unwrap_or_else(PoisonError::into_inner) = GetMetricsResponse {
+            timestamp: Some(SystemTime::now().into()),
+            event_latencies: event_latencies
+                .into_iter()
+                .map(|latency| crate::hive_operations::vmi::EventLatency {
+                    source: latency.source,
+                    count: latency.count,
+                    total_ns: latency.total_ns,
+                    p50_ns: latency.p50_ns,
+                    p90_ns: latency.p90_ns,
+                    p99_ns: latency.p99_ns,
+                    max_ns: latency.max_ns,
+                })
+                .collect(),
+            total_vm_pause_ns,
+            vm_pause_count,
+        };
+    }
+
     pub async fn wait_for_termination<T>(stream: &mut Streaming<T>) {
         if let Ok(msg) = stream.message().await {
             match msg {
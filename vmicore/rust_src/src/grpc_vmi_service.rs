@@ -1,26 +1,32 @@
 use crate::grpc_server::{GRPCServer, Stream};
 use crate::hive_operations::vmi::vmi_service_server::VmiService;
 use crate::hive_operations::vmi::{
-    DumpMsgToFileRequest, DumpMsgToFileResponse, ListenForEventsRequest, ListenForEventsResponse,
+    DumpMsgToFileRequest, DumpMsgToFileResponse, GetMetricsRequest, GetMetricsResponse, ListenForEventsRequest,
+    ListenForEventsResponse,
 };
 use async_std::channel::Receiver;
 use async_stream::try_stream;
+use std::sync::{Arc, Mutex, PoisonError};
 use tonic::{Request, Response, Status, Streaming};
 
 #[derive(Debug)]
 pub struct GRPCVmiService {
     file_receiver: Receiver<DumpMsgToFileResponse>,
     event_receiver: Receiver<ListenForEventsResponse>,
+    // Latest snapshot published by the core
+    metrics: Arc<Mutex<GetMetricsResponse>>,
 }
 
 impl GRPCVmiService {
     pub fn new(
         file_receiver: Receiver<DumpMsgToFileResponse>,
         event_receiver: Receiver<ListenForEventsResponse>,
+        metrics: Arc<Mutex<GetMetricsResponse>>,
     ) -> GRPCVmiService {
         GRPCVmiService {
             file_receiver,
             event_receiver,
+            metrics,
         }
     }
 }
@@ -75,4 +81,10 @@ impl VmiService for GRPCVmiService {
 
         Ok(Response::new(Box::pin(stream) as Self::ListenForEventsStream))
     }
+
+    async fn get_metrics(&self, _request: Request<GetMetricsRequest>) -> Result<Response<GetMetricsResponse>, Status> {
+        // The snapshot is always replaced as a whole, so it stays consistent even if the lock has been poisoned
+        let metrics = self.metrics.lock().unwrap_or_else(PoisonError::into_inner).clone();
+        Ok(Response::new(metrics))
+    }
 }
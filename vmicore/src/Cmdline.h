@@ -30,6 +30,14 @@ class Cmdline
         "n", "name", "Name of the domain to introspect.", false, "", "domain_name", cmd};
     TCLAP::ValueArg<std::filesystem::path> kvmiSocketArgument{
         "s", "socket", "KVMi socket path {required for introspecting on kvm}.", false, "", "/path/to/socket", cmd};
+    TCLAP::ValueArg<std::filesystem::path> dumpFileArgument{
+        "d",
+        "dump",
+        "Raw physical memory dump to analyze instead of a running VM. Plugins scan it once and vmicore exits.",
+        false,
+        "",
+        "/path/to/dump",
+        cmd};
     TCLAP::ValueArg<std::string> resultsDirectoryArgument{
         "r", "results", "Path to top level directory for results.", false, "./results", "results_directory", cmd};
     TCLAP::ValueArg<std::string> gRPCListenAddressArgument{
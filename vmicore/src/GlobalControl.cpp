@@ -1,9 +1,92 @@
 #include "GlobalControl.h"
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <system_error>
+#include <thread>
+#include <unistd.h>
 
 namespace
 {
     std::unique_ptr<ILogger> staticLogger;
     std::shared_ptr<IEventStream> staticEventStream;
+
+    int eventLoopWakeupFdError = 0;
+
+    int createEventLoopWakeupFd()
+    {
+        auto fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (fd == -1)
+        {
+            eventLoopWakeupFdError = errno;
+        }
+        return fd;
+    }
+
+    // Readable while a wakeup is pending
+    const int eventLoopWakeupFd = createEventLoopWakeupFd();
+    // A signal that arrives before libvmi has started its poll is lost, so it is repeated once if the listen call is
+    // still running afterwards
+    constexpr auto wakeupSignalRetryInterval = std::chrono::milliseconds(20);
+    std::thread wakeupWatcher;
+    pthread_t eventLoopThread{};
+
+    std::mutex eventLoopStateLock;
+    std::condition_variable eventLoopStateChanged;
+    bool stopWakeupWatcher = false;
+    // Number of the blocking listen call the event loop thread is currently in, 0 outside of it
+    uint64_t activeListenCall = 0;
+    uint64_t numberOfListenCalls = 0;
+
+    void watchEventLoopWakeups()
+    {
+        pollfd wakeupPollFd{.fd = eventLoopWakeupFd, .events = POLLIN, .revents = 0};
+        uint64_t lastInterruptedListenCall = 0;
+        std::unique_lock lock(eventLoopStateLock);
+        while (!stopWakeupWatcher)
+        {
+            eventLoopStateChanged.wait(lock,
+                                       [&lastInterruptedListenCall]()
+                                       {
+                                           return stopWakeupWatcher || (activeListenCall != 0 &&
+                                                                        activeListenCall != lastInterruptedListenCall);
+                                       });
+            if (stopWakeupWatcher)
+            {
+                break;
+            }
+            auto listenCall = activeListenCall;
+            lock.unlock();
+            auto isWakeupPending = poll(&wakeupPollFd, 1, -1) > 0;
+            lock.lock();
+            // The wakeup has to be delivered to the listen call that is running now, otherwise it is consumed by the
+            // event loop before the next one
+            if (!isWakeupPending || stopWakeupWatcher || activeListenCall != listenCall)
+            {
+                continue;
+            }
+            pthread_kill(eventLoopThread, GlobalControl::eventLoopWakeupSignal);
+            lastInterruptedListenCall = listenCall;
+            if (!eventLoopStateChanged.wait_for(lock,
+                                                wakeupSignalRetryInterval,
+                                                [listenCall]()
+                                                { return stopWakeupWatcher || activeListenCall != listenCall; }))
+            {
+                pthread_kill(eventLoopThread, GlobalControl::eventLoopWakeupSignal);
+            }
+        }
+    }
+
+    void signalWakeupFd()
+    {
+        uint64_t increment = 1;
+        [[maybe_unused]] auto bytesWritten = write(eventLoopWakeupFd, &increment, sizeof(increment));
+    }
 }
 
 namespace GlobalControl
@@ -39,4 +122,64 @@ namespace GlobalControl
     {
         staticLogger.reset();
     }
+
+    void registerEventLoopThread()
+    {
+        if (eventLoopWakeupFd == -1)
+        {
+            throw std::system_error(
+                eventLoopWakeupFdError, std::generic_category(), "Unable to create the event loop wakeup fd");
+        }
+        eventLoopThread = pthread_self();
+        {
+            std::scoped_lock lock(eventLoopStateLock);
+            stopWakeupWatcher = false;
+            activeListenCall = 0;
+        }
+        wakeupWatcher = std::thread(watchEventLoopWakeups);
+    }
+
+    void unregisterEventLoopThread()
+    {
+        {
+            std::scoped_lock lock(eventLoopStateLock);
+            stopWakeupWatcher = true;
+        }
+        eventLoopStateChanged.notify_all();
+        // Unblocks the watcher if it is polling the wakeup fd
+        signalWakeupFd();
+        wakeupWatcher.join();
+        (void)consumeEventLoopWakeup();
+    }
+
+    void enterEventLoopListen()
+    {
+        {
+            std::scoped_lock lock(eventLoopStateLock);
+            activeListenCall = ++numberOfListenCalls;
+        }
+        eventLoopStateChanged.notify_all();
+    }
+
+    void leaveEventLoopListen()
+    {
+        {
+            std::scoped_lock lock(eventLoopStateLock);
+            activeListenCall = 0;
+        }
+        eventLoopStateChanged.notify_all();
+    }
+
+    void wakeUpEventLoop()
+    {
+        // Signals sent to the process may be handled by any thread, so the event loop thread is only interrupted by
+        // the wakeup watcher
+        signalWakeupFd();
+    }
+
+    bool consumeEventLoopWakeup()
+    {
+        uint64_t numberOfWakeups = 0;
+        return read(eventLoopWakeupFd, &numberOfWakeups, sizeof(numberOfWakeups)) == sizeof(numberOfWakeups);
+    }
 }
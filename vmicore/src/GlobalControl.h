@@ -3,6 +3,7 @@
 
 #include "io/IEventStream.h"
 #include "io/ILogger.h"
+#include <csignal>
 #include <memory>
 
 namespace GlobalControl
@@ -10,11 +11,32 @@ namespace GlobalControl
     extern volatile bool endVmi;
     extern volatile bool postRunPluginAction;
 
+    // Interrupts the event loop thread while it is blocked in libvmi, which owns the poll on the event channel
+    constexpr int eventLoopWakeupSignal = SIGUSR1;
+
     const std::unique_ptr<ILogger>& logger();
     const std::shared_ptr<IEventStream>& eventStream();
 
     void init(std::unique_ptr<ILogger> logger, std::shared_ptr<IEventStream> eventStream);
     void uninit();
+
+    // Has to be called from the event loop thread after a handler for eventLoopWakeupSignal has been installed.
+    // Starts a thread that polls the wakeup fd and interrupts the event loop thread while it is listening for events.
+    void registerEventLoopThread();
+
+    void unregisterEventLoopThread();
+
+    // Have to be called from the event loop thread around every blocking listen for events. Pending wakeups only
+    // interrupt the event loop thread in between, so that callbacks and plugins running outside of it are left alone.
+    void enterEventLoopListen();
+
+    void leaveEventLoopListen();
+
+    // Async-signal-safe. Makes the event loop skip its next sleep and interrupts the current one.
+    void wakeUpEventLoop();
+
+    // Returns whether a wakeup has been requested since the last call
+    bool consumeEventLoopWakeup();
 }
 
 #endif // VMICORE_GLOBALCONTROL_H
@@ -1,8 +1,10 @@
 #include "VmiHub.h"
 #include "GlobalControl.h"
 #include "os/linux/ActiveProcessesSupervisor.h"
+#include "os/linux/Constants.h"
 #include "os/linux/SystemEventSupervisor.h"
 #include "os/windows/ActiveProcessesSupervisor.h"
+#include "os/windows/Constants.h"
 #include "os/windows/SystemEventSupervisor.h"
 
 #include <csignal>
@@ -12,6 +14,7 @@
 namespace
 {
     int exitCode = 0;
+    constexpr auto metricsUpdateInterval = std::chrono::seconds(1);
     const std::string loggerName = std::filesystem::path(__FILE__).filename().stem();
 }
 
@@ -19,13 +22,15 @@ VmiHub::VmiHub(std::shared_ptr<IConfigParser> configInterface,
                std::shared_ptr<ILibvmiInterface> vmiInterface,
                std::shared_ptr<ILogging> loggingLib,
                std::shared_ptr<IEventStream> eventStream,
-               std::shared_ptr<IInterruptFactory> interruptFactory)
+               std::shared_ptr<IInterruptFactory> interruptFactory,
+               std::shared_ptr<EventMetrics> eventMetrics)
     : configInterface(std::move(configInterface)),
       vmiInterface(std::move(vmiInterface)),
       loggingLib(std::move(loggingLib)),
       logger(NEW_LOGGER(this->loggingLib)),
       eventStream(std::move(eventStream)),
-      interruptFactory(std::move(interruptFactory))
+      interruptFactory(std::move(interruptFactory)),
+      eventMetrics(std::move(eventMetrics))
 {
 }
 
@@ -33,21 +38,29 @@ void VmiHub::waitForEvents() const
 {
     // TODO: only set postRunPluginAction to true after sample process is started
     GlobalControl::postRunPluginAction = true;
+    GlobalControl::registerEventLoopThread();
+    auto lastMetricsUpdate = std::chrono::steady_clock::now();
 #ifdef TRACE_MODE
     auto loopStart = std::chrono::steady_clock::now();
 #endif
     while (!GlobalControl::endVmi)
     {
+        if (auto now = std::chrono::steady_clock::now(); now - lastMetricsUpdate >= metricsUpdateInterval)
+        {
+            eventStream->updateMetrics(eventMetrics->createSnapshot());
+            lastMetricsUpdate = now;
+        }
         try
         {
 #ifdef TRACE_MODE
             auto callStart = std::chrono::steady_clock::now();
-            vmiInterface->waitForEvent();
+            auto drainRounds = vmiInterface->waitForEvent();
             auto currentTime = std::chrono::steady_clock::now();
             auto callDuration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - callStart);
             auto elapsedTime = std::chrono::duration_cast<std::chrono::seconds>(currentTime - loopStart);
             logger->debug("Event loop call",
                           {logfield::create("durationMilliseconds", callDuration.count()),
+                           logfield::create("drainRounds", static_cast<uint64_t>(drainRounds)),
                            logfield::create("totalElapsedTimeSeconds", elapsedTime.count())});
 #else
             vmiInterface->waitForEvent();
@@ -63,6 +76,31 @@ void VmiHub::waitForEvents() const
             GlobalControl::endVmi = true;
         }
     }
+    GlobalControl::unregisterEventLoopThread();
+}
+
+void VmiHub::dumpEventMetrics() const
+{
+    auto snapshot = eventMetrics->createSnapshot();
+    eventStream->updateMetrics(snapshot);
+    for (const auto& latency : snapshot.eventLatencies)
+    {
+        if (latency.count == 0)
+        {
+            continue;
+        }
+        logger->info("Event latency",
+                     {logfield::create("source", latency.source),
+                      logfield::create("count", latency.count),
+                      logfield::create("totalNanoseconds", latency.totalNanoseconds),
+                      logfield::create("p50Nanoseconds", latency.p50Nanoseconds),
+                      logfield::create("p90Nanoseconds", latency.p90Nanoseconds),
+                      logfield::create("p99Nanoseconds", latency.p99Nanoseconds),
+                      logfield::create("maxNanoseconds", latency.maxNanoseconds)});
+    }
+    logger->info("Guest pause time",
+                 {logfield::create("totalVmPauseNanoseconds", snapshot.totalVmPauseNanoseconds),
+                  logfield::create("numberOfVmPauses", snapshot.numberOfVmPauses)});
 }
 
 void VmiHub::performShutdownPluginAction() const
@@ -104,6 +142,12 @@ void externalInterruptHandler(int signal)
     exitCode = 128 + signal;
     logReceivedSignal(signal);
     GlobalControl::endVmi = true;
+    GlobalControl::wakeUpEventLoop();
+}
+
+void eventLoopWakeupHandler(int /*signal*/)
+{
+    // Only delivered to interrupt the poll inside libvmi
 }
 
 void setupSignalHandling()
@@ -122,6 +166,18 @@ void setupSignalHandling()
     {
         throw std::runtime_error("Unable to register SIGTERM action handler.");
     }
+    struct sigaction wakeupSigactionStruct
+    {
+    };
+    wakeupSigactionStruct.sa_handler = &eventLoopWakeupHandler;
+    // Callbacks run inside the listen call, so a wakeup may still hit one, whose system calls should not fail. Poll is
+    // never restarted, so libvmi still returns from its wait.
+    wakeupSigactionStruct.sa_flags = SA_RESTART;
+    status = sigaction(GlobalControl::eventLoopWakeupSignal, &wakeupSigactionStruct, nullptr);
+    if (status != 0)
+    {
+        throw std::runtime_error("Unable to register event loop wakeup action handler.");
+    }
 }
 
 uint VmiHub::run(const std::unordered_map<std::string, std::vector<std::string>>& pluginArgs)
@@ -132,6 +188,7 @@ uint VmiHub::run(const std::unordered_map<std::string, std::vector<std::string>>
     {
         case VMI_OS_LINUX:
         {
+            vmiInterface->setKernelPid(Linux::SYSTEM_PID);
             activeProcessesSupervisor =
                 std::make_shared<Linux::ActiveProcessesSupervisor>(vmiInterface, loggingLib, eventStream);
             pluginSystem = std::make_shared<PluginSystem>(configInterface,
@@ -154,6 +211,7 @@ uint VmiHub::run(const std::unordered_map<std::string, std::vector<std::string>>
 #if defined(ARM64)
             throw new std::runtime_error("No support for Windows on ARM yet.");
 #endif
+            vmiInterface->setKernelPid(Windows::systemPid);
             auto kernelObjectExtractor = std::make_shared<Windows::KernelAccess>(vmiInterface);
             activeProcessesSupervisor = std::make_shared<Windows::ActiveProcessesSupervisor>(
                 vmiInterface, kernelObjectExtractor, loggingLib, eventStream);
@@ -186,6 +244,15 @@ uint VmiHub::run(const std::unordered_map<std::string, std::vector<std::string>>
                                                                          : std::vector<std::string>{plugin.first});
     }
 
+    if (!configInterface->getDumpFile().empty())
+    {
+        // A memory dump cannot produce any events, so let the plugins analyze the captured state once and exit
+        activeProcessesSupervisor->initialize();
+        eventStream->sendReadyEvent();
+        pluginSystem->passShutdownEventToRegisteredPlugins();
+        return exitCode;
+    }
+
     vmiInterface->pauseVm();
     systemEventSupervisor->initialize();
     vmiInterface->resumeVm();
@@ -194,10 +261,12 @@ uint VmiHub::run(const std::unordered_map<std::string, std::vector<std::string>>
 
     setupSignalHandling();
     waitForEvents();
+    systemEventSupervisor->finishPendingEvents();
     if (GlobalControl::postRunPluginAction)
     {
         performShutdownPluginAction();
     }
     systemEventSupervisor->teardown();
+    dumpEventMetrics();
     return exitCode;
 }
@@ -6,6 +6,7 @@
 #include "io/ILogging.h"
 #include "os/ISystemEventSupervisor.h"
 #include "plugins/PluginSystem.h"
+#include "vmi/EventMetrics.h"
 #include "vmi/InterruptFactory.h"
 #include "vmi/LibvmiInterface.h"
 #include <memory>
@@ -18,7 +19,8 @@ class VmiHub
            std::shared_ptr<ILibvmiInterface> vmiInterface,
            std::shared_ptr<ILogging> loggingLib,
            std::shared_ptr<IEventStream> eventStream,
-           std::shared_ptr<IInterruptFactory> interruptFactory);
+           std::shared_ptr<IInterruptFactory> interruptFactory,
+           std::shared_ptr<EventMetrics> eventMetrics);
 
     uint run(const std::unordered_map<std::string, std::vector<std::string>>& pluginArgs);
 
@@ -31,9 +33,12 @@ class VmiHub
     std::unique_ptr<ILogger> logger;
     std::shared_ptr<IEventStream> eventStream;
     std::shared_ptr<IInterruptFactory> interruptFactory;
+    std::shared_ptr<EventMetrics> eventMetrics;
 
     void waitForEvents() const;
 
+    void dumpEventMetrics() const;
+
     void performShutdownPluginAction() const;
 };
 
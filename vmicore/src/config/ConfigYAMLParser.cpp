@@ -12,7 +12,31 @@ void ConfigYAMLParser::extractConfiguration(const std::filesystem::path& configu
     {
         configuration.socketPath = configRootNode["vm"]["socket"].as<std::string>();
     }
+    if (configRootNode["vm"]["dump_file"].IsDefined())
+    {
+        configuration.dumpFile = configRootNode["vm"]["dump_file"].as<std::string>();
+    }
     configuration.offsetsFile = configRootNode["vm"]["offsets_file"].as<std::string>();
+    if (configRootNode["vm"]["cache_invalidation"].IsDefined())
+    {
+        configuration.cacheInvalidationPolicy = configRootNode["vm"]["cache_invalidation"].as<std::string>();
+    }
+    if (configRootNode["vm"]["read_handles"].IsDefined())
+    {
+        configuration.numberOfReadHandles = configRootNode["vm"]["read_handles"].as<uint>();
+    }
+    if (configRootNode["vm"]["per_vcpu_event_processing"].IsDefined())
+    {
+        configuration.perVcpuEventProcessing = configRootNode["vm"]["per_vcpu_event_processing"].as<bool>();
+    }
+    if (configRootNode["vm"]["breakpoint_engine"].IsDefined())
+    {
+        configuration.breakpointEngine = configRootNode["vm"]["breakpoint_engine"].as<std::string>();
+    }
+    if (configRootNode["vm"]["event_listen_timeout_ms"].IsDefined())
+    {
+        configuration.eventListenTimeoutMilliseconds = configRootNode["vm"]["event_listen_timeout_ms"].as<uint>();
+    }
     configuration.pluginDirectory = configRootNode["plugin_system"]["directory"].as<std::string>();
 
     for (const auto& node : configRootNode["plugin_system"]["plugins"])
@@ -62,11 +86,46 @@ void ConfigYAMLParser::setSocketPath(const std::filesystem::path& socketPath)
     configuration.socketPath = socketPath;
 }
 
+std::filesystem::path ConfigYAMLParser::getDumpFile() const
+{
+    return configuration.dumpFile;
+}
+
+void ConfigYAMLParser::setDumpFile(const std::filesystem::path& dumpFile)
+{
+    configuration.dumpFile = dumpFile;
+}
+
 std::string ConfigYAMLParser::getOffsetsFile() const
 {
     return configuration.offsetsFile;
 }
 
+std::string ConfigYAMLParser::getCacheInvalidationPolicy() const
+{
+    return configuration.cacheInvalidationPolicy;
+}
+
+uint ConfigYAMLParser::getNumberOfReadHandles() const
+{
+    return configuration.numberOfReadHandles;
+}
+
+bool ConfigYAMLParser::isPerVcpuEventProcessingEnabled() const
+{
+    return configuration.perVcpuEventProcessing;
+}
+
+std::string ConfigYAMLParser::getBreakpointEngine() const
+{
+    return configuration.breakpointEngine;
+}
+
+uint ConfigYAMLParser::getEventListenTimeoutMilliseconds() const
+{
+    return configuration.eventListenTimeoutMilliseconds;
+}
+
 std::filesystem::path ConfigYAMLParser::getPluginDirectory() const
 {
     return configuration.pluginDirectory;
@@ -27,8 +27,22 @@ class ConfigYAMLParser : public IConfigParser
 
     void setSocketPath(const std::filesystem::path& socketPath) override;
 
+    [[nodiscard]] std::filesystem::path getDumpFile() const override;
+
+    void setDumpFile(const std::filesystem::path& dumpFile) override;
+
     [[nodiscard]] std::string getOffsetsFile() const override;
 
+    [[nodiscard]] std::string getCacheInvalidationPolicy() const override;
+
+    [[nodiscard]] uint getNumberOfReadHandles() const override;
+
+    [[nodiscard]] bool isPerVcpuEventProcessingEnabled() const override;
+
+    [[nodiscard]] std::string getBreakpointEngine() const override;
+
+    [[nodiscard]] uint getEventListenTimeoutMilliseconds() const override;
+
     [[nodiscard]] std::filesystem::path getPluginDirectory() const override;
 
     [[nodiscard]] const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&
@@ -41,7 +55,13 @@ class ConfigYAMLParser : public IConfigParser
         std::string logLevel;
         std::string vmName;
         std::filesystem::path socketPath;
+        std::filesystem::path dumpFile;
         std::string offsetsFile;
+        std::string cacheInvalidationPolicy = "full";
+        uint numberOfReadHandles = 0;
+        bool perVcpuEventProcessing = false;
+        std::string breakpointEngine = "int3";
+        uint eventListenTimeoutMilliseconds = 500;
         std::filesystem::path pluginDirectory;
         std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>> plugins{};
     };
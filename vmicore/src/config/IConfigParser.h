@@ -30,8 +30,22 @@ class IConfigParser
 
     virtual void setSocketPath(const std::filesystem::path& socketPath) = 0;
 
+    [[nodiscard]] virtual std::filesystem::path getDumpFile() const = 0;
+
+    virtual void setDumpFile(const std::filesystem::path& dumpFile) = 0;
+
     [[nodiscard]] virtual std::string getOffsetsFile() const = 0;
 
+    [[nodiscard]] virtual std::string getCacheInvalidationPolicy() const = 0;
+
+    [[nodiscard]] virtual uint getNumberOfReadHandles() const = 0;
+
+    [[nodiscard]] virtual bool isPerVcpuEventProcessingEnabled() const = 0;
+
+    [[nodiscard]] virtual std::string getBreakpointEngine() const = 0;
+
+    [[nodiscard]] virtual uint getEventListenTimeoutMilliseconds() const = 0;
+
     [[nodiscard]] virtual std::filesystem::path getPluginDirectory() const = 0;
 
     [[nodiscard]] virtual const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&
@@ -5,6 +5,8 @@
 #include <memory>
 #include <vector>
 
+struct EventMetricsSnapshot;
+
 class IEventStream
 {
   public:
@@ -19,6 +21,8 @@ class IEventStream
     virtual void sendTerminationEvent() = 0;
     virtual void sendErrorEvent(const std::string& message) = 0;
     virtual void sendInMemDetectionEvent(const std::string& message) = 0;
+    // Replaces the metrics reported to clients with the given snapshot
+    virtual void updateMetrics(const EventMetricsSnapshot& snapshot) = 0;
 
   protected:
     IEventStream() = default;
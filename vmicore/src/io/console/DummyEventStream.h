@@ -21,6 +21,8 @@ class DummyEventStream : public IEventStream
     inline void sendErrorEvent([[maybe_unused]] const std::string& message) override {}
 
     inline void sendInMemDetectionEvent([[maybe_unused]] const std::string& message) override {}
+
+    inline void updateMetrics([[maybe_unused]] const EventMetricsSnapshot& snapshot) override {}
 };
 
 #endif // VMICORE_DUMMYEVENTSTREAM_H
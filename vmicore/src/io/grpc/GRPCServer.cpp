@@ -1,4 +1,5 @@
 #include "GRPCServer.h"
+#include "../../vmi/EventMetrics.h"
 #include "GRPCLogger.h"
 #include <cstdint>
 #include <exception>
@@ -77,3 +78,20 @@ void GRPCServer::sendInMemDetectionEvent(const std::string& message)
 {
     (*server)->send_in_mem_detection_event(message);
 }
+
+void GRPCServer::updateMetrics(const EventMetricsSnapshot& snapshot)
+{
+    ::rust::Vec<::grpc::EventLatency> eventLatencies;
+    eventLatencies.reserve(snapshot.eventLatencies.size());
+    for (const auto& latency : snapshot.eventLatencies)
+    {
+        eventLatencies.push_back({latency.source,
+                                  latency.count,
+                                  latency.totalNanoseconds,
+                                  latency.p50Nanoseconds,
+                                  latency.p90Nanoseconds,
+                                  latency.p99Nanoseconds,
+                                  latency.maxNanoseconds});
+    }
+    (*server)->update_metrics(std::move(eventLatencies), snapshot.totalVmPauseNanoseconds, snapshot.numberOfVmPauses);
+}
@@ -42,6 +42,8 @@ class GRPCServer : public ILogging, public IFileTransport, public IEventStream
 
     void sendInMemDetectionEvent(const std::string& message) override;
 
+    void updateMetrics(const EventMetricsSnapshot& snapshot) override;
+
   private:
     std::shared_ptr<::rust::Box<grpc::GRPCServer>> server;
     std::optional<std::thread> grpcThread;
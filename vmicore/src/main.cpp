@@ -20,6 +20,7 @@
 #include "io/grpc/GRPCServer.h"
 #include "vmi/InterruptFactory.h"
 #include "vmi/LibvmiInterface.h"
+#include "vmi/MemoryDumpInterface.h"
 #include "vmi/VmiException.h"
 #include <boost/di.hpp>
 #include <iostream>
@@ -45,7 +46,15 @@ int main(int argc, const char* argv[])
 
         const auto injector = boost::di::make_injector(
             boost::di::bind<IConfigParser>().to<ConfigYAMLParser>(),
-            boost::di::bind<ILibvmiInterface>().to<LibvmiInterface>(),
+            boost::di::bind<ILibvmiInterface>().to(
+                [](const auto& injector) -> std::shared_ptr<ILibvmiInterface>
+                {
+                    if (!injector.template create<std::shared_ptr<IConfigParser>>()->getDumpFile().empty())
+                    {
+                        return injector.template create<std::shared_ptr<MemoryDumpInterface>>();
+                    }
+                    return injector.template create<std::shared_ptr<LibvmiInterface>>();
+                }),
             boost::di::bind<ISingleStepSupervisor>().to<SingleStepSupervisor>(),
             boost::di::bind<IInterruptFactory>().to<InterruptFactory>(),
             boost::di::bind<ILogging>().to(
@@ -92,6 +101,10 @@ int main(int argc, const char* argv[])
         {
             configInterface->setSocketPath(cmd.kvmiSocketArgument.getValue());
         }
+        if (cmd.dumpFileArgument.isSet())
+        {
+            configInterface->setDumpFile(cmd.dumpFileArgument.getValue());
+        }
         if (cmd.resultsDirectoryArgument.isSet())
         {
             configInterface->setResultsDirectory(cmd.resultsDirectoryArgument.getValue());
@@ -2,6 +2,7 @@
 #define VMICORE_IACTIVEPROCESSESSUPERVISOR_H
 
 #include <cstdint>
+#include <list>
 #include <memory>
 #include <vector>
 #include <vmicore/os/ActiveProcessInformation.h>
@@ -20,11 +21,23 @@ class IActiveProcessesSupervisor
 
     virtual void addNewProcess(uint64_t base) = 0;
 
+    // Adds the process with only the information that identifies it and marks it as pending enrichment. Cheap enough
+    // to be called while the vCPU that started the process waits.
+    virtual void registerNewProcess(uint64_t base) = 0;
+
+    // Completes a process added by registerNewProcess and sends its start event
+    virtual void enrichProcess(uint64_t base) = 0;
+
     virtual void removeActiveProcess(uint64_t base) = 0;
 
     [[nodiscard]] virtual std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
     getActiveProcesses() const = 0;
 
+    // Extracts the memory regions of many processes at once with batched guest reads. The result has one entry per
+    // process in the same order, which is null if the memory regions of that process could not be extracted.
+    [[nodiscard]] virtual std::vector<std::unique_ptr<std::list<MemoryRegion>>>
+    extractAllMemoryRegions(const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes) const = 0;
+
   protected:
     IActiveProcessesSupervisor() = default;
 };
@@ -8,6 +8,9 @@ class ISystemEventSupervisor
 
     virtual void initialize() = 0;
 
+    // Blocks until the events whose processing continues after the event response have been processed
+    virtual void finishPendingEvents() = 0;
+
     virtual void teardown() = 0;
 
   protected:
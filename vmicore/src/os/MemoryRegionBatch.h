@@ -0,0 +1,56 @@
+#ifndef VMICORE_MEMORYREGIONBATCH_H
+#define VMICORE_MEMORYREGIONBATCH_H
+
+#include "../io/ILogger.h"
+#include <list>
+#include <memory>
+#include <vector>
+#include <vmicore/os/ActiveProcessInformation.h>
+
+// Extracts the memory regions of all processes. Extractors of type BatchExtractor are handed to its static
+// extractAllMemoryRegions together, all other extractors are called one by one. The result has one entry per process,
+// which is null if the memory regions could not be extracted.
+template <typename BatchExtractor>
+std::vector<std::unique_ptr<std::list<MemoryRegion>>>
+extractMemoryRegionsBatched(const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes,
+                            const ILogger& logger)
+{
+    std::vector<std::unique_ptr<std::list<MemoryRegion>>> regions(processes.size());
+    std::vector<const BatchExtractor*> batchExtractors;
+    std::vector<size_t> batchProcessIndices;
+    for (size_t i = 0; i < processes.size(); i++)
+    {
+        try
+        {
+            const auto* extractor = processes[i]->memoryRegionExtractor.get();
+            if (!extractor)
+            {
+                continue;
+            }
+            if (const auto* batchExtractor = dynamic_cast<const BatchExtractor*>(extractor))
+            {
+                batchExtractors.push_back(batchExtractor);
+                batchProcessIndices.push_back(i);
+            }
+            else
+            {
+                regions[i] = extractor->extractAllMemoryRegions();
+            }
+        }
+        catch (const std::exception& e)
+        {
+            logger.warning("Unable to extract memory regions",
+                           {logfield::create("ProcessId", static_cast<int64_t>(processes[i]->pid)),
+                            logfield::create("exception", e.what())});
+        }
+    }
+
+    auto batchRegions = BatchExtractor::extractAllMemoryRegions(batchExtractors);
+    for (size_t i = 0; i < batchRegions.size(); i++)
+    {
+        regions[batchProcessIndices[i]] = std::move(batchRegions[i]);
+    }
+    return regions;
+}
+
+#endif // VMICORE_MEMORYREGIONBATCH_H
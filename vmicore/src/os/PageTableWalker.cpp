@@ -0,0 +1,176 @@
+#include "PageTableWalker.h"
+#include "../vmi/LibvmiInterface.h"
+#include <span>
+
+namespace
+{
+    constexpr int pml4Level = 4;
+    constexpr int pdptLevel = 3;
+    constexpr int ptLevel = 1;
+}
+
+PageTableWalker::PageTableWalker(ILibvmiInterface& vmiInterface) : vmiInterface(vmiInterface) {}
+
+std::vector<PageTranslation> PageTableWalker::translateRange(uint64_t virtualAddress, uint64_t size, uint64_t cr3)
+{
+    std::vector<PageTranslation> translations;
+    if (size > 0)
+    {
+        walkTable(cr3,
+                  cr3 & PagingDefinitions::tableEntryAddressMask,
+                  pml4Level,
+                  virtualAddress,
+                  virtualAddress + size,
+                  translations);
+    }
+    return translations;
+}
+
+void PageTableWalker::walkTable(uint64_t cr3,
+                                uint64_t tablePA,
+                                int level,
+                                uint64_t virtualAddress,
+                                uint64_t endAddress,
+                                std::vector<PageTranslation>& translations)
+{
+    auto entryShift =
+        PagingDefinitions::numberOfPageIndexBits + (level - 1) * PagingDefinitions::numberOfTableIndexBits;
+    auto entrySpan = 1ull << entryShift;
+    auto table = getTable(cr3, tablePA, level);
+
+    while (virtualAddress < endAddress)
+    {
+        auto entryEnd = (virtualAddress & ~(entrySpan - 1)) + entrySpan;
+        // The last entry of the address space wraps around to 0
+        if (entryEnd == 0 || entryEnd > endAddress)
+        {
+            entryEnd = endAddress;
+        }
+        auto entry =
+            table ? (*table)[(virtualAddress >> entryShift) & (PagingDefinitions::numberOfTableEntries - 1)] : 0;
+
+        if ((entry & PagingDefinitions::tableEntryPresentBit) == 0)
+        {
+            appendTranslation(
+                translations,
+                {virtualAddress, 0, entryEnd - virtualAddress, PagingDefinitions::pageSizeInBytes, false});
+        }
+        else if (level == ptLevel || (level <= pdptLevel && (entry & PagingDefinitions::tableEntryPageSizeBit) != 0))
+        {
+            auto pageBasePA = entry & PagingDefinitions::tableEntryAddressMask & ~(entrySpan - 1);
+            appendTranslation(translations,
+                              {virtualAddress,
+                               pageBasePA + (virtualAddress & (entrySpan - 1)),
+                               entryEnd - virtualAddress,
+                               entrySpan,
+                               true});
+        }
+        else
+        {
+            walkTable(cr3,
+                      entry & PagingDefinitions::tableEntryAddressMask,
+                      level - 1,
+                      virtualAddress,
+                      entryEnd,
+                      translations);
+        }
+        virtualAddress = entryEnd;
+    }
+}
+
+std::shared_ptr<const PageTableWalker::PageTable> PageTableWalker::getTable(uint64_t cr3, uint64_t tablePA, int level)
+{
+    // Leaf tables are not cached since they change far more often than the upper levels
+    if (level != ptLevel)
+    {
+        if (auto cachedTable = lookupCachedTable(cr3, tablePA))
+        {
+            return cachedTable;
+        }
+    }
+
+    auto table = std::make_shared<PageTable>();
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    if (!vmiInterface.readPA(tablePA, std::span(reinterpret_cast<uint8_t*>(table->data()), sizeof(PageTable))))
+    {
+        return nullptr;
+    }
+    if (level != ptLevel)
+    {
+        cacheTable(cr3, tablePA, table);
+    }
+    return table;
+}
+
+std::shared_ptr<const PageTableWalker::PageTable> PageTableWalker::lookupCachedTable(uint64_t cr3, uint64_t tablePA)
+{
+    std::lock_guard<std::mutex> lock(cacheLock);
+    auto addressSpace = cache.find(cr3);
+    if (addressSpace == cache.end())
+    {
+        return nullptr;
+    }
+    leastRecentlyUsedCr3s.splice(
+        leastRecentlyUsedCr3s.begin(), leastRecentlyUsedCr3s, addressSpace->second.lruPosition);
+    auto table = addressSpace->second.tables.find(tablePA);
+    return table != addressSpace->second.tables.end() ? table->second : nullptr;
+}
+
+void PageTableWalker::cacheTable(uint64_t cr3, uint64_t tablePA, std::shared_ptr<const PageTable> table)
+{
+    std::lock_guard<std::mutex> lock(cacheLock);
+    auto addressSpace = cache.find(cr3);
+    if (addressSpace == cache.end())
+    {
+        if (cache.size() >= maximumNumberOfCachedAddressSpaces)
+        {
+            cache.erase(leastRecentlyUsedCr3s.back());
+            leastRecentlyUsedCr3s.pop_back();
+        }
+        leastRecentlyUsedCr3s.push_front(cr3);
+        addressSpace = cache.emplace(cr3, AddressSpaceCache{{}, leastRecentlyUsedCr3s.begin()}).first;
+    }
+    auto& tables = addressSpace->second.tables;
+    if (tables.size() >= maximumNumberOfCachedTablesPerAddressSpace)
+    {
+        tables.clear();
+    }
+    tables[tablePA] = std::move(table);
+}
+
+void PageTableWalker::flush(uint64_t cr3)
+{
+    std::lock_guard<std::mutex> lock(cacheLock);
+    auto addressSpace = cache.find(cr3);
+    if (addressSpace != cache.end())
+    {
+        leastRecentlyUsedCr3s.erase(addressSpace->second.lruPosition);
+        cache.erase(addressSpace);
+    }
+}
+
+void PageTableWalker::flushAll()
+{
+    std::lock_guard<std::mutex> lock(cacheLock);
+    cache.clear();
+    leastRecentlyUsedCr3s.clear();
+}
+
+void PageTableWalker::appendTranslation(std::vector<PageTranslation>& translations, const PageTranslation& translation)
+{
+    if (!translations.empty())
+    {
+        auto& previous = translations.back();
+        auto isAdjacent = previous.virtualAddress + previous.size == translation.virtualAddress;
+        auto isSameKind = previous.present == translation.present &&
+                          (!translation.present || (previous.pageSize == translation.pageSize &&
+                                                    previous.physicalAddress + previous.size ==
+                                                        translation.physicalAddress));
+        if (isAdjacent && isSameKind)
+        {
+            previous.size += translation.size;
+            return;
+        }
+    }
+    translations.push_back(translation);
+}
@@ -0,0 +1,66 @@
+#ifndef VMICORE_PAGETABLEWALKER_H
+#define VMICORE_PAGETABLEWALKER_H
+
+#include "PageTranslation.h"
+#include "PagingDefinitions.h"
+#include <array>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+class ILibvmiInterface;
+
+// Translates whole virtual address ranges for IA-32e 4-level paging only, other paging modes have to be translated by
+// libvmi. Every page table is read at most once per range and non-leaf tables are additionally kept in a bounded
+// per-CR3 cache, which has to be flushed whenever the guest may have modified its page tables. 2 MiB and 1 GiB pages
+// are reported as runs with the respective page size, so a single directory entry covers the whole large page.
+class PageTableWalker
+{
+  public:
+    static constexpr size_t maximumNumberOfCachedAddressSpaces = 32;
+    static constexpr size_t maximumNumberOfCachedTablesPerAddressSpace = 256;
+
+    explicit PageTableWalker(ILibvmiInterface& vmiInterface);
+
+    [[nodiscard]] std::vector<PageTranslation> translateRange(uint64_t virtualAddress, uint64_t size, uint64_t cr3);
+
+    void flush(uint64_t cr3);
+
+    void flushAll();
+
+    // Appends the translation to the last run if it continues that run
+    static void appendTranslation(std::vector<PageTranslation>& translations, const PageTranslation& translation);
+
+  private:
+    using PageTable = std::array<uint64_t, PagingDefinitions::numberOfTableEntries>;
+
+    struct AddressSpaceCache
+    {
+        std::unordered_map<uint64_t, std::shared_ptr<const PageTable>> tables;
+        std::list<uint64_t>::iterator lruPosition;
+    };
+
+    ILibvmiInterface& vmiInterface;
+    std::mutex cacheLock{};
+    std::unordered_map<uint64_t, AddressSpaceCache> cache;
+    std::list<uint64_t> leastRecentlyUsedCr3s;
+
+    void walkTable(uint64_t cr3,
+                   uint64_t tablePA,
+                   int level,
+                   uint64_t virtualAddress,
+                   uint64_t endAddress,
+                   std::vector<PageTranslation>& translations);
+
+    [[nodiscard]] std::shared_ptr<const PageTable> getTable(uint64_t cr3, uint64_t tablePA, int level);
+
+    [[nodiscard]] std::shared_ptr<const PageTable> lookupCachedTable(uint64_t cr3, uint64_t tablePA);
+
+    void cacheTable(uint64_t cr3, uint64_t tablePA, std::shared_ptr<const PageTable> table);
+};
+
+#endif // VMICORE_PAGETABLEWALKER_H
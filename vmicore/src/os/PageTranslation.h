@@ -0,0 +1,16 @@
+#ifndef VMICORE_PAGETRANSLATION_H
+#define VMICORE_PAGETRANSLATION_H
+
+#include <cstdint>
+
+// A run of virtual memory that is either backed by physically contiguous pages of the same size or not present at all.
+struct PageTranslation
+{
+    uint64_t virtualAddress;
+    uint64_t physicalAddress;
+    uint64_t size;
+    uint64_t pageSize;
+    bool present;
+};
+
+#endif // VMICORE_PAGETRANSLATION_H
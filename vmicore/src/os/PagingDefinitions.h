@@ -7,8 +7,16 @@ namespace PagingDefinitions
 {
     constexpr uint64_t numberOfPageIndexBits = 12;
     constexpr uint64_t pageSizeInBytes = 4096;
+    constexpr uint64_t largePageSizeInBytes = 0x200000;
+    constexpr uint64_t hugePageSizeInBytes = 0x40000000;
     constexpr uint64_t stripPageOffsetMask = ~(pageSizeInBytes - 1);
     constexpr uint64_t kernelspaceLowerBoundary = 0xFFFF800000000000;
+
+    constexpr uint64_t numberOfTableIndexBits = 9;
+    constexpr uint64_t numberOfTableEntries = 1 << numberOfTableIndexBits;
+    constexpr uint64_t tableEntryPresentBit = 1ull << 0;
+    constexpr uint64_t tableEntryPageSizeBit = 1ull << 7;
+    constexpr uint64_t tableEntryAddressMask = 0x000FFFFFFFFFF000;
 }
 
 #endif // VMICORE_PAGINGDEFINITIONS_H
@@ -0,0 +1,68 @@
+#include "ProcessTable.h"
+
+std::shared_ptr<ActiveProcessInformation> ProcessTableSnapshot::findByPid(pid_t pid) const
+{
+    auto processInformation = processInformationByPid.find(pid);
+    return processInformation != processInformationByPid.end() ? processInformation->second : nullptr;
+}
+
+std::shared_ptr<ActiveProcessInformation> ProcessTableSnapshot::findByBase(uint64_t base) const
+{
+    auto pid = pidsByBase.find(base);
+    return pid != pidsByBase.end() ? findByPid(pid->second) : nullptr;
+}
+
+ProcessTable::ProcessTable() : currentSnapshot(std::make_shared<const ProcessTableSnapshot>()) {}
+
+std::shared_ptr<const ProcessTableSnapshot> ProcessTable::getSnapshot() const
+{
+    return std::atomic_load_explicit(&currentSnapshot, std::memory_order_acquire);
+}
+
+void ProcessTable::publish(std::shared_ptr<const ProcessTableSnapshot> snapshot)
+{
+    std::atomic_store_explicit(&currentSnapshot, std::move(snapshot), std::memory_order_release);
+}
+
+void ProcessTable::insert(const std::shared_ptr<ActiveProcessInformation>& processInformation)
+{
+    std::scoped_lock lock(writerLock);
+    // Writers are serialized by writerLock, so the current snapshot cannot change underneath
+    auto snapshot = std::make_shared<ProcessTableSnapshot>(*getSnapshot());
+    snapshot->version++;
+
+    // A reused pid or base must not leave a stale mapping behind
+    if (auto replacedProcess = snapshot->findByPid(processInformation->pid);
+        replacedProcess && replacedProcess->base != processInformation->base)
+    {
+        snapshot->pidsByBase.erase(replacedProcess->base);
+    }
+    if (auto replacedPid = snapshot->pidsByBase.find(processInformation->base);
+        replacedPid != snapshot->pidsByBase.end() && replacedPid->second != processInformation->pid)
+    {
+        snapshot->processInformationByPid.erase(replacedPid->second);
+    }
+    snapshot->processInformationByPid[processInformation->pid] = processInformation;
+    snapshot->pidsByBase[processInformation->base] = processInformation->pid;
+
+    publish(std::move(snapshot));
+}
+
+std::shared_ptr<ActiveProcessInformation> ProcessTable::remove(uint64_t base)
+{
+    std::scoped_lock lock(writerLock);
+    auto previousSnapshot = getSnapshot();
+    auto removedProcess = previousSnapshot->findByBase(base);
+    if (!removedProcess)
+    {
+        return nullptr;
+    }
+
+    auto snapshot = std::make_shared<ProcessTableSnapshot>(*previousSnapshot);
+    snapshot->version++;
+    snapshot->processInformationByPid.erase(removedProcess->pid);
+    snapshot->pidsByBase.erase(base);
+
+    publish(std::move(snapshot));
+    return removedProcess;
+}
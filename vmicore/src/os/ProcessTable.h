@@ -0,0 +1,48 @@
+#ifndef VMICORE_PROCESSTABLE_H
+#define VMICORE_PROCESSTABLE_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vmicore/os/ActiveProcessInformation.h>
+
+// Immutable version of the process table. Holding a snapshot keeps it valid regardless of later changes.
+struct ProcessTableSnapshot
+{
+    uint64_t version = 0;
+    std::map<pid_t, std::shared_ptr<ActiveProcessInformation>> processInformationByPid;
+    std::map<uint64_t, pid_t> pidsByBase;
+
+    // Both return null if the process is unknown
+    [[nodiscard]] std::shared_ptr<ActiveProcessInformation> findByPid(pid_t pid) const;
+
+    [[nodiscard]] std::shared_ptr<ActiveProcessInformation> findByBase(uint64_t base) const;
+};
+
+// Copy-on-write process table. Readers only load the current snapshot and never wait for writers, which makes lookups
+// from plugin threads cheap. Writers are serialized and publish a new snapshot for every change.
+class ProcessTable
+{
+  public:
+    ProcessTable();
+
+    [[nodiscard]] std::shared_ptr<const ProcessTableSnapshot> getSnapshot() const;
+
+    // Replaces any process with the same pid or base
+    void insert(const std::shared_ptr<ActiveProcessInformation>& processInformation);
+
+    // Returns the removed process information or null if no process with this base is known
+    std::shared_ptr<ActiveProcessInformation> remove(uint64_t base);
+
+  private:
+    std::mutex writerLock;
+    // Only accessed through std::atomic_load and std::atomic_store, since std::atomic<std::shared_ptr> needs libstdc++
+    // from GCC 12
+    std::shared_ptr<const ProcessTableSnapshot> currentSnapshot;
+
+    void publish(std::shared_ptr<const ProcessTableSnapshot> snapshot);
+};
+
+#endif // VMICORE_PROCESSTABLE_H
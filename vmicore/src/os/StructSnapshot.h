@@ -0,0 +1,119 @@
+#ifndef VMICORE_STRUCTSNAPSHOT_H
+#define VMICORE_STRUCTSNAPSHOT_H
+
+#include "../vmi/LibvmiInterface.h"
+#include <cstring>
+#include <fmt/core.h>
+#include <optional>
+#include <span>
+#include <vector>
+
+class StructSnapshot
+{
+  public:
+    StructSnapshot(ILibvmiInterface& vmiInterface, uint64_t baseVA, size_t size) : baseVA(baseVA), buffer(size)
+    {
+        if (!vmiInterface.readXVA(baseVA, vmiInterface.getKernelDtb(), buffer))
+        {
+            throw VmiException(fmt::format("{}: Unable to read {} bytes from VA {:#x}", __func__, size, baseVA));
+        }
+    }
+
+    static std::optional<StructSnapshot> tryCreate(ILibvmiInterface& vmiInterface, uint64_t baseVA, size_t size)
+    {
+        std::vector<uint8_t> buffer(size);
+        if (!vmiInterface.readXVA(baseVA, vmiInterface.getKernelDtb(), buffer))
+        {
+            return std::nullopt;
+        }
+        return StructSnapshot(baseVA, std::move(buffer));
+    }
+
+    // Reads the structs at all base addresses with a single batched read. Structs that could not be read are empty.
+    static std::vector<std::optional<StructSnapshot>>
+    tryCreateBatch(ILibvmiInterface& vmiInterface, std::span<const uint64_t> baseVAs, size_t size)
+    {
+        if (baseVAs.empty())
+        {
+            return {};
+        }
+        std::vector<std::vector<uint8_t>> buffers(baseVAs.size(), std::vector<uint8_t>(size));
+        std::vector<ReadRequest> requests;
+        requests.reserve(baseVAs.size());
+        for (size_t i = 0; i < baseVAs.size(); i++)
+        {
+            requests.push_back(ReadRequest{baseVAs[i], size, buffers[i].data()});
+        }
+        vmiInterface.readBatchVA(vmiInterface.getKernelDtb(), requests);
+
+        std::vector<std::optional<StructSnapshot>> snapshots;
+        snapshots.reserve(baseVAs.size());
+        for (size_t i = 0; i < baseVAs.size(); i++)
+        {
+            if (requests[i].success)
+            {
+                snapshots.push_back(StructSnapshot(baseVAs[i], std::move(buffers[i])));
+            }
+            else
+            {
+                snapshots.emplace_back(std::nullopt);
+            }
+        }
+        return snapshots;
+    }
+
+    [[nodiscard]] uint64_t getBaseVA() const
+    {
+        return baseVA;
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return buffer.size();
+    }
+
+    template <typename T> [[nodiscard]] T read(addr_t offset) const
+    {
+        expectInBounds(offset, sizeof(T));
+        T value;
+        std::memcpy(&value, buffer.data() + offset, sizeof(T));
+        return value;
+    }
+
+    [[nodiscard]] uint64_t readUnsigned(addr_t offset, size_t size) const
+    {
+        switch (size)
+        {
+            case sizeof(uint8_t):
+                return read<uint8_t>(offset);
+            case sizeof(uint16_t):
+                return read<uint16_t>(offset);
+            case sizeof(uint32_t):
+                return read<uint32_t>(offset);
+            case sizeof(uint64_t):
+                return read<uint64_t>(offset);
+            default:
+                throw VmiException(fmt::format("{}: {} is not a valid integer size", __func__, size));
+        }
+    }
+
+  private:
+    uint64_t baseVA;
+    std::vector<uint8_t> buffer;
+
+    StructSnapshot(uint64_t baseVA, std::vector<uint8_t> buffer) : baseVA(baseVA), buffer(std::move(buffer)) {}
+
+    void expectInBounds(addr_t offset, size_t size) const
+    {
+        if (offset + size > buffer.size())
+        {
+            throw VmiException(fmt::format("Field at offset {:#x} with size {} exceeds snapshot of {} bytes at VA {:#x}",
+                                           offset,
+                                           size,
+                                           buffer.size(),
+                                           baseVA));
+        }
+    }
+};
+
+#endif // VMICORE_STRUCTSNAPSHOT_H
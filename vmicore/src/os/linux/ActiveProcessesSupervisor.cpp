@@ -1,6 +1,7 @@
 #include "ActiveProcessesSupervisor.h"
-#include "Constants.h"
+#include "../MemoryRegionBatch.h"
 #include "MMExtractor.h"
+#include <array>
 #include <fmt/core.h>
 #include <string>
 
@@ -13,14 +14,15 @@ namespace Linux
           logging(loggingLib),
           logger(NEW_LOGGER(loggingLib)),
           eventStream(std::move(eventStream)),
-          pathExtractor(std::move(vmiInterface), loggingLib)
+          kernelOffsets(std::make_shared<KernelOffsets>(KernelOffsets::init(vmiInterface))),
+          pathExtractor(std::make_shared<PathExtractor>(std::move(vmiInterface), kernelOffsets, loggingLib))
     {
     }
 
     void ActiveProcessesSupervisor::initialize()
     {
         logger->info("--- Initialization ---");
-        auto taskOffset = vmiInterface->getOffset("linux_tasks");
+        auto taskOffset = kernelOffsets->taskStruct.tasks;
         auto initTaskVA = vmiInterface->translateKernelSymbolToVA("init_task") + taskOffset;
         auto currentListEntry = initTaskVA;
         logger->debug("Got VA of initTask", {logfield::create("initTaskVA", fmt::format("{:#x}", currentListEntry))});
@@ -28,61 +30,85 @@ namespace Linux
         do
         {
             addNewProcess(currentListEntry - taskOffset);
-            currentListEntry = vmiInterface->read64VA(currentListEntry, vmiInterface->convertPidToDtb(SYSTEM_PID));
+            currentListEntry = vmiInterface->readKernel64(currentListEntry);
         } while (currentListEntry != initTaskVA);
 
         logger->info("--- End of Initialization ---");
     }
 
-    std::unique_ptr<ActiveProcessInformation> ActiveProcessesSupervisor::extractProcessInformation(uint64_t taskStruct)
+    std::shared_ptr<ActiveProcessInformation>
+    ActiveProcessesSupervisor::extractProcessInformation(uint64_t taskStruct, bool resolveProcessPath) const
     {
-        auto processInformation = std::make_unique<ActiveProcessInformation>();
+        auto processInformation = std::make_shared<ActiveProcessInformation>();
         processInformation->base = taskStruct;
+        auto kernelDtb = vmiInterface->getKernelDtb();
+
+        uint64_t mm = 0;
+        uint64_t realParent = 0;
+        std::array taskStructRequests{
+            ReadRequest::create(taskStruct + kernelOffsets->taskStruct.mm, mm),
+            ReadRequest::create(taskStruct + kernelOffsets->taskStruct.real_parent, realParent),
+            ReadRequest::create(taskStruct + kernelOffsets->taskStruct.pid, processInformation->pid)};
+        vmiInterface->readBatchVAOrThrow(kernelDtb, taskStructRequests, static_cast<const char*>(__func__));
+
+        uint64_t pgd = 0;
+        std::vector<ReadRequest> dependentRequests{
+            ReadRequest::create(realParent + kernelOffsets->taskStruct.tgid, processInformation->parentPid)};
+        if (mm != 0)
+        {
+            dependentRequests.push_back(ReadRequest::create(mm + kernelOffsets->mmStruct.pgd, pgd));
+        }
+        vmiInterface->readBatchVAOrThrow(kernelDtb, dependentRequests, static_cast<const char*>(__func__));
+
+        processInformation->name =
+            *vmiInterface->extractStringAtVA(taskStruct + kernelOffsets->taskStruct.comm, kernelDtb);
 
-        auto mm = vmiInterface->read64VA(taskStruct + vmiInterface->getKernelStructOffset("task_struct", "mm"),
-                                         vmiInterface->convertPidToDtb(SYSTEM_PID));
+        // Kernel threads have no address space and therefore neither an executable nor memory regions
         if (mm != 0)
         {
-            processInformation->processCR3 =
-                vmiInterface->convertVAToPA(vmiInterface->read64VA(mm + vmiInterface->getOffset("linux_pgd"),
-                                                                   vmiInterface->convertPidToDtb(SYSTEM_PID)),
-                                            vmiInterface->convertPidToDtb(SYSTEM_PID));
-            processInformation->processPath = std::make_unique<std::string>(pathExtractor.extractDPath(
-                vmiInterface->read64VA(mm + vmiInterface->getKernelStructOffset("mm_struct", "exe_file"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID)) +
-                vmiInterface->getKernelStructOffset("file", "f_path")));
-            processInformation->fullName = processInformation->processPath
-                                               ? splitProcessFileNameFromPath(*processInformation->processPath)
-                                               : nullptr;
-            processInformation->memoryRegionExtractor = std::make_unique<MMExtractor>(vmiInterface, logging, mm);
-        }
-
-        processInformation->pid = extractPid(taskStruct);
-        processInformation->parentPid = vmiInterface->read32VA(
-            vmiInterface->read64VA(taskStruct + vmiInterface->getKernelStructOffset("task_struct", "real_parent"),
-                                   vmiInterface->convertPidToDtb(SYSTEM_PID)) +
-                vmiInterface->getKernelStructOffset("task_struct", "tgid"),
-            vmiInterface->convertPidToDtb(SYSTEM_PID));
-        processInformation->name = *vmiInterface->extractStringAtVA(taskStruct + vmiInterface->getOffset("linux_name"),
-                                                                    vmiInterface->convertPidToDtb(SYSTEM_PID));
+            processInformation->processCR3 = vmiInterface->convertVAToPA(pgd, kernelDtb);
+            addUserSpaceProcessInformation(*processInformation, mm, resolveProcessPath);
+        }
 
         return processInformation;
     }
 
+    void ActiveProcessesSupervisor::addUserSpaceProcessInformation(ActiveProcessInformation& processInformation,
+                                                                   uint64_t mm,
+                                                                   bool resolveProcessPath) const
+    {
+        if (resolveProcessPath)
+        {
+            auto processPath = extractProcessPathOrEmpty(*vmiInterface,
+                                                         *kernelOffsets,
+                                                         *pathExtractor,
+                                                         logging,
+                                                         mm,
+                                                         processInformation.pid,
+                                                         processInformation.name);
+            processInformation.fullName = splitProcessFileNameFromPathOrEmpty(*processPath);
+            processInformation.processPath = std::move(processPath);
+        }
+        else
+        {
+            // Plugins compare the file name against their configuration, so the command name stands in for it
+            processInformation.fullName = std::make_unique<std::string>(processInformation.name);
+            processInformation.processPath = std::make_unique<std::string>();
+        }
+        processInformation.memoryRegionExtractor = LazyValue<IMemoryRegionExtractor>(
+            [vmiInterface = vmiInterface, kernelOffsets = kernelOffsets, logging = logging, mm]()
+            { return std::make_unique<MMExtractor>(vmiInterface, kernelOffsets, logging, mm); });
+    }
+
     pid_t ActiveProcessesSupervisor::extractPid(uint64_t taskStruct) const
     {
-        return vmiInterface->read32VA(taskStruct + vmiInterface->getOffset("linux_pid"),
-                                      vmiInterface->convertPidToDtb(SYSTEM_PID));
+        return vmiInterface->readKernel32(taskStruct + kernelOffsets->taskStruct.pid);
     }
 
     std::shared_ptr<ActiveProcessInformation> ActiveProcessesSupervisor::getProcessInformationByPid(pid_t pid) const
     {
-        std::shared_ptr<ActiveProcessInformation> processInformation;
-        try
-        {
-            processInformation = processInformationByPid.at(pid);
-        }
-        catch (const std::out_of_range&)
+        auto processInformation = processTable.getSnapshot()->findByPid(pid);
+        if (!processInformation)
         {
             throw std::invalid_argument("Unable to find process with pid " + std::to_string(pid));
         }
@@ -92,106 +118,171 @@ namespace Linux
     std::shared_ptr<ActiveProcessInformation>
     ActiveProcessesSupervisor::getProcessInformationByBase(uint64_t taskStruct) const
     {
-        const auto pidIterator = pidsByTaskStruct.find(taskStruct);
-        if (pidIterator == pidsByTaskStruct.cend())
+        auto processInformation = processTable.getSnapshot()->findByBase(taskStruct);
+        if (!processInformation)
         {
             throw std::invalid_argument(
                 fmt::format("{}: Process with taskStruct {:#x} not in process cache.", __func__, taskStruct));
         }
-        return getProcessInformationByPid(pidIterator->second);
+        return processInformation;
     }
 
     void ActiveProcessesSupervisor::addNewProcess(uint64_t taskStruct)
     {
-        std::shared_ptr<ActiveProcessInformation> processInformation(extractProcessInformation(taskStruct));
+        auto processInformation = extractProcessInformation(taskStruct, true);
+        storeProcess(processInformation);
+        announceProcess(*processInformation);
+    }
+
+    void ActiveProcessesSupervisor::registerNewProcess(uint64_t taskStruct)
+    {
+        auto processInformation = extractProcessInformation(taskStruct, false);
+        processInformation->enrichmentPending = true;
+        storeProcess(processInformation);
+        logger->debug("Registered process pending enrichment",
+                      {logfield::create("ProcessName", processInformation->name),
+                       logfield::create("ProcessId", static_cast<uint64_t>(processInformation->pid))});
+    }
+
+    void ActiveProcessesSupervisor::enrichProcess(uint64_t taskStruct)
+    {
+        try
+        {
+            if (!getProcessInformationByBase(taskStruct)->enrichmentPending)
+            {
+                return;
+            }
+        }
+        catch (const std::invalid_argument& e)
+        {
+            logger->warning("Unable to enrich process", {logfield::create("exception", e.what())});
+            return;
+        }
+
+        // Published process information is never modified, so the enriched information replaces it
+        auto processInformation = extractProcessInformation(taskStruct, true);
+        storeProcess(processInformation);
+        announceProcess(*processInformation);
+    }
+
+    void ActiveProcessesSupervisor::storeProcess(const std::shared_ptr<ActiveProcessInformation>& processInformation)
+    {
+        processTable.insert(processInformation);
+    }
+
+    void ActiveProcessesSupervisor::announceProcess(const ActiveProcessInformation& processInformation) const
+    {
         std::string parentPid("unknownParentPid");
         std::string parentName("unknownParentName");
         std::string parentCr3("unknownParentCr3");
-        auto parentProcessInformation = processInformationByPid.find(processInformation->parentPid);
-        if (parentProcessInformation != processInformationByPid.end())
+        if (auto parentProcessInformation = processTable.getSnapshot()->findByPid(processInformation.parentPid))
         {
-            parentPid = std::to_string(parentProcessInformation->second->pid);
-            parentName = parentProcessInformation->second->name;
-            parentCr3 = fmt::format("{:#x}", parentProcessInformation->second->processCR3);
+            parentPid = std::to_string(parentProcessInformation->pid);
+            parentName = parentProcessInformation->name;
+            parentCr3 = fmt::format("{:#x}", parentProcessInformation->processCR3);
         }
         eventStream->sendProcessEvent(::grpc::ProcessState::Started,
-                                      processInformation->name,
-                                      static_cast<uint32_t>(processInformation->pid),
-                                      fmt::format("{:#x}", processInformation->processCR3));
+                                      processInformation.name,
+                                      static_cast<uint32_t>(processInformation.pid),
+                                      fmt::format("{:#x}", processInformation.processCR3));
         logger->info("Discovered active process",
-                     {logfield::create("ProcessName", processInformation->name),
-                      logfield::create("ProcessId", static_cast<uint64_t>(processInformation->pid)),
-                      logfield::create("ProcessCr3", fmt::format("{:#x}", processInformation->processCR3)),
+                     {logfield::create("ProcessName", processInformation.name),
+                      logfield::create("ProcessId", static_cast<uint64_t>(processInformation.pid)),
+                      logfield::create("ProcessCr3", fmt::format("{:#x}", processInformation.processCR3)),
                       logfield::create("ParentProcessName", parentName),
                       logfield::create("ParentProcessId", parentPid),
                       logfield::create("ParentProcessCr3", parentCr3)});
-        processInformationByPid[processInformation->pid] = processInformation;
-        pidsByTaskStruct[processInformation->base] = processInformation->pid;
     }
 
     void ActiveProcessesSupervisor::removeActiveProcess(uint64_t taskStruct)
     {
-        auto taskStructIterator = pidsByTaskStruct.find(taskStruct);
-        if (taskStructIterator != pidsByTaskStruct.end())
-        {
-            auto processInformationIterator = processInformationByPid.find(taskStructIterator->second);
-            if (processInformationIterator == processInformationByPid.end())
-            {
-                logger->warning("Process information not found for process",
-                                {logfield::create("taskStruct", fmt::format("{:#x}", taskStruct)),
-                                 logfield::create("ProcessId", static_cast<uint64_t>(taskStructIterator->second))});
-            }
-            else
-            {
-                std::string parentPid("unknownParentPid");
-                std::string parentName("unknownParentName");
-                std::string parentCr3("unknownParentCr3");
-                auto parentProcessInformation =
-                    processInformationByPid.find(processInformationIterator->second->parentPid);
-                if (parentProcessInformation != processInformationByPid.end())
-                {
-                    parentPid = std::to_string(parentProcessInformation->second->pid);
-                    parentName = parentProcessInformation->second->name;
-                    parentCr3 = fmt::format("{:#x}", parentProcessInformation->second->processCR3);
-                }
-
-                eventStream->sendProcessEvent(::grpc::ProcessState::Terminated,
-                                              processInformationIterator->second->name,
-                                              static_cast<uint32_t>(processInformationIterator->second->pid),
-                                              fmt::format("{:#x}", processInformationIterator->second->processCR3));
-                logger->info(
-                    "Remove process from actives processes",
-                    {logfield::create("ProcessName", processInformationIterator->second->name),
-                     logfield::create("ProcessId", static_cast<uint64_t>(processInformationIterator->second->pid)),
-                     logfield::create("ProcessCr3",
-                                      fmt::format("{:#x}", processInformationIterator->second->processCR3)),
-                     logfield::create("ParentProcessName", parentName),
-                     logfield::create("ParentProcessId", parentPid),
-                     logfield::create("ParentProcessCr3", parentCr3)});
-
-                processInformationByPid.erase(processInformationIterator);
-            }
-            pidsByTaskStruct.erase(taskStructIterator);
-        }
-        else
+        auto removedProcess = processTable.remove(taskStruct);
+        if (!removedProcess)
         {
             logger->warning("Process does not seem to be stored as an active process",
                             {logfield::create("taskStruct", fmt::format("{:#x}", taskStruct))});
+            return;
         }
+
+        std::string parentPid("unknownParentPid");
+        std::string parentName("unknownParentName");
+        std::string parentCr3("unknownParentCr3");
+        if (auto parentProcessInformation = processTable.getSnapshot()->findByPid(removedProcess->parentPid))
+        {
+            parentPid = std::to_string(parentProcessInformation->pid);
+            parentName = parentProcessInformation->name;
+            parentCr3 = fmt::format("{:#x}", parentProcessInformation->processCR3);
+        }
+
+        eventStream->sendProcessEvent(::grpc::ProcessState::Terminated,
+                                      removedProcess->name,
+                                      static_cast<uint32_t>(removedProcess->pid),
+                                      fmt::format("{:#x}", removedProcess->processCR3));
+        logger->info("Remove process from actives processes",
+                     {logfield::create("ProcessName", removedProcess->name),
+                      logfield::create("ProcessId", static_cast<uint64_t>(removedProcess->pid)),
+                      logfield::create("ProcessCr3", fmt::format("{:#x}", removedProcess->processCR3)),
+                      logfield::create("ParentProcessName", parentName),
+                      logfield::create("ParentProcessId", parentPid),
+                      logfield::create("ParentProcessCr3", parentCr3)});
     }
 
     std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
     ActiveProcessesSupervisor::getActiveProcesses() const
     {
         auto runningProcesses = std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>();
-        for (const auto& element : processInformationByPid)
+        auto snapshot = processTable.getSnapshot();
+        for (const auto& [pid, processInformation] : snapshot->processInformationByPid)
         {
-            runningProcesses->push_back(element.second);
+            runningProcesses->push_back(processInformation);
         }
         return runningProcesses;
     }
 
-    std::unique_ptr<std::string> ActiveProcessesSupervisor::splitProcessFileNameFromPath(const std::string& path) const
+    std::vector<std::unique_ptr<std::list<MemoryRegion>>> ActiveProcessesSupervisor::extractAllMemoryRegions(
+        const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes) const
+    {
+        return extractMemoryRegionsBatched<MMExtractor>(processes, *logger);
+    }
+
+    std::unique_ptr<std::string>
+    ActiveProcessesSupervisor::extractProcessPathOrEmpty(ILibvmiInterface& vmiInterface,
+                                                         const KernelOffsets& kernelOffsets,
+                                                         const PathExtractor& pathExtractor,
+                                                         const std::shared_ptr<ILogging>& logging,
+                                                         uint64_t mm,
+                                                         pid_t pid,
+                                                         const std::string& name)
+    {
+        try
+        {
+            auto exeFile = vmiInterface.readKernel64(mm + kernelOffsets.mmStruct.exe_file);
+            return std::make_unique<std::string>(pathExtractor.extractDPath(exeFile + kernelOffsets.file.f_path));
+        }
+        catch (const std::exception& e)
+        {
+            NEW_LOGGER(logging)->warning("Process",
+                                         {logfield::create("ProcessName", name),
+                                          logfield::create("ProcessId", static_cast<uint64_t>(pid)),
+                                          logfield::create("Exception", e.what())});
+            return std::make_unique<std::string>();
+        }
+    }
+
+    std::unique_ptr<std::string>
+    ActiveProcessesSupervisor::splitProcessFileNameFromPathOrEmpty(const std::string& path)
+    {
+        try
+        {
+            return splitProcessFileNameFromPath(path);
+        }
+        catch (const std::exception&)
+        {
+            return std::make_unique<std::string>();
+        }
+    }
+
+    std::unique_ptr<std::string> ActiveProcessesSupervisor::splitProcessFileNameFromPath(const std::string& path)
     {
         auto substringStartIterator =
             std::find_if(path.crbegin(), path.crend(), [](const char c) { return c == '/'; }).base();
@@ -6,8 +6,9 @@
 #include "../../io/ILogging.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "../IActiveProcessesSupervisor.h"
+#include "../ProcessTable.h"
+#include "KernelOffsets.h"
 #include "PathExtractor.h"
-#include <map>
 #include <memory>
 
 namespace Linux
@@ -28,25 +29,56 @@ namespace Linux
 
         void addNewProcess(uint64_t taskStruct) override;
 
+        void registerNewProcess(uint64_t taskStruct) override;
+
+        void enrichProcess(uint64_t taskStruct) override;
+
         void removeActiveProcess(uint64_t taskStruct) override;
 
         [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
         getActiveProcesses() const override;
 
+        [[nodiscard]] std::vector<std::unique_ptr<std::list<MemoryRegion>>> extractAllMemoryRegions(
+            const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes) const override;
+
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::shared_ptr<ILogging> logging;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<IEventStream> eventStream;
-        PathExtractor pathExtractor;
-        std::map<pid_t, std::shared_ptr<ActiveProcessInformation>> processInformationByPid;
-        std::map<uint64_t, pid_t> pidsByTaskStruct;
+        std::shared_ptr<const KernelOffsets> kernelOffsets;
+        std::shared_ptr<const PathExtractor> pathExtractor;
+        ProcessTable processTable;
+
+        // Without resolveProcessPath, the path stays empty and the image name stands in for the file name, which keeps
+        // the registration of a process short. Otherwise the path is read right away, because the mm_struct it is
+        // read from is replaced on exec and released before the exit of the task is hooked.
+        [[nodiscard]] std::shared_ptr<ActiveProcessInformation> extractProcessInformation(uint64_t taskStruct,
+                                                                                        bool resolveProcessPath) const;
 
-        [[nodiscard]] std::unique_ptr<ActiveProcessInformation> extractProcessInformation(uint64_t taskStruct);
+        void addUserSpaceProcessInformation(ActiveProcessInformation& processInformation,
+                                            uint64_t mm,
+                                            bool resolveProcessPath) const;
+
+        void storeProcess(const std::shared_ptr<ActiveProcessInformation>& processInformation);
+
+        void announceProcess(const ActiveProcessInformation& processInformation) const;
 
         [[nodiscard]] pid_t extractPid(uint64_t taskStruct) const;
 
-        [[nodiscard]] std::unique_ptr<std::string> splitProcessFileNameFromPath(const std::string& path) const;
+        // Logs the failure and returns an empty path if the path cannot be extracted
+        [[nodiscard]] static std::unique_ptr<std::string>
+        extractProcessPathOrEmpty(ILibvmiInterface& vmiInterface,
+                                  const KernelOffsets& kernelOffsets,
+                                  const PathExtractor& pathExtractor,
+                                  const std::shared_ptr<ILogging>& logging,
+                                  uint64_t mm,
+                                  pid_t pid,
+                                  const std::string& name);
+
+        [[nodiscard]] static std::unique_ptr<std::string> splitProcessFileNameFromPathOrEmpty(const std::string& path);
+
+        [[nodiscard]] static std::unique_ptr<std::string> splitProcessFileNameFromPath(const std::string& path);
     };
 }
 
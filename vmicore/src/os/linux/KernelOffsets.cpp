@@ -0,0 +1,40 @@
+#include "KernelOffsets.h"
+#include <fmt/core.h>
+
+namespace Linux
+{
+    KernelOffsets KernelOffsets::init(const std::shared_ptr<ILibvmiInterface>& vmiInterface)
+    {
+        if (!vmiInterface->isInitialized())
+        {
+            throw std::invalid_argument(fmt::format("{}: Aborting, vmiInterface not initialized yet.", __func__));
+        }
+
+        KernelOffsets kernelOffsets{
+            .taskStruct = {.tasks = vmiInterface->getOffset("linux_tasks"),
+                           .mm = vmiInterface->getKernelStructOffset("task_struct", "mm"),
+                           .pid = vmiInterface->getOffset("linux_pid"),
+                           .tgid = vmiInterface->getKernelStructOffset("task_struct", "tgid"),
+                           .real_parent = vmiInterface->getKernelStructOffset("task_struct", "real_parent"),
+                           .comm = vmiInterface->getOffset("linux_name")},
+            .mmStruct = {.pgd = vmiInterface->getOffset("linux_pgd"),
+                         .exe_file = vmiInterface->getKernelStructOffset("mm_struct", "exe_file")},
+            .vmAreaStruct = {.vm_start = vmiInterface->getKernelStructOffset("vm_area_struct", "vm_start"),
+                             .vm_end = vmiInterface->getKernelStructOffset("vm_area_struct", "vm_end"),
+                             .vm_next = vmiInterface->getKernelStructOffset("vm_area_struct", "vm_next"),
+                             .vm_flags = vmiInterface->getKernelStructOffset("vm_area_struct", "vm_flags"),
+                             .vm_file = vmiInterface->getKernelStructOffset("vm_area_struct", "vm_file"),
+                             .size = vmiInterface->getStructSizeFromJson("vm_area_struct")},
+            .file = {.f_path = vmiInterface->getKernelStructOffset("file", "f_path")},
+            .path = {.mnt = vmiInterface->getKernelStructOffset("path", "mnt"),
+                     .dentry = vmiInterface->getKernelStructOffset("path", "dentry")},
+            .dentry = {.d_name = vmiInterface->getKernelStructOffset("dentry", "d_name"),
+                       .d_parent = vmiInterface->getKernelStructOffset("dentry", "d_parent")},
+            .qstr = {.name = vmiInterface->getKernelStructOffset("qstr", "name")},
+            .mount = {.mnt = vmiInterface->getKernelStructOffset("mount", "mnt"),
+                      .mnt_mountpoint = vmiInterface->getKernelStructOffset("mount", "mnt_mountpoint"),
+                      .mnt_parent = vmiInterface->getKernelStructOffset("mount", "mnt_parent")}};
+
+        return kernelOffsets;
+    }
+}
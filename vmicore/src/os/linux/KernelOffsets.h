@@ -0,0 +1,85 @@
+#ifndef VMICORE_LINUX_KERNELOFFSETS_H
+#define VMICORE_LINUX_KERNELOFFSETS_H
+
+#include "../../vmi/LibvmiInterface.h"
+#include <memory>
+
+namespace Linux
+{
+    // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+    namespace KernelStructOffsets
+    {
+        using task_struct = struct task_struct
+        {
+            addr_t tasks;
+            addr_t mm;
+            addr_t pid;
+            addr_t tgid;
+            addr_t real_parent;
+            addr_t comm;
+        } __attribute__((aligned(64)));
+
+        using mm_struct = struct mm_struct
+        {
+            addr_t pgd;
+            addr_t exe_file;
+        } __attribute__((aligned(16)));
+
+        using vm_area_struct = struct vm_area_struct
+        {
+            addr_t vm_start;
+            addr_t vm_end;
+            addr_t vm_next;
+            addr_t vm_flags;
+            addr_t vm_file;
+            size_t size;
+        } __attribute__((aligned(64)));
+
+        using file = struct file
+        {
+            addr_t f_path;
+        };
+
+        using path = struct path
+        {
+            addr_t mnt;
+            addr_t dentry;
+        } __attribute__((aligned(16)));
+
+        using dentry = struct dentry
+        {
+            addr_t d_name;
+            addr_t d_parent;
+        } __attribute__((aligned(16)));
+
+        using qstr = struct qstr
+        {
+            addr_t name;
+        };
+
+        using mount = struct mount
+        {
+            addr_t mnt;
+            addr_t mnt_mountpoint;
+            addr_t mnt_parent;
+        } __attribute__((aligned(32)));
+    } // namespace KernelStructOffsets
+    // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+
+    class KernelOffsets
+    {
+      public:
+        static KernelOffsets init(const std::shared_ptr<ILibvmiInterface>& vmiInterface);
+
+        KernelStructOffsets::task_struct taskStruct{};
+        KernelStructOffsets::mm_struct mmStruct{};
+        KernelStructOffsets::vm_area_struct vmAreaStruct{};
+        KernelStructOffsets::file file{};
+        KernelStructOffsets::path path{};
+        KernelStructOffsets::dentry dentry{};
+        KernelStructOffsets::qstr qstr{};
+        KernelStructOffsets::mount mount{};
+    };
+}
+
+#endif // VMICORE_LINUX_KERNELOFFSETS_H
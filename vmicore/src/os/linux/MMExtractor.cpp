@@ -1,61 +1,155 @@
 #include "MMExtractor.h"
 #include "../PageProtection.h"
-#include "Constants.h"
 #include "ProtectionValues.h"
+#include <array>
 
 namespace Linux
 {
     MMExtractor::MMExtractor(const std::shared_ptr<ILibvmiInterface>& vmiInterface,
+                             const std::shared_ptr<const KernelOffsets>& kernelOffsets,
                              const std::shared_ptr<ILogging>& logging,
                              uint64_t mm)
-        : vmiInterface(vmiInterface), logger(NEW_LOGGER(logging)), pathExtractor(vmiInterface, logging), mm(mm)
+        : vmiInterface(vmiInterface),
+          kernelOffsets(kernelOffsets),
+          logger(NEW_LOGGER(logging)),
+          pathExtractor(vmiInterface, kernelOffsets, logging),
+          mm(mm)
     {
     }
 
     std::unique_ptr<std::list<MemoryRegion>> MMExtractor::extractAllMemoryRegions() const
     {
-        auto regions = std::make_unique<std::list<MemoryRegion>>();
+        std::array mmExtractors{this};
+        auto regions = std::move(extractAllMemoryRegions(mmExtractors).front());
+        if (!regions)
+        {
+            throw VmiException(fmt::format("{}: Unable to walk VMAs of mm {:#x}", __func__, mm));
+        }
+        return regions;
+    }
 
-        for (auto area = vmiInterface->read64VA(mm, vmiInterface->convertPidToDtb(SYSTEM_PID)); area != 0;
-             area = vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_next"),
-                                           vmiInterface->convertPidToDtb(SYSTEM_PID)))
+    std::vector<std::unique_ptr<std::list<MemoryRegion>>>
+    MMExtractor::extractAllMemoryRegions(std::span<const MMExtractor* const> mmExtractors)
+    {
+        std::vector<std::unique_ptr<std::list<MemoryRegion>>> regions(mmExtractors.size());
+        if (mmExtractors.empty())
+        {
+            return regions;
+        }
+        const auto& vmiInterface = mmExtractors.front()->vmiInterface;
+        const auto& kernelOffsets = mmExtractors.front()->kernelOffsets;
+#ifdef TRACE_MODE
+        auto libvmiCallsAtStart = vmiInterface->getNumberOfLibvmiCalls();
+        uint64_t numberOfSteps = 0;
+#endif
+        // Current VMA of every list, the first one is pointed to by the start of the mm_struct
+        std::vector<uint64_t> areas(mmExtractors.size());
+        std::vector<ReadRequest> requests;
+        requests.reserve(mmExtractors.size());
+        for (size_t i = 0; i < mmExtractors.size(); i++)
         {
-            const auto start =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_start"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto end =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_end"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto size = end - start + 1;
-            const auto flags =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_flags"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto file =
-                vmiInterface->read64VA(area + vmiInterface->getKernelStructOffset("vm_area_struct", "vm_file"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            std::string fileName{};
-            if (file != 0)
+            requests.push_back(ReadRequest::create(mmExtractors[i]->mm, areas[i]));
+        }
+        vmiInterface->readBatchVA(vmiInterface->getKernelDtb(), requests);
+        for (size_t i = 0; i < mmExtractors.size(); i++)
+        {
+            if (requests[i].success)
             {
-                fileName = pathExtractor.extractDPath(file + vmiInterface->getKernelStructOffset("file", "f_path"));
+                regions[i] = std::make_unique<std::list<MemoryRegion>>();
+            }
+            else
+            {
+                mmExtractors[i]->logger->warning("Unable to read first VMA",
+                                                 {logfield::create("mm", fmt::format("{:#x}", mmExtractors[i]->mm))});
             }
-
-            auto permissions = std::make_unique<PageProtection>(flags, OperatingSystem::LINUX);
-
-            logger->debug("Memory Region",
-                          {logfield::create("start", fmt::format("{:#x}", start)),
-                           logfield::create("end", fmt::format("{:#x}", end)),
-                           logfield::create("size", size),
-                           logfield::create("permissions", permissions->toString()),
-                           logfield::create("filename", fileName)});
-            regions->emplace_back(start,
-                                  size,
-                                  fileName,
-                                  std::move(permissions),
-                                  !!(flags & static_cast<uint8_t>(ProtectionValues::VM_SHARED)),
-                                  false,
-                                  false);
         }
 
+        std::vector<size_t> pendingLists;
+        std::vector<uint64_t> pendingAreas;
+        do
+        {
+            pendingLists.clear();
+            pendingAreas.clear();
+            for (size_t i = 0; i < mmExtractors.size(); i++)
+            {
+                if (regions[i] && areas[i] != 0)
+                {
+                    pendingLists.push_back(i);
+                    pendingAreas.push_back(areas[i]);
+                }
+            }
+
+            auto vmAreaStructs =
+                StructSnapshot::tryCreateBatch(*vmiInterface, pendingAreas, kernelOffsets->vmAreaStruct.size);
+            for (size_t i = 0; i < pendingLists.size(); i++)
+            {
+                auto listIndex = pendingLists[i];
+                if (!vmAreaStructs[i])
+                {
+                    // A partial VMA list would look like unmapped memory, so drop the whole list
+                    mmExtractors[listIndex]->logger->warning(
+                        "Unable to read VMA",
+                        {logfield::create("mm", fmt::format("{:#x}", mmExtractors[listIndex]->mm)),
+                         logfield::create("vm_area_struct", fmt::format("{:#x}", pendingAreas[i]))});
+                    regions[listIndex].reset();
+                    continue;
+                }
+                areas[listIndex] = vmAreaStructs[i]->read<uint64_t>(kernelOffsets->vmAreaStruct.vm_next);
+                try
+                {
+                    mmExtractors[listIndex]->addMemoryRegion(*regions[listIndex], *vmAreaStructs[i]);
+                }
+                catch (const std::exception& e)
+                {
+                    mmExtractors[listIndex]->logger->warning(
+                        "Unable to extract memory region",
+                        {logfield::create("mm", fmt::format("{:#x}", mmExtractors[listIndex]->mm)),
+                         logfield::create("exception", e.what())});
+                    regions[listIndex].reset();
+                }
+            }
+#ifdef TRACE_MODE
+            numberOfSteps++;
+#endif
+        } while (!pendingLists.empty());
+
+#ifdef TRACE_MODE
+        mmExtractors.front()->logger->debug(
+            "VMA walks finished",
+            {logfield::create("numberOfVmaLists", static_cast<uint64_t>(mmExtractors.size())),
+             logfield::create("numberOfSteps", numberOfSteps),
+             logfield::create("libvmiCalls", vmiInterface->getNumberOfLibvmiCalls() - libvmiCallsAtStart)});
+#endif
         return regions;
     }
+
+    void MMExtractor::addMemoryRegion(std::list<MemoryRegion>& regions, const StructSnapshot& vmAreaStruct) const
+    {
+        const auto start = vmAreaStruct.read<uint64_t>(kernelOffsets->vmAreaStruct.vm_start);
+        const auto end = vmAreaStruct.read<uint64_t>(kernelOffsets->vmAreaStruct.vm_end);
+        const auto size = end - start + 1;
+        const auto flags = vmAreaStruct.read<uint64_t>(kernelOffsets->vmAreaStruct.vm_flags);
+        const auto file = vmAreaStruct.read<uint64_t>(kernelOffsets->vmAreaStruct.vm_file);
+        std::string fileName{};
+        if (file != 0)
+        {
+            fileName = pathExtractor.extractDPath(file + kernelOffsets->file.f_path);
+        }
+
+        auto permissions = std::make_unique<PageProtection>(flags, OperatingSystem::LINUX);
+
+        logger->debug("Memory Region",
+                      {logfield::create("start", fmt::format("{:#x}", start)),
+                       logfield::create("end", fmt::format("{:#x}", end)),
+                       logfield::create("size", size),
+                       logfield::create("permissions", permissions->toString()),
+                       logfield::create("filename", fileName)});
+        regions.emplace_back(start,
+                             size,
+                             fileName,
+                             std::move(permissions),
+                             !!(flags & static_cast<uint8_t>(ProtectionValues::VM_SHARED)),
+                             false,
+                             false);
+    }
 }
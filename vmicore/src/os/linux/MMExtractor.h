@@ -4,7 +4,11 @@
 #include "../../io/ILogger.h"
 #include "../../io/ILogging.h"
 #include "../../vmi/LibvmiInterface.h"
+#include "../StructSnapshot.h"
+#include "KernelOffsets.h"
 #include "PathExtractor.h"
+#include <span>
+#include <vector>
 #include <vmicore/os/IMemoryRegionExtractor.h>
 
 namespace Linux
@@ -13,16 +17,26 @@ namespace Linux
     {
       public:
         MMExtractor(const std::shared_ptr<ILibvmiInterface>& vmiInterface,
+                    const std::shared_ptr<const KernelOffsets>& kernelOffsets,
                     const std::shared_ptr<ILogging>& logging,
                     uint64_t mm);
 
         [[nodiscard]] std::unique_ptr<std::list<MemoryRegion>> extractAllMemoryRegions() const override;
 
+        // Walks the VMA lists of all extractors in lockstep and reads the current VMA of every list with a single
+        // batched read. The result has one entry per extractor, which is null if its VMA list could not be walked. All
+        // extractors have to share the same libvmi interface and kernel offsets.
+        [[nodiscard]] static std::vector<std::unique_ptr<std::list<MemoryRegion>>>
+        extractAllMemoryRegions(std::span<const MMExtractor* const> mmExtractors);
+
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::shared_ptr<const KernelOffsets> kernelOffsets;
         std::unique_ptr<ILogger> logger;
         PathExtractor pathExtractor;
         uint64_t mm;
+
+        void addMemoryRegion(std::list<MemoryRegion>& regions, const StructSnapshot& vmAreaStruct) const;
     };
 }
 
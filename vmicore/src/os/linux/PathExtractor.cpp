@@ -1,11 +1,11 @@
 #include "PathExtractor.h"
-#include "Constants.h"
 
 namespace Linux
 {
     PathExtractor::PathExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                                 std::shared_ptr<const KernelOffsets> kernelOffsets,
                                  const std::shared_ptr<ILogging>& logging)
-        : vmiInterface(std::move(vmiInterface)), logger(NEW_LOGGER(logging))
+        : vmiInterface(std::move(vmiInterface)), kernelOffsets(std::move(kernelOffsets)), logger(NEW_LOGGER(logging))
     {
     }
 
@@ -16,65 +16,78 @@ namespace Linux
             return {};
         }
 
-        const auto mnt = vmiInterface->read64VA(path + vmiInterface->getKernelStructOffset("path", "mnt"),
-                                                vmiInterface->convertPidToDtb(SYSTEM_PID));
-        const auto dentry = vmiInterface->read64VA(path + vmiInterface->getKernelStructOffset("path", "dentry"),
-                                                   vmiInterface->convertPidToDtb(SYSTEM_PID));
+        const auto mnt = vmiInterface->readKernel64(path + kernelOffsets->path.mnt);
+        const auto dentry = vmiInterface->readKernel64(path + kernelOffsets->path.dentry);
 
         if (dentry == 0 || mnt == 0)
         {
             return {};
         }
 
-        return createPath(dentry, mnt - vmiInterface->getKernelStructOffset("mount", "mnt"));
+        return createPath(dentry, mnt - kernelOffsets->mount.mnt);
     }
 
     std::string PathExtractor::createPath(uint64_t dentry, uint64_t mnt) const
     {
         std::string path;
-        try
+        // Every read depends on the previous ones having succeeded, so the first failure ends the extraction
+        const auto namePointer =
+            vmiInterface->tryReadKernel64(dentry + kernelOffsets->dentry.d_name + kernelOffsets->qstr.name);
+        if (!namePointer)
         {
-            const auto name = vmiInterface->extractStringAtVA(
-                vmiInterface->read64VA(dentry + vmiInterface->getKernelStructOffset("dentry", "d_name") +
-                                           vmiInterface->getKernelStructOffset("qstr", "name"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID)),
-                vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto parent =
-                vmiInterface->read64VA(dentry + vmiInterface->getKernelStructOffset("dentry", "d_parent"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto mntRoot = vmiInterface->read64VA(mnt + vmiInterface->getKernelStructOffset("mount", "mnt"),
-                                                        vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto mntMountpoint =
-                vmiInterface->read64VA(mnt + vmiInterface->getKernelStructOffset("mount", "mnt_mountpoint"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
-            const auto mntParent =
-                vmiInterface->read64VA(mnt + vmiInterface->getKernelStructOffset("mount", "mnt_parent"),
-                                       vmiInterface->convertPidToDtb(SYSTEM_PID));
+            return logUnreadablePathPart(dentry, mnt);
+        }
+        const auto name = vmiInterface->tryExtractStringAtVA(*namePointer, vmiInterface->getKernelDtb());
+        if (!name)
+        {
+            return logUnreadablePathPart(dentry, mnt);
+        }
+        const auto parent = vmiInterface->tryReadKernel64(dentry + kernelOffsets->dentry.d_parent);
+        if (!parent)
+        {
+            return logUnreadablePathPart(dentry, mnt);
+        }
+        const auto mntRoot = vmiInterface->tryReadKernel64(mnt + kernelOffsets->mount.mnt);
+        if (!mntRoot)
+        {
+            return logUnreadablePathPart(dentry, mnt);
+        }
+        const auto mntMountpoint = vmiInterface->tryReadKernel64(mnt + kernelOffsets->mount.mnt_mountpoint);
+        if (!mntMountpoint)
+        {
+            return logUnreadablePathPart(dentry, mnt);
+        }
+        const auto mntParent = vmiInterface->tryReadKernel64(mnt + kernelOffsets->mount.mnt_parent);
+        if (!mntParent)
+        {
+            return logUnreadablePathPart(dentry, mnt);
+        }
 
-            if (parent != dentry && dentry != mntRoot)
-            {
-                path.append(createPath(parent, mnt));
-            }
-            else if (mntParent != mnt)
-            {
-                path.append(createPath(mntMountpoint, mntParent));
-            }
+        if (*parent != dentry && dentry != *mntRoot)
+        {
+            path.append(createPath(*parent, mnt));
+        }
+        else if (*mntParent != mnt)
+        {
+            path.append(createPath(*mntMountpoint, *mntParent));
+        }
 
-            if ((parent == dentry && name->at(0) == '/') || dentry == mntRoot)
-            {
-                return path;
-            }
-            if (parent == dentry)
-            {
-                return path.append(*name);
-            }
-            return path.append(fmt::format("/{}", *name));
+        if ((*parent == dentry && name->starts_with('/')) || dentry == *mntRoot)
+        {
+            return path;
         }
-        catch (const std::exception& e)
+        if (*parent == dentry)
         {
-            logger->warning("Unable to extract part of a path.", {logfield::create("exception", e.what())});
+            return path.append(*name);
         }
+        return path.append(fmt::format("/{}", *name));
+    }
 
-        return path;
+    std::string PathExtractor::logUnreadablePathPart(uint64_t dentry, uint64_t mnt) const
+    {
+        logger->warning("Unable to extract part of a path.",
+                        {logfield::create("dentry", fmt::format("{:#x}", dentry)),
+                         logfield::create("mount", fmt::format("{:#x}", mnt))});
+        return {};
     }
 }
@@ -2,6 +2,7 @@
 #define VMICORE_LINUX_PATHEXTRACTION_H
 
 #include "../../vmi/LibvmiInterface.h"
+#include "KernelOffsets.h"
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -11,16 +12,21 @@ namespace Linux
     class PathExtractor
     {
       public:
-        explicit PathExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
-                               const std::shared_ptr<ILogging>& logging);
+        PathExtractor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                      std::shared_ptr<const KernelOffsets> kernelOffsets,
+                      const std::shared_ptr<ILogging>& logging);
 
         [[nodiscard]] std::string extractDPath(uint64_t path) const;
 
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
+        std::shared_ptr<const KernelOffsets> kernelOffsets;
         std::unique_ptr<ILogger> logger;
 
         [[nodiscard]] std::string createPath(uint64_t dentry, uint64_t mnt) const;
+
+        // Logs the failed extraction and returns an empty path part
+        [[nodiscard]] std::string logUnreadablePathPart(uint64_t dentry, uint64_t mnt) const;
     };
 }
 #endif // VMICORE_LINUX_PATHEXTRACTION_H
@@ -1,6 +1,5 @@
 #include "SystemEventSupervisor.h"
 #include "../../GlobalControl.h"
-#include "Constants.h"
 #include <config.h>
 #include <fmt/core.h>
 #include <utility>
@@ -27,6 +26,10 @@ namespace Linux
 
     void SystemEventSupervisor::initialize()
     {
+        if (configInterface->isPerVcpuEventProcessingEnabled())
+        {
+            eventWorkers = std::make_unique<VcpuEventWorkers>(vmiInterface->getNumberOfVCPUs());
+        }
         activeProcessesSupervisor->initialize();
         interruptFactory->initialize();
         startProcForkConnectorMonitoring();
@@ -43,7 +46,7 @@ namespace Linux
             weak_from_this(), &SystemEventSupervisor::procForkConnectorCallback);
         procForkConnectorEvent = interruptFactory->createInterruptEvent("procForkConnectorEvent",
                                                                         procForkConnectorVA,
-                                                                        vmiInterface->convertPidToDtb(SYSTEM_PID),
+                                                                        vmiInterface->getKernelDtb(),
                                                                         procForkConnectorCallback);
     }
 
@@ -56,7 +59,7 @@ namespace Linux
             weak_from_this(), &SystemEventSupervisor::procExecConnectorCallback);
         procExecConnectorEvent = interruptFactory->createInterruptEvent("procExecConnectorEvent",
                                                                         procExecConnectorVA,
-                                                                        vmiInterface->convertPidToDtb(SYSTEM_PID),
+                                                                        vmiInterface->getKernelDtb(),
                                                                         procExecConnectorCallback);
     }
 
@@ -69,7 +72,7 @@ namespace Linux
             weak_from_this(), &SystemEventSupervisor::procExitConnectorCallback);
         procExitConnectorEvent = interruptFactory->createInterruptEvent("procExitConnectorEvent",
                                                                         procExitConnectorVA,
-                                                                        vmiInterface->convertPidToDtb(SYSTEM_PID),
+                                                                        vmiInterface->getKernelDtb(),
                                                                         procExitConnectorCallback);
     }
 
@@ -80,7 +83,7 @@ namespace Linux
 #elif defined(ARM64)
         uint64_t base = interruptEvent.getRegisters()->arm.regs[0];
 #endif
-        activeProcessesSupervisor->addNewProcess(base);
+        addNewProcess(base);
         return InterruptEvent::InterruptResponse::Continue;
     }
 
@@ -91,7 +94,12 @@ namespace Linux
 #elif defined(ARM64)
         uint64_t base = interruptEvent.getRegisters()->arm.regs[0];
 #endif
-        activeProcessesSupervisor->addNewProcess(base);
+        // The task may have been forked on another vCPU, so its fork has to be processed before the exec
+        if (eventWorkers)
+        {
+            eventWorkers->drain();
+        }
+        addNewProcess(base);
         return InterruptEvent::InterruptResponse::Continue;
     }
 
@@ -102,16 +110,59 @@ namespace Linux
 #elif defined(ARM64)
         uint64_t taskStructBase = interruptEvent.getRegisters()->arm.regs[0];
 #endif
+        // Plugins inspect the terminating process, so its start has to be processed completely
+        if (eventWorkers)
+        {
+            eventWorkers->drain();
+        }
 
-        pluginSystem->passProcessTerminationEventToRegisteredPlugins(
-            activeProcessesSupervisor->getProcessInformationByBase(taskStructBase));
+        auto processInformation = activeProcessesSupervisor->getProcessInformationByBase(taskStructBase);
+        pluginSystem->passProcessTerminationEventToRegisteredPlugins(processInformation);
         activeProcessesSupervisor->removeActiveProcess(taskStructBase);
+        passProcessTerminationEventToDeferredPlugins(processInformation);
 
         return InterruptEvent::InterruptResponse::Continue;
     }
 
+    void SystemEventSupervisor::addNewProcess(uint64_t taskStruct)
+    {
+        if (!eventWorkers)
+        {
+            activeProcessesSupervisor->addNewProcess(taskStruct);
+            return;
+        }
+        // Only identify the process while the vCPU waits. The task_struct stays valid until the exit event, which
+        // waits for the enrichment to finish.
+        activeProcessesSupervisor->registerNewProcess(taskStruct);
+        eventWorkers->dispatch(InterruptEvent::getVcpuId(),
+                               [activeProcessesSupervisor = activeProcessesSupervisor, taskStruct]()
+                               { activeProcessesSupervisor->enrichProcess(taskStruct); });
+    }
+
+    void SystemEventSupervisor::passProcessTerminationEventToDeferredPlugins(
+        const std::shared_ptr<const ActiveProcessInformation>& processInformation)
+    {
+        if (!eventWorkers)
+        {
+            pluginSystem->passProcessTerminationEventToDeferredPlugins(processInformation);
+            return;
+        }
+        eventWorkers->dispatch(InterruptEvent::getVcpuId(),
+                               [pluginSystem = pluginSystem, processInformation]()
+                               { pluginSystem->passProcessTerminationEventToDeferredPlugins(processInformation); });
+    }
+
+    void SystemEventSupervisor::finishPendingEvents()
+    {
+        if (eventWorkers)
+        {
+            eventWorkers->drain();
+        }
+    }
+
     void SystemEventSupervisor::teardown()
     {
+        finishPendingEvents();
         interruptFactory->teardown();
     }
 }
@@ -8,6 +8,7 @@
 #include "../../vmi/InterruptFactory.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "../../vmi/SingleStepSupervisor.h"
+#include "../../vmi/VcpuEventWorkers.h"
 #include "../IActiveProcessesSupervisor.h"
 #include "../ISystemEventSupervisor.h"
 #include <memory>
@@ -36,6 +37,8 @@ namespace Linux
 
         InterruptEvent::InterruptResponse procExitConnectorCallback(InterruptEvent& interruptEvent);
 
+        void finishPendingEvents() override;
+
         void teardown() override;
 
       private:
@@ -50,12 +53,20 @@ namespace Linux
         std::shared_ptr<ILogging> loggingLib;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<IEventStream> eventStream;
+        // Only present if per vCPU event processing is enabled. Declared last so that pending work finishes first.
+        std::unique_ptr<VcpuEventWorkers> eventWorkers;
 
         void startProcForkConnectorMonitoring();
 
+        void addNewProcess(uint64_t taskStruct);
+
         void startProcExecConnectorMonitoring();
 
         void startProcExitConnectorMonitoring();
+
+        // Runs on the event worker of the current vCPU if there is one, after the event response has been sent
+        void passProcessTerminationEventToDeferredPlugins(
+            const std::shared_ptr<const ActiveProcessInformation>& processInformation);
     };
 }
 
@@ -1,4 +1,5 @@
 #include "ActiveProcessesSupervisor.h"
+#include "../MemoryRegionBatch.h"
 #include "../PagingDefinitions.h"
 #include <fmt/core.h>
 #include <string>
@@ -8,6 +9,8 @@ namespace Windows
     namespace
     {
         constexpr uint64_t statusPending = 0x103;
+        // Bounds how long a process that has exited without its exit being hooked yet can still be reported as active
+        constexpr auto activeProcessesCacheValidity = std::chrono::milliseconds(100);
     }
 
     ActiveProcessesSupervisor::ActiveProcessesSupervisor(std::shared_ptr<ILibvmiInterface> vmiInterface,
@@ -34,48 +37,55 @@ namespace Windows
         do
         {
             addNewProcess(kernelAccess->getCurrentProcessEprocessBase(currentListEntry));
-            currentListEntry = vmiInterface->read64VA(currentListEntry, vmiInterface->convertPidToDtb(systemPid));
+            currentListEntry = vmiInterface->readKernel64(currentListEntry);
         } while (currentListEntry != psActiveProcessListHeadVA);
         logger->info("--- End of Initialization ---");
     }
 
-    std::unique_ptr<ActiveProcessInformation>
-    ActiveProcessesSupervisor::extractProcessInformation(uint64_t eprocessBase) const
+    std::shared_ptr<ActiveProcessInformation>
+    ActiveProcessesSupervisor::extractProcessInformation(uint64_t eprocessBase, bool resolveProcessPath) const
     {
-        auto processInformation = std::make_unique<ActiveProcessInformation>();
+        auto processInformation = std::make_shared<ActiveProcessInformation>();
         processInformation->base = eprocessBase;
         processInformation->processCR3 = kernelAccess->extractDirectoryTableBase(eprocessBase);
-        processInformation->pid = kernelAccess->extractPID(eprocessBase);
+        auto pid = processInformation->pid = kernelAccess->extractPID(eprocessBase);
         processInformation->parentPid = kernelAccess->extractParentID(eprocessBase);
-        processInformation->name = kernelAccess->extractImageFileName(eprocessBase);
-        try
+        auto name = processInformation->name = kernelAccess->extractImageFileName(eprocessBase);
+        if (resolveProcessPath)
         {
-            processInformation->processPath = extractProcessPath(eprocessBase);
-            processInformation->fullName = splitProcessFileNameFromPath(*processInformation->processPath);
+            // The path is only read once, no matter which of the two is accessed first
+            auto processPath = std::make_shared<LazyValue<std::string>>(
+                [kernelAccess = kernelAccess, loggingLib = loggingLib, eprocessBase, pid, name]()
+                { return extractProcessPathOrEmpty(*kernelAccess, loggingLib, eprocessBase, pid, name); });
+            processInformation->fullName = LazyValue<std::string>(
+                [processPath]() { return splitProcessFileNameFromPathOrEmpty(**processPath); });
+            processInformation->processPath =
+                LazyValue<std::string>([processPath]() { return std::make_unique<std::string>(**processPath); });
         }
-        catch (const std::exception& e)
+        else
         {
+            // Plugins compare the file name against their configuration, so the image name stands in for it
+            processInformation->fullName = std::make_unique<std::string>(name);
             processInformation->processPath = std::make_unique<std::string>();
-            processInformation->fullName = std::make_unique<std::string>();
-            logger->warning("Process",
-                            {logfield::create("ProcessName", processInformation->name),
-                             logfield::create("ProcessId", static_cast<uint64_t>(processInformation->pid)),
-                             logfield::create("Exception", e.what())});
         }
-        processInformation->memoryRegionExtractor = std::make_unique<VadTreeWin10>(
-            kernelAccess, eprocessBase, processInformation->pid, processInformation->name, loggingLib);
+        processInformation->memoryRegionExtractor = LazyValue<IMemoryRegionExtractor>(
+            [vmiInterface = vmiInterface,
+             kernelAccess = kernelAccess,
+             loggingLib = loggingLib,
+             eprocessBase,
+             pid,
+             name]()
+            {
+                return std::make_unique<VadTreeWin10>(vmiInterface, kernelAccess, eprocessBase, pid, name, loggingLib);
+            });
 
         return processInformation;
     }
 
     std::shared_ptr<ActiveProcessInformation> ActiveProcessesSupervisor::getProcessInformationByPid(pid_t pid) const
     {
-        std::shared_ptr<ActiveProcessInformation> processInformation;
-        try
-        {
-            processInformation = processInformationByPid.at(pid);
-        }
-        catch (const std::out_of_range&)
+        auto processInformation = processTable.getSnapshot()->findByPid(pid);
+        if (!processInformation)
         {
             throw std::invalid_argument("Unable to find process with pid " + std::to_string(pid));
         }
@@ -85,53 +95,92 @@ namespace Windows
     std::shared_ptr<ActiveProcessInformation>
     ActiveProcessesSupervisor::getProcessInformationByBase(uint64_t eprocessBase) const
     {
-        const auto pidIterator = pidsByEprocessBase.find(eprocessBase);
-        if (pidIterator == pidsByEprocessBase.cend())
+        auto processInformation = processTable.getSnapshot()->findByBase(eprocessBase);
+        if (!processInformation)
         {
             throw std::invalid_argument(
                 fmt::format("{}: Process with _EPROCESS base {:#x} not in process cache.", __func__, eprocessBase));
         }
-        return getProcessInformationByPid(pidIterator->second);
+        return processInformation;
     }
 
     void ActiveProcessesSupervisor::addNewProcess(uint64_t eprocessBase)
     {
-        std::shared_ptr<ActiveProcessInformation> processInformation(extractProcessInformation(eprocessBase));
+        auto processInformation = extractProcessInformation(eprocessBase, true);
+        storeProcess(processInformation);
+        announceProcess(*processInformation);
+    }
+
+    void ActiveProcessesSupervisor::registerNewProcess(uint64_t eprocessBase)
+    {
+        auto processInformation = extractProcessInformation(eprocessBase, false);
+        processInformation->enrichmentPending = true;
+        storeProcess(processInformation);
+        logger->debug("Registered process pending enrichment",
+                      {logfield::create("ProcessName", processInformation->name),
+                       logfield::create("ProcessId", static_cast<uint64_t>(processInformation->pid))});
+    }
+
+    void ActiveProcessesSupervisor::enrichProcess(uint64_t eprocessBase)
+    {
+        try
+        {
+            if (!getProcessInformationByBase(eprocessBase)->enrichmentPending)
+            {
+                return;
+            }
+        }
+        catch (const std::invalid_argument& e)
+        {
+            logger->warning("Unable to enrich process", {logfield::create("exception", e.what())});
+            return;
+        }
+
+        // Published process information is never modified, so the enriched information replaces it
+        auto processInformation = extractProcessInformation(eprocessBase, true);
+        storeProcess(processInformation);
+        announceProcess(*processInformation);
+    }
+
+    void ActiveProcessesSupervisor::storeProcess(const std::shared_ptr<ActiveProcessInformation>& processInformation)
+    {
+        processTable.insert(processInformation);
+    }
+
+    void ActiveProcessesSupervisor::announceProcess(const ActiveProcessInformation& processInformation) const
+    {
         std::string parentPid("unknownParentPid");
         std::string parentName("unknownParentName");
         std::string parentCr3("unknownParentCr3");
-        auto parentProcessInformation = processInformationByPid.find(processInformation->parentPid);
-        if (parentProcessInformation != processInformationByPid.end())
+        if (auto parentProcessInformation = processTable.getSnapshot()->findByPid(processInformation.parentPid))
         {
-            parentPid = std::to_string(parentProcessInformation->second->pid);
-            parentName = parentProcessInformation->second->name;
-            parentCr3 = fmt::format("{:#x}", parentProcessInformation->second->processCR3);
+            parentPid = std::to_string(parentProcessInformation->pid);
+            parentName = parentProcessInformation->name;
+            parentCr3 = fmt::format("{:#x}", parentProcessInformation->processCR3);
         }
         eventStream->sendProcessEvent(::grpc::ProcessState::Started,
-                                      processInformation->name,
-                                      static_cast<uint32_t>(processInformation->pid),
-                                      fmt::format("{:#x}", processInformation->processCR3));
+                                      processInformation.name,
+                                      static_cast<uint32_t>(processInformation.pid),
+                                      fmt::format("{:#x}", processInformation.processCR3));
         logger->info("Discovered active process",
-                     {logfield::create("ProcessName", processInformation->name),
-                      logfield::create("ProcessId", static_cast<uint64_t>(processInformation->pid)),
-                      logfield::create("ProcessCr3", fmt::format("{:#x}", processInformation->processCR3)),
+                     {logfield::create("ProcessName", processInformation.name),
+                      logfield::create("ProcessId", static_cast<uint64_t>(processInformation.pid)),
+                      logfield::create("ProcessCr3", fmt::format("{:#x}", processInformation.processCR3)),
                       logfield::create("ParentProcessName", parentName),
                       logfield::create("ParentProcessId", parentPid),
                       logfield::create("ParentProcessCr3", parentCr3)});
-        processInformationByPid[processInformation->pid] = processInformation;
-        pidsByEprocessBase[processInformation->base] = processInformation->pid;
     }
 
-    bool ActiveProcessesSupervisor::isProcessActive(uint64_t eprocessBase) const
+    bool ActiveProcessesSupervisor::isProcessActive(const ActiveProcessInformation& processInformation,
+                                                    uint32_t exitStatus) const
     {
-        auto exitStatus = kernelAccess->extractExitStatus(eprocessBase);
         if (exitStatus == statusPending)
         {
             return true;
         }
         logger->debug("Encountered a process that has got an exit status other than 'status pending'",
-                      {logfield::create("_EPROCESS_base", fmt::format("{:#x}", eprocessBase)),
-                       logfield::create("ProcessId", static_cast<uint64_t>(kernelAccess->extractPID(eprocessBase))),
+                      {logfield::create("_EPROCESS_base", fmt::format("{:#x}", processInformation.base)),
+                       logfield::create("ProcessId", static_cast<uint64_t>(processInformation.pid)),
                        logfield::create("ExitStatus", static_cast<uint64_t>(exitStatus))
 
                       });
@@ -140,87 +189,142 @@ namespace Windows
 
     void ActiveProcessesSupervisor::removeActiveProcess(uint64_t eprocessBase)
     {
-        auto eprocessBaseIterator = pidsByEprocessBase.find(eprocessBase);
-        if (eprocessBaseIterator != pidsByEprocessBase.end())
-        {
-            auto processInformationIterator = processInformationByPid.find(eprocessBaseIterator->second);
-            if (processInformationIterator == processInformationByPid.end())
-            {
-                logger->warning("Process information not found for process",
-                                {logfield::create("_EPROCESS_base", fmt::format("{:#x}", eprocessBase)),
-                                 logfield::create("ProcessId", static_cast<uint64_t>(eprocessBaseIterator->second))
-
-                                });
-            }
-            else
-            {
-                std::string parentPid("unknownParentPid");
-                std::string parentName("unknownParentName");
-                std::string parentCr3("unknownParentCr3");
-                auto parentProcessInformation =
-                    processInformationByPid.find(processInformationIterator->second->parentPid);
-                if (parentProcessInformation != processInformationByPid.end())
-                {
-                    parentPid = std::to_string(parentProcessInformation->second->pid);
-                    parentName = parentProcessInformation->second->name;
-                    parentCr3 = fmt::format("{:#x}", parentProcessInformation->second->processCR3);
-                }
-
-                eventStream->sendProcessEvent(::grpc::ProcessState::Terminated,
-                                              processInformationIterator->second->name,
-                                              static_cast<uint32_t>(processInformationIterator->second->pid),
-                                              fmt::format("{:#x}", processInformationIterator->second->processCR3));
-                logger->info(
-                    "Remove process from actives processes",
-                    {logfield::create("ProcessName", processInformationIterator->second->name),
-                     logfield::create("ProcessId", static_cast<uint64_t>(processInformationIterator->second->pid)),
-                     logfield::create("ProcessCr3",
-                                      fmt::format("{:#x}", processInformationIterator->second->processCR3)),
-                     logfield::create("ParentProcessName", parentName),
-                     logfield::create("ParentProcessId", parentPid),
-                     logfield::create("ParentProcessCr3", parentCr3)});
-
-                processInformationByPid.erase(processInformationIterator);
-            }
-            pidsByEprocessBase.erase(eprocessBaseIterator);
-        }
-        else
+        auto removedProcess = processTable.remove(eprocessBase);
+        if (!removedProcess)
         {
             logger->warning("Process does not seem to be stored as an active process",
                             {logfield::create("_EPROCESS_base", fmt::format("{:#x}", eprocessBase))});
+            return;
+        }
+        // The _EPROCESS may be freed once the termination has been processed, but the process information can still be
+        // held by plugins
+        (void)removedProcess->processPath.get();
+        (void)removedProcess->fullName.get();
+
+        std::string parentPid("unknownParentPid");
+        std::string parentName("unknownParentName");
+        std::string parentCr3("unknownParentCr3");
+        if (auto parentProcessInformation = processTable.getSnapshot()->findByPid(removedProcess->parentPid))
+        {
+            parentPid = std::to_string(parentProcessInformation->pid);
+            parentName = parentProcessInformation->name;
+            parentCr3 = fmt::format("{:#x}", parentProcessInformation->processCR3);
         }
+
+        eventStream->sendProcessEvent(::grpc::ProcessState::Terminated,
+                                      removedProcess->name,
+                                      static_cast<uint32_t>(removedProcess->pid),
+                                      fmt::format("{:#x}", removedProcess->processCR3));
+        logger->info("Remove process from actives processes",
+                     {logfield::create("ProcessName", removedProcess->name),
+                      logfield::create("ProcessId", static_cast<uint64_t>(removedProcess->pid)),
+                      logfield::create("ProcessCr3", fmt::format("{:#x}", removedProcess->processCR3)),
+                      logfield::create("ParentProcessName", parentName),
+                      logfield::create("ParentProcessId", parentPid),
+                      logfield::create("ParentProcessCr3", parentCr3)});
     }
 
     std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
     ActiveProcessesSupervisor::getActiveProcesses() const
     {
+        auto snapshot = processTable.getSnapshot();
+        auto now = std::chrono::steady_clock::now();
+        {
+            // Process starts and exits hooked by the system event supervisor change the version and thereby
+            // invalidate the cache
+            std::scoped_lock lock(activeProcessesCacheLock);
+            if (activeProcessesCacheVersion == snapshot->version &&
+                now - activeProcessesCacheTime < activeProcessesCacheValidity)
+            {
+                return std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>(
+                    activeProcessesCache);
+            }
+        }
+
+        std::vector<addr_t> eprocessBases;
+        eprocessBases.reserve(snapshot->processInformationByPid.size());
+        for (const auto& [pid, processInformation] : snapshot->processInformationByPid)
+        {
+            eprocessBases.push_back(processInformation->base);
+        }
+        auto exitStatuses =
+            eprocessBases.empty() ? std::vector<uint32_t>{} : kernelAccess->extractExitStatuses(eprocessBases);
+
         auto runningProcesses = std::make_unique<std::vector<std::shared_ptr<const ActiveProcessInformation>>>();
-        for (const auto& element : processInformationByPid)
+        auto exitStatus = exitStatuses.cbegin();
+        for (const auto& [pid, processInformation] : snapshot->processInformationByPid)
         {
-            if (isProcessActive(element.second->base))
+            if (isProcessActive(*processInformation, *exitStatus++))
             {
-                runningProcesses->push_back(element.second);
+                runningProcesses->push_back(processInformation);
             }
         }
+
+        std::scoped_lock lock(activeProcessesCacheLock);
+        activeProcessesCacheVersion = snapshot->version;
+        activeProcessesCacheTime = now;
+        activeProcessesCache = *runningProcesses;
         return runningProcesses;
     }
 
-    std::unique_ptr<std::string> ActiveProcessesSupervisor::extractProcessPath(uint64_t eprocessBase) const
+    std::vector<std::unique_ptr<std::list<MemoryRegion>>> ActiveProcessesSupervisor::extractAllMemoryRegions(
+        const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes) const
+    {
+        return extractMemoryRegionsBatched<VadTreeWin10>(processes, *logger);
+    }
+
+    std::unique_ptr<std::string> ActiveProcessesSupervisor::extractProcessPath(const IKernelAccess& kernelAccess,
+                                                                              uint64_t eprocessBase)
     {
-        auto sectionAddress = kernelAccess->extractSectionAddress(eprocessBase);
-        auto controlAreaAddress = kernelAccess->extractControlAreaAddress(sectionAddress);
-        auto fileFlag = kernelAccess->extractIsFile(controlAreaAddress);
+        auto sectionAddress = kernelAccess.extractSectionAddress(eprocessBase);
+        auto controlAreaAddress = kernelAccess.extractControlAreaAddress(sectionAddress);
+        auto fileFlag = kernelAccess.extractIsFile(controlAreaAddress);
         if (!fileFlag)
         {
             throw VmiException(fmt::format("{}: File flag in mmSectionFlags not set", __func__));
         }
-        auto controlAreaFilePointer = kernelAccess->extractControlAreaFilePointer(controlAreaAddress);
+        auto controlAreaFilePointer = kernelAccess.extractControlAreaFilePointer(controlAreaAddress);
         auto filePointerAddress = KernelAccess::removeReferenceCountFromExFastRef(controlAreaFilePointer);
-        auto processPath = kernelAccess->extractProcessPath(filePointerAddress);
+        auto processPath = kernelAccess.extractProcessPath(filePointerAddress);
 
         return processPath;
     }
 
+    std::unique_ptr<std::string>
+    ActiveProcessesSupervisor::extractProcessPathOrEmpty(const IKernelAccess& kernelAccess,
+                                                         const std::shared_ptr<ILogging>& loggingLib,
+                                                         uint64_t eprocessBase,
+                                                         pid_t pid,
+                                                         const std::string& name)
+    {
+        try
+        {
+            return extractProcessPath(kernelAccess, eprocessBase);
+        }
+        catch (const std::exception& e)
+        {
+            NEW_LOGGER(loggingLib)
+                ->warning("Process",
+                          {logfield::create("ProcessName", name),
+                           logfield::create("ProcessId", static_cast<uint64_t>(pid)),
+                           logfield::create("Exception", e.what())});
+            return std::make_unique<std::string>();
+        }
+    }
+
+    std::unique_ptr<std::string>
+    ActiveProcessesSupervisor::splitProcessFileNameFromPathOrEmpty(const std::string& path)
+    {
+        try
+        {
+            return splitProcessFileNameFromPath(path);
+        }
+        catch (const std::exception&)
+        {
+            return std::make_unique<std::string>();
+        }
+    }
+
     std::unique_ptr<std::string> ActiveProcessesSupervisor::splitProcessFileNameFromPath(const std::string& path)
     {
         auto substringStartIterator =
@@ -6,10 +6,13 @@
 #include "../../io/ILogging.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "../IActiveProcessesSupervisor.h"
+#include "../ProcessTable.h"
 #include "Constants.h"
 #include "VadTreeWin10.h"
-#include <map>
+#include <chrono>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 namespace Windows
 {
@@ -30,25 +33,55 @@ namespace Windows
 
         void addNewProcess(uint64_t eprocessBase) override;
 
+        void registerNewProcess(uint64_t eprocessBase) override;
+
+        void enrichProcess(uint64_t eprocessBase) override;
+
         void removeActiveProcess(uint64_t eprocessBase) override;
 
         [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
         getActiveProcesses() const override;
 
+        [[nodiscard]] std::vector<std::unique_ptr<std::list<MemoryRegion>>> extractAllMemoryRegions(
+            const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes) const override;
+
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::shared_ptr<IKernelAccess> kernelAccess;
-        std::map<pid_t, std::shared_ptr<ActiveProcessInformation>> processInformationByPid;
-        std::map<uint64_t, pid_t> pidsByEprocessBase;
+        ProcessTable processTable;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<ILogging> loggingLib;
         std::shared_ptr<IEventStream> eventStream;
+        // Result of the last liveness check together with the process table version it was computed for
+        mutable std::mutex activeProcessesCacheLock;
+        mutable uint64_t activeProcessesCacheVersion = 0;
+        mutable std::chrono::steady_clock::time_point activeProcessesCacheTime;
+        mutable std::vector<std::shared_ptr<const ActiveProcessInformation>> activeProcessesCache;
+
+        [[nodiscard]] bool isProcessActive(const ActiveProcessInformation& processInformation,
+                                           uint32_t exitStatus) const;
+
+        // Without resolveProcessPath, the path stays empty and the image name stands in for the file name, which keeps
+        // the registration of a process short. Otherwise the path and the file name are read on first access.
+        [[nodiscard]] std::shared_ptr<ActiveProcessInformation> extractProcessInformation(uint64_t eprocessBase,
+                                                                                        bool resolveProcessPath) const;
+
+        void storeProcess(const std::shared_ptr<ActiveProcessInformation>& processInformation);
+
+        void announceProcess(const ActiveProcessInformation& processInformation) const;
 
-        [[nodiscard]] bool isProcessActive(uint64_t eprocessBase) const;
+        [[nodiscard]] static std::unique_ptr<std::string> extractProcessPath(const IKernelAccess& kernelAccess,
+                                                                             uint64_t eprocessBase);
 
-        [[nodiscard]] std::unique_ptr<ActiveProcessInformation> extractProcessInformation(uint64_t eprocessBase) const;
+        // Logs the failure and returns an empty path if the path cannot be extracted
+        [[nodiscard]] static std::unique_ptr<std::string>
+        extractProcessPathOrEmpty(const IKernelAccess& kernelAccess,
+                                  const std::shared_ptr<ILogging>& loggingLib,
+                                  uint64_t eprocessBase,
+                                  pid_t pid,
+                                  const std::string& name);
 
-        [[nodiscard]] std::unique_ptr<std::string> extractProcessPath(uint64_t eprocessBase) const;
+        [[nodiscard]] static std::unique_ptr<std::string> splitProcessFileNameFromPathOrEmpty(const std::string& path);
 
         [[nodiscard]] static std::unique_ptr<std::string> splitProcessFileNameFromPath(const std::string& path);
     };
@@ -1,7 +1,9 @@
 #include "KernelAccess.h"
 #include "../PagingDefinitions.h"
-#include "Constants.h"
+#include <algorithm>
+#include <array>
 #include <fmt/core.h>
+#include <iterator>
 
 namespace
 {
@@ -21,15 +23,13 @@ namespace Windows
 
     uint64_t KernelAccess::extractVadTreeRootAddress(uint64_t eprocessBase) const
     {
-        auto vadRoot = vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.VadRoot,
-                                              vmiInterface->convertPidToDtb(systemPid));
+        auto vadRoot = vmiInterface->readKernel64(eprocessBase + kernelOffsets.eprocess.VadRoot);
         return vadRoot;
     }
 
     uint64_t KernelAccess::extractImageFilePointer(uint64_t eprocessBase) const
     {
-        auto imageFilePointer = vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.ImageFilePointer,
-                                                       vmiInterface->convertPidToDtb(systemPid));
+        auto imageFilePointer = vmiInterface->readKernel64(eprocessBase + kernelOffsets.eprocess.ImageFilePointer);
         return imageFilePointer;
     }
 
@@ -37,17 +37,17 @@ namespace Windows
     {
         expectSaneKernelAddress(fileObjectBaseAddress, static_cast<const char*>(__func__));
         return vmiInterface->extractUnicodeStringAtVA(fileObjectBaseAddress + kernelOffsets.fileObject.FileName,
-                                                      vmiInterface->convertPidToDtb(systemPid));
+                                                      vmiInterface->getKernelDtb());
     }
 
-    addr_t KernelAccess::extractControlAreaBasePointer(addr_t vadEntryBaseVA) const
+    addr_t KernelAccess::extractControlAreaBasePointer(const StructSnapshot& mmVad) const
     {
-        expectSaneKernelAddress(vadEntryBaseVA, static_cast<const char*>(__func__));
-        auto subSectionBaseAddress = vmiInterface->read64VA(vadEntryBaseVA + kernelOffsets.mmVad.Subsection,
-                                                            vmiInterface->convertPidToDtb(systemPid));
-        auto controlAreaBaseAddress = vmiInterface->read64VA(
-            subSectionBaseAddress + kernelOffsets.subSection.ControlArea, vmiInterface->convertPidToDtb(systemPid));
-        return controlAreaBaseAddress;
+        return vmiInterface->readKernel64(extractSubsectionPointer(mmVad) + kernelOffsets.subSection.ControlArea);
+    }
+
+    addr_t KernelAccess::extractSubsectionPointer(const StructSnapshot& mmVad) const
+    {
+        return mmVad.read<addr_t>(kernelOffsets.mmVad.Subsection);
     }
 
     void KernelAccess::expectSaneKernelAddress(addr_t address, const char* caller)
@@ -61,9 +61,8 @@ namespace Windows
     addr_t KernelAccess::extractFilePointerObjectAddress(addr_t controlAreaBaseVA) const
     {
         expectSaneKernelAddress(controlAreaBaseVA, static_cast<const char*>(__func__));
-        auto filePointerObjectExFastRef = vmiInterface->read64VA(
-            controlAreaBaseVA + kernelOffsets.controlArea.FilePointer + kernelOffsets.exFastRef.Object,
-            vmiInterface->convertPidToDtb(systemPid));
+        auto filePointerObjectExFastRef = vmiInterface->readKernel64(
+            controlAreaBaseVA + kernelOffsets.controlArea.FilePointer + kernelOffsets.exFastRef.Object);
         auto filePointerObjectAddress = removeReferenceCountFromExFastRef(filePointerObjectExFastRef);
         return filePointerObjectAddress;
     }
@@ -73,27 +72,108 @@ namespace Windows
         return exFastRefValue & ~(exFastRefBits);
     }
 
-    std::tuple<addr_t, addr_t> KernelAccess::extractMmVadShortChildNodeAddresses(addr_t currentVadEntryBaseVA) const
+    StructSnapshot KernelAccess::extractMmVadSnapshot(addr_t vadEntryBaseVA) const
+    {
+        expectSaneKernelAddress(vadEntryBaseVA, static_cast<const char*>(__func__));
+        auto mmVad = tryExtractMmVadSnapshot(vadEntryBaseVA);
+        if (!mmVad)
+        {
+            throw VmiException(fmt::format("{}: Unable to read _MMVAD at VA {:#x}", __func__, vadEntryBaseVA));
+        }
+        return std::move(*mmVad);
+    }
+
+    std::optional<StructSnapshot> KernelAccess::tryExtractMmVadSnapshot(addr_t vadEntryBaseVA) const
+    {
+        if (vadEntryBaseVA < PagingDefinitions::kernelspaceLowerBoundary)
+        {
+            return std::nullopt;
+        }
+        if (auto mmVad = StructSnapshot::tryCreate(*vmiInterface, vadEntryBaseVA, kernelOffsets.mmVad.size))
+        {
+            return mmVad;
+        }
+        // Private allocations are only backed by an _MMVAD_SHORT which might be followed by unmapped memory
+        auto mmVadShort = StructSnapshot::tryCreate(
+            *vmiInterface, vadEntryBaseVA, kernelOffsets.mmVad.mmVadShortBaseAddress + kernelOffsets.mmVadShort.size);
+        if (!mmVadShort || !isPrivateMmVadShort(*mmVadShort))
+        {
+            return std::nullopt;
+        }
+        return mmVadShort;
+    }
+
+    std::vector<std::optional<StructSnapshot>>
+    KernelAccess::tryExtractMmVadSnapshots(std::span<const addr_t> vadEntryBaseVAs) const
     {
-        expectSaneKernelAddress(currentVadEntryBaseVA, static_cast<const char*>(__func__));
-        auto leftChildAddress = vmiInterface->read64VA(currentVadEntryBaseVA + getVadNodeLeftChildOffset(),
-                                                       vmiInterface->convertPidToDtb(systemPid));
-        auto rightChildAddress = vmiInterface->read64VA(currentVadEntryBaseVA + getVadNodeRightChildOffset(),
-                                                        vmiInterface->convertPidToDtb(systemPid));
-        return {leftChildAddress, rightChildAddress};
+        std::vector<addr_t> kernelVadEntryBaseVAs;
+        std::copy_if(vadEntryBaseVAs.begin(),
+                     vadEntryBaseVAs.end(),
+                     std::back_inserter(kernelVadEntryBaseVAs),
+                     [](addr_t vadEntryBaseVA)
+                     { return vadEntryBaseVA >= PagingDefinitions::kernelspaceLowerBoundary; });
+        auto mmVads = StructSnapshot::tryCreateBatch(*vmiInterface, kernelVadEntryBaseVAs, kernelOffsets.mmVad.size);
+
+        std::vector<addr_t> mmVadShortBaseVAs;
+        for (size_t i = 0; i < mmVads.size(); i++)
+        {
+            if (!mmVads[i])
+            {
+                mmVadShortBaseVAs.push_back(kernelVadEntryBaseVAs[i]);
+            }
+        }
+        // Private allocations are only backed by an _MMVAD_SHORT which might be followed by unmapped memory
+        auto mmVadShorts =
+            StructSnapshot::tryCreateBatch(*vmiInterface,
+                                           mmVadShortBaseVAs,
+                                           kernelOffsets.mmVad.mmVadShortBaseAddress + kernelOffsets.mmVadShort.size);
+
+        std::vector<std::optional<StructSnapshot>> snapshots;
+        snapshots.reserve(vadEntryBaseVAs.size());
+        auto mmVad = mmVads.begin();
+        auto mmVadShort = mmVadShorts.begin();
+        for (auto vadEntryBaseVA : vadEntryBaseVAs)
+        {
+            if (vadEntryBaseVA < PagingDefinitions::kernelspaceLowerBoundary)
+            {
+                snapshots.emplace_back(std::nullopt);
+            }
+            else if (*mmVad)
+            {
+                snapshots.push_back(std::move(*mmVad++));
+            }
+            else
+            {
+                if (*mmVadShort && !isPrivateMmVadShort(**mmVadShort))
+                {
+                    mmVadShort->reset();
+                }
+                snapshots.push_back(std::move(*mmVadShort++));
+                mmVad++;
+            }
+        }
+        return snapshots;
+    }
+
+    bool KernelAccess::isPrivateMmVadShort(const StructSnapshot& mmVad) const
+    {
+        // Shared and file backed VADs are full _MMVADs, so the subsection behind the _MMVAD_SHORT has to be readable
+        return extractMmVadShortValues(mmVad).isPrivateMemory;
+    }
+
+    std::tuple<addr_t, addr_t> KernelAccess::extractMmVadShortChildNodeAddresses(const StructSnapshot& mmVad) const
+    {
+        return {mmVad.read<addr_t>(getVadNodeLeftChildOffset()), mmVad.read<addr_t>(getVadNodeRightChildOffset())};
     }
 
     std::tuple<uint64_t, uint64_t> KernelAccess::extractMmVadShortVpns(addr_t currentVadShortBaseVA) const
     {
         expectSaneKernelAddress(currentVadShortBaseVA, static_cast<const char*>(__func__));
-        auto startingVpnHigh = vmiInterface->read8VA(currentVadShortBaseVA + kernelOffsets.mmVadShort.StartingVpnHigh,
-                                                     vmiInterface->convertPidToDtb(systemPid));
-        auto endingVpnHigh = vmiInterface->read8VA(currentVadShortBaseVA + kernelOffsets.mmVadShort.EndingVpnHigh,
-                                                   vmiInterface->convertPidToDtb(systemPid));
-        auto startingVpn = vmiInterface->read32VA(currentVadShortBaseVA + kernelOffsets.mmVadShort.StartingVpn,
-                                                  vmiInterface->convertPidToDtb(systemPid));
-        auto endingVpn = vmiInterface->read32VA(currentVadShortBaseVA + kernelOffsets.mmVadShort.EndingVpn,
-                                                vmiInterface->convertPidToDtb(systemPid));
+        auto startingVpnHigh =
+            vmiInterface->readKernel8(currentVadShortBaseVA + kernelOffsets.mmVadShort.StartingVpnHigh);
+        auto endingVpnHigh = vmiInterface->readKernel8(currentVadShortBaseVA + kernelOffsets.mmVadShort.EndingVpnHigh);
+        auto startingVpn = vmiInterface->readKernel32(currentVadShortBaseVA + kernelOffsets.mmVadShort.StartingVpn);
+        auto endingVpn = vmiInterface->readKernel32(currentVadShortBaseVA + kernelOffsets.mmVadShort.EndingVpn);
         // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
         uint64_t vadShortEndingVpn = (static_cast<uint64_t>(endingVpnHigh) << sizeof(endingVpn) * 8) + endingVpn;
         uint64_t vadShortStartingVpn =
@@ -103,6 +183,27 @@ namespace Windows
         return {vadShortStartingVpn, vadShortEndingVpn};
     }
 
+    MmVadShortValues KernelAccess::extractMmVadShortValues(const StructSnapshot& mmVad) const
+    {
+        auto vadShortOffset = kernelOffsets.mmVad.mmVadShortBaseAddress;
+        auto startingVpnHigh = mmVad.read<uint8_t>(vadShortOffset + kernelOffsets.mmVadShort.StartingVpnHigh);
+        auto endingVpnHigh = mmVad.read<uint8_t>(vadShortOffset + kernelOffsets.mmVadShort.EndingVpnHigh);
+        auto startingVpn = mmVad.read<uint32_t>(vadShortOffset + kernelOffsets.mmVadShort.StartingVpn);
+        auto endingVpn = mmVad.read<uint32_t>(vadShortOffset + kernelOffsets.mmVadShort.EndingVpn);
+        auto flags = mmVad.readUnsigned(vadShortOffset + kernelOffsets.mmVadShort.Flags, kernelOffsets.mmvadFlags.size);
+
+        // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+        return {(static_cast<uint64_t>(startingVpnHigh) << sizeof(startingVpn) * 8) + startingVpn,
+                (static_cast<uint64_t>(endingVpnHigh) << sizeof(endingVpn) * 8) + endingVpn,
+                // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+                static_cast<uint8_t>(getFlagValue(flags,
+                                                  kernelOffsets.mmvadFlags.protection.startBit,
+                                                  kernelOffsets.mmvadFlags.protection.endBit)),
+                static_cast<bool>(getFlagValue(flags,
+                                               kernelOffsets.mmvadFlags.privateMemory.startBit,
+                                               kernelOffsets.mmvadFlags.privateMemory.endBit))};
+    }
+
     addr_t KernelAccess::getVadShortBaseVA(addr_t vadEntryBaseVA) const
     {
         return vadEntryBaseVA + kernelOffsets.mmVad.mmVadShortBaseAddress;
@@ -115,60 +216,67 @@ namespace Windows
 
     addr_t KernelAccess::extractDirectoryTableBase(addr_t eprocessBase) const
     {
-        return vmiInterface->read64VA(eprocessBase + kernelOffsets.kprocess.DirectoryTableBase,
-                                      vmiInterface->convertPidToDtb(systemPid));
+        return vmiInterface->readKernel64(eprocessBase + kernelOffsets.kprocess.DirectoryTableBase);
     }
 
     pid_t KernelAccess::extractParentID(addr_t eprocessBase) const
     {
         return static_cast<pid_t>(
-            vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.InheritedFromUniqueProcessId,
-                                   vmiInterface->convertPidToDtb(systemPid)));
+            vmiInterface->readKernel64(eprocessBase + kernelOffsets.eprocess.InheritedFromUniqueProcessId));
     }
 
     std::string KernelAccess::extractImageFileName(addr_t eprocessBase) const
     {
         return *vmiInterface->extractStringAtVA(eprocessBase + kernelOffsets.eprocess.ImageFileName,
-                                                vmiInterface->convertPidToDtb(systemPid));
+                                                vmiInterface->getKernelDtb());
     }
 
     pid_t KernelAccess::extractPID(addr_t eprocessBase) const
     {
-        return static_cast<pid_t>(vmiInterface->read32VA(eprocessBase + kernelOffsets.eprocess.UniqueProcessId,
-                                                         vmiInterface->convertPidToDtb(systemPid)));
+        return static_cast<pid_t>(vmiInterface->readKernel32(eprocessBase + kernelOffsets.eprocess.UniqueProcessId));
     }
 
     uint32_t KernelAccess::extractExitStatus(addr_t eprocessBase) const
     {
-        return vmiInterface->read32VA(eprocessBase + kernelOffsets.eprocess.ExitStatus,
-                                      vmiInterface->convertPidToDtb(systemPid));
+        return vmiInterface->readKernel32(eprocessBase + kernelOffsets.eprocess.ExitStatus);
+    }
+
+    std::vector<uint32_t> KernelAccess::extractExitStatuses(std::span<const addr_t> eprocessBases) const
+    {
+        std::vector<uint32_t> exitStatuses(eprocessBases.size());
+        std::vector<ReadRequest> requests;
+        requests.reserve(eprocessBases.size());
+        for (size_t i = 0; i < eprocessBases.size(); i++)
+        {
+            requests.push_back(
+                ReadRequest::create(eprocessBases[i] + kernelOffsets.eprocess.ExitStatus, exitStatuses[i]));
+        }
+        vmiInterface->readBatchVAOrThrow(vmiInterface->getKernelDtb(), requests, static_cast<const char*>(__func__));
+        return exitStatuses;
     }
 
     addr_t KernelAccess::extractSectionAddress(addr_t eprocessBase) const
     {
-        return vmiInterface->read64VA(eprocessBase + kernelOffsets.eprocess.SectionObject,
-                                      vmiInterface->convertPidToDtb(systemPid));
+        return vmiInterface->readKernel64(eprocessBase + kernelOffsets.eprocess.SectionObject);
     }
 
     addr_t KernelAccess::extractControlAreaAddress(addr_t sectionAddress) const
     {
         expectSaneKernelAddress(sectionAddress, static_cast<const char*>(__func__));
-        return vmiInterface->read64VA(sectionAddress + kernelOffsets.section.controlArea,
-                                      vmiInterface->convertPidToDtb(systemPid));
+        return vmiInterface->readKernel64(sectionAddress + kernelOffsets.section.controlArea);
     }
 
     addr_t KernelAccess::extractControlAreaFilePointer(addr_t controlAreaAddress) const
     {
         expectSaneKernelAddress(controlAreaAddress, static_cast<const char*>(__func__));
-        return vmiInterface->read64VA(controlAreaAddress + kernelOffsets.controlArea.FilePointer,
-                                      vmiInterface->convertPidToDtb(systemPid));
+        return vmiInterface->readKernel64(controlAreaAddress + kernelOffsets.controlArea.FilePointer);
     }
 
     std::unique_ptr<std::string> KernelAccess::extractProcessPath(addr_t filePointerAddress) const
     {
         expectSaneKernelAddress(filePointerAddress, static_cast<const char*>(__func__));
         return vmiInterface->extractUnicodeStringAtVA(filePointerAddress + kernelOffsets.fileObject.FileName,
-                                                      vmiInterface->convertPidToDtb(systemPid));
+                                                      vmiInterface->getKernelDtb());
     }
 
     addr_t KernelAccess::getMmVadShortFlagsAddr(addr_t vadShortBaseVA) const
@@ -178,7 +286,7 @@ namespace Windows
 
     uint8_t KernelAccess::extractProtectionFlagValue(addr_t vadShortBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName);
+        auto flagsSize = kernelOffsets.mmvadFlags.size;
         // As of now, there are 32 Protectionvalues
         assert((kernelOffsets.mmvadFlags.protection.endBit - kernelOffsets.mmvadFlags.protection.startBit) < 6);
         return static_cast<uint8_t>(extractFlagValue(getMmVadShortFlagsAddr(vadShortBaseVA),
@@ -189,7 +297,7 @@ namespace Windows
 
     bool KernelAccess::extractIsPrivateMemory(addr_t vadShortBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName);
+        auto flagsSize = kernelOffsets.mmvadFlags.size;
         assert((kernelOffsets.mmvadFlags.privateMemory.endBit - kernelOffsets.mmvadFlags.privateMemory.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmVadShortFlagsAddr(vadShortBaseVA),
                                                   flagsSize,
@@ -204,7 +312,7 @@ namespace Windows
 
     bool KernelAccess::extractIsBeingDeleted(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.mmsectionFlags.size;
         assert((kernelOffsets.mmsectionFlags.beingDeleted.endBit -
                 kernelOffsets.mmsectionFlags.beingDeleted.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
@@ -215,7 +323,7 @@ namespace Windows
 
     bool KernelAccess::extractIsImage(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.mmsectionFlags.size;
         assert((kernelOffsets.mmsectionFlags.image.endBit - kernelOffsets.mmsectionFlags.image.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
                                                   flagsSize,
@@ -225,7 +333,7 @@ namespace Windows
 
     bool KernelAccess::extractIsFile(addr_t controlAreaBaseVA) const
     {
-        auto flagsSize = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName);
+        auto flagsSize = kernelOffsets.mmsectionFlags.size;
         assert((kernelOffsets.mmsectionFlags.file.endBit - kernelOffsets.mmsectionFlags.file.startBit) == 1);
         return static_cast<bool>(extractFlagValue(getMmSectionFlagsAddr(controlAreaBaseVA),
                                                   flagsSize,
@@ -233,6 +341,25 @@ namespace Windows
                                                   kernelOffsets.mmsectionFlags.file.endBit));
     }
 
+    MmSectionFlagsValues KernelAccess::extractMmSectionFlagsValues(addr_t controlAreaBaseVA) const
+    {
+        expectSaneKernelAddress(controlAreaBaseVA, static_cast<const char*>(__func__));
+        auto flagsSize = kernelOffsets.mmsectionFlags.size;
+        expectKnownFlagStructSize(flagsSize, KernelStructOffsets::mmsection_flags::structName);
+
+        uint64_t flags = 0;
+        std::array requests{ReadRequest{getMmSectionFlagsAddr(controlAreaBaseVA), flagsSize, &flags}};
+        vmiInterface->readBatchVAOrThrow(vmiInterface->getKernelDtb(), requests, static_cast<const char*>(__func__));
+
+        return {static_cast<bool>(getFlagValue(
+                    flags, kernelOffsets.mmsectionFlags.image.startBit, kernelOffsets.mmsectionFlags.image.endBit)),
+                static_cast<bool>(getFlagValue(
+                    flags, kernelOffsets.mmsectionFlags.file.startBit, kernelOffsets.mmsectionFlags.file.endBit)),
+                static_cast<bool>(getFlagValue(flags,
+                                               kernelOffsets.mmsectionFlags.beingDeleted.startBit,
+                                               kernelOffsets.mmsectionFlags.beingDeleted.endBit))};
+    }
+
     addr_t KernelAccess::getVadNodeRightChildOffset() const
     {
         return kernelOffsets.mmVad.mmVadShortBaseAddress + kernelOffsets.mmVadShort.VadNode +
@@ -252,10 +379,10 @@ namespace Windows
         switch (size)
         {
             case sizeof(uint32_t):
-                flagValue = vmiInterface->read32VA(flagBaseVA, vmiInterface->convertPidToDtb(systemPid));
+                flagValue = vmiInterface->readKernel32(flagBaseVA);
                 break;
             case sizeof(uint64_t):
-                flagValue = vmiInterface->read64VA(flagBaseVA, vmiInterface->convertPidToDtb(systemPid));
+                flagValue = vmiInterface->readKernel64(flagBaseVA);
                 break;
             default:
                 throw VmiException(fmt::format(
@@ -264,4 +391,12 @@ namespace Windows
 
         return getFlagValue(flagValue, startBit, endBit);
     }
+
+    void KernelAccess::expectKnownFlagStructSize(size_t size, const char* structName)
+    {
+        if (size != sizeof(uint32_t) && size != sizeof(uint64_t))
+        {
+            throw VmiException(fmt::format("{}: {} is unknown flag struct size", structName, size));
+        }
+    }
 }
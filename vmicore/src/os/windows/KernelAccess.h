@@ -2,11 +2,31 @@
 #define VMICORE_WINDOWS_KERNELACCESS_H
 
 #include "../../vmi/LibvmiInterface.h"
+#include "../StructSnapshot.h"
 #include "KernelOffsets.h"
 #include "ProtectionValues.h"
+#include <span>
+#include <vector>
 
 namespace Windows
 {
+    struct MmVadShortValues
+    {
+        uint64_t startingVpn;
+        uint64_t endingVpn;
+        uint8_t protection;
+        bool isPrivateMemory;
+    };
+
+    struct MmSectionFlagsValues
+    {
+        bool isImage;
+        bool isFile;
+        bool isBeingDeleted;
+
+        bool operator==(const MmSectionFlagsValues& rhs) const = default;
+    };
+
     class IKernelAccess
     {
       public:
@@ -20,16 +40,29 @@ namespace Windows
 
         [[nodiscard]] virtual std::unique_ptr<std::string> extractFileName(uint64_t fileObjectBaseAddress) const = 0;
 
-        [[nodiscard]] virtual addr_t extractControlAreaBasePointer(addr_t vadEntryBaseVA) const = 0;
+        [[nodiscard]] virtual addr_t extractControlAreaBasePointer(const StructSnapshot& mmVad) const = 0;
+
+        [[nodiscard]] virtual addr_t extractSubsectionPointer(const StructSnapshot& mmVad) const = 0;
 
         [[nodiscard]] virtual addr_t extractFilePointerObjectAddress(addr_t controlAreaBaseVA) const = 0;
 
+        [[nodiscard]] virtual StructSnapshot extractMmVadSnapshot(addr_t vadEntryBaseVA) const = 0;
+
+        // Only the _MMVAD_SHORT part is read of private VADs whose full _MMVAD is unreadable
+        [[nodiscard]] virtual std::optional<StructSnapshot> tryExtractMmVadSnapshot(addr_t vadEntryBaseVA) const = 0;
+
+        // Same as tryExtractMmVadSnapshot for many VAD nodes at once, in the order of vadEntryBaseVAs
+        [[nodiscard]] virtual std::vector<std::optional<StructSnapshot>>
+        tryExtractMmVadSnapshots(std::span<const addr_t> vadEntryBaseVAs) const = 0;
+
         [[nodiscard]] virtual std::tuple<addr_t, addr_t>
-        extractMmVadShortChildNodeAddresses(addr_t currentVadEntryBaseVA) const = 0;
+        extractMmVadShortChildNodeAddresses(const StructSnapshot& mmVad) const = 0;
 
         [[nodiscard]] virtual std::tuple<uint64_t, uint64_t>
         extractMmVadShortVpns(addr_t currentVadShortBaseVA) const = 0;
 
+        [[nodiscard]] virtual MmVadShortValues extractMmVadShortValues(const StructSnapshot& mmVad) const = 0;
+
         [[nodiscard]] virtual addr_t getVadShortBaseVA(addr_t vadEntryBaseVA) const = 0;
 
         [[nodiscard]] virtual addr_t getCurrentProcessEprocessBase(addr_t currentListEntry) const = 0;
@@ -44,6 +77,10 @@ namespace Windows
 
         [[nodiscard]] virtual uint32_t extractExitStatus(addr_t eprocessBase) const = 0;
 
+        // Reads the exit statuses of all processes at once, in the order of eprocessBases
+        [[nodiscard]] virtual std::vector<uint32_t>
+        extractExitStatuses(std::span<const addr_t> eprocessBases) const = 0;
+
         [[nodiscard]] virtual addr_t extractSectionAddress(addr_t eprocessBase) const = 0;
 
         [[nodiscard]] virtual addr_t extractControlAreaAddress(addr_t sectionAddress) const = 0;
@@ -66,6 +103,8 @@ namespace Windows
 
         [[nodiscard]] virtual bool extractIsFile(addr_t controlAreaBaseVA) const = 0;
 
+        [[nodiscard]] virtual MmSectionFlagsValues extractMmSectionFlagsValues(addr_t controlAreaBaseVA) const = 0;
+
       protected:
         IKernelAccess() = default;
     };
@@ -85,17 +124,28 @@ namespace Windows
 
         [[nodiscard]] std::unique_ptr<std::string> extractFileName(uint64_t fileObjectBaseAddress) const override;
 
-        [[nodiscard]] addr_t extractControlAreaBasePointer(addr_t vadEntryBaseVA) const override;
+        [[nodiscard]] addr_t extractControlAreaBasePointer(const StructSnapshot& mmVad) const override;
+
+        [[nodiscard]] addr_t extractSubsectionPointer(const StructSnapshot& mmVad) const override;
 
         [[nodiscard]] addr_t extractFilePointerObjectAddress(addr_t controlAreaBaseVA) const override;
 
         [[nodiscard]] static uint64_t removeReferenceCountFromExFastRef(uint64_t exFastRefValue);
 
+        [[nodiscard]] StructSnapshot extractMmVadSnapshot(addr_t vadEntryBaseVA) const override;
+
+        [[nodiscard]] std::optional<StructSnapshot> tryExtractMmVadSnapshot(addr_t vadEntryBaseVA) const override;
+
+        [[nodiscard]] std::vector<std::optional<StructSnapshot>>
+        tryExtractMmVadSnapshots(std::span<const addr_t> vadEntryBaseVAs) const override;
+
         [[nodiscard]] std::tuple<addr_t, addr_t>
-        extractMmVadShortChildNodeAddresses(addr_t currentVadEntryBaseVA) const override;
+        extractMmVadShortChildNodeAddresses(const StructSnapshot& mmVad) const override;
 
         [[nodiscard]] std::tuple<uint64_t, uint64_t> extractMmVadShortVpns(addr_t currentVadShortBaseVA) const override;
 
+        [[nodiscard]] MmVadShortValues extractMmVadShortValues(const StructSnapshot& mmVad) const override;
+
         [[nodiscard]] addr_t getVadShortBaseVA(addr_t vadEntryBaseVA) const override;
 
         [[nodiscard]] addr_t getCurrentProcessEprocessBase(addr_t currentListEntry) const override;
@@ -110,6 +160,8 @@ namespace Windows
 
         [[nodiscard]] uint32_t extractExitStatus(addr_t eprocessBase) const override;
 
+        [[nodiscard]] std::vector<uint32_t> extractExitStatuses(std::span<const addr_t> eprocessBases) const override;
+
         [[nodiscard]] addr_t extractSectionAddress(addr_t eprocessBase) const override;
 
         [[nodiscard]] addr_t extractControlAreaAddress(addr_t sectionAddress) const override;
@@ -132,6 +184,8 @@ namespace Windows
 
         [[nodiscard]] bool extractIsFile(addr_t controlAreaBaseVA) const override;
 
+        [[nodiscard]] MmSectionFlagsValues extractMmSectionFlagsValues(addr_t controlAreaBaseVA) const override;
+
       private:
         std::shared_ptr<ILibvmiInterface> vmiInterface;
         KernelOffsets kernelOffsets;
@@ -142,6 +196,11 @@ namespace Windows
 
         [[nodiscard]] uint64_t extractFlagValue(addr_t flagBaseVA, size_t size, size_t startBit, size_t endBit) const;
 
+        // Whether a snapshot of only the _MMVAD_SHORT part of a VAD node covers the whole node
+        [[nodiscard]] bool isPrivateMmVadShort(const StructSnapshot& mmVad) const;
+
+        static void expectKnownFlagStructSize(size_t size, const char* structName);
+
         template <typename T> T getFlagValue(T flags, size_t startBit, size_t endBit) const
         {
             size_t flagLength = endBit - startBit;
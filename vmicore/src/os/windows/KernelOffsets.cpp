@@ -28,9 +28,11 @@ KernelOffsets KernelOffsets::init(const std::shared_ptr<ILibvmiInterface>& vmiIn
                        .StartingVpnHigh = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "StartingVpnHigh"),
                        .EndingVpn = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "EndingVpn"),
                        .EndingVpnHigh = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "EndingVpnHigh"),
-                       .Flags = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "u")},
+                       .Flags = vmiInterface->getKernelStructOffset("_MMVAD_SHORT", "u"),
+                       .size = vmiInterface->getStructSizeFromJson("_MMVAD_SHORT")},
         .mmVad = {.mmVadShortBaseAddress = vmiInterface->getKernelStructOffset("_MMVAD", "Core"),
-                  .Subsection = vmiInterface->getKernelStructOffset("_MMVAD", "Subsection")},
+                  .Subsection = vmiInterface->getKernelStructOffset("_MMVAD", "Subsection"),
+                  .size = vmiInterface->getStructSizeFromJson("_MMVAD")},
         .subSection = {.ControlArea = vmiInterface->getKernelStructOffset("_SUBSECTION", "ControlArea")},
         .exFastRef = {.Object = vmiInterface->getKernelStructOffset("_EX_FAST_REF", "Object")},
         .rtlBalancedNode = {.Left = vmiInterface->getKernelStructOffset("_RTL_BALANCED_NODE", "Left"),
@@ -38,13 +40,16 @@ KernelOffsets KernelOffsets::init(const std::shared_ptr<ILibvmiInterface>& vmiIn
         .mmvadFlags = {.protection{vmiInterface->getBitfieldOffsetAndSizeFromJson(
                            KernelStructOffsets::mmvad_flags::structName, "Protection")},
                        .privateMemory{vmiInterface->getBitfieldOffsetAndSizeFromJson(
-                           KernelStructOffsets::mmvad_flags::structName, "PrivateMemory")}},
+                           KernelStructOffsets::mmvad_flags::structName, "PrivateMemory")},
+                       .size = vmiInterface->getStructSizeFromJson(KernelStructOffsets::mmvad_flags::structName)},
         .mmsectionFlags = {.beingDeleted{vmiInterface->getBitfieldOffsetAndSizeFromJson(
                                KernelStructOffsets::mmsection_flags::structName, "BeingDeleted")},
                            .image{vmiInterface->getBitfieldOffsetAndSizeFromJson(
                                KernelStructOffsets::mmsectionFlags::structName, "Image")},
                            .file{vmiInterface->getBitfieldOffsetAndSizeFromJson(
-                               KernelStructOffsets::mmsectionFlags::structName, "File")}}};
+                               KernelStructOffsets::mmsectionFlags::structName, "File")},
+                           .size = vmiInterface->getStructSizeFromJson(
+                               KernelStructOffsets::mmsection_flags::structName)}};
 
     return kernelOffsets;
 }
@@ -48,13 +48,15 @@ namespace KernelStructOffsets
         addr_t EndingVpn;
         addr_t EndingVpnHigh;
         addr_t Flags;
+        size_t size;
     } __attribute__((aligned(64)));
 
     using _mmvad = struct _mmvad
     {
         addr_t mmVadShortBaseAddress;
         addr_t Subsection;
-    } __attribute__((aligned(16)));
+        size_t size;
+    } __attribute__((aligned(32)));
 
     using _subsection = struct _subsection
     {
@@ -89,6 +91,7 @@ namespace KernelStructOffsets
         constexpr static const char* structName = "_MMVAD_FLAGS";
         _flag protection;
         _flag privateMemory;
+        size_t size;
     } __attribute__((aligned(128)));
 
     using mmsectionFlags = struct mmsection_flags
@@ -97,6 +100,7 @@ namespace KernelStructOffsets
         _flag beingDeleted;
         _flag image;
         _flag file;
+        size_t size;
     } __attribute__((aligned(128)));
 } // namespace KernelStructOffsets
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
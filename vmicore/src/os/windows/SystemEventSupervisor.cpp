@@ -27,6 +27,10 @@ namespace Windows
 
     void SystemEventSupervisor::initialize()
     {
+        if (configInterface->isPerVcpuEventProcessingEnabled())
+        {
+            eventWorkers = std::make_unique<VcpuEventWorkers>(vmiInterface->getNumberOfVCPUs());
+        }
         activeProcessesSupervisor->initialize();
         interruptFactory->initialize();
         startPspCallProcessNotifyRoutinesMonitoring();
@@ -44,7 +48,7 @@ namespace Windows
         notifyProcessInterruptEvent =
             interruptFactory->createInterruptEvent("PspCallProcessNotifyRoutinesInterruptEvent",
                                                    processNotifyFunctionVA,
-                                                   vmiInterface->convertPidToDtb(systemPid),
+                                                   vmiInterface->getKernelDtb(),
                                                    notifyProcessCallbackFunction);
     }
 
@@ -58,7 +62,7 @@ namespace Windows
 
         bugCheckInterruptEvent = interruptFactory->createInterruptEvent("KeBugCheckExInterruptEvent",
                                                                         bugCheckFunctionVA,
-                                                                        vmiInterface->convertPidToDtb(systemPid),
+                                                                        vmiInterface->getKernelDtb(),
                                                                         bugCheckCallbackFunction);
     }
 
@@ -75,17 +79,32 @@ namespace Windows
                       });
         if (isTerminationEvent)
         {
+            // Plugins inspect the terminating process, so its start has to be processed completely
+            if (eventWorkers)
+            {
+                eventWorkers->drain();
+            }
             try
             {
-                pluginSystem->passProcessTerminationEventToRegisteredPlugins(
-                    activeProcessesSupervisor->getProcessInformationByBase(eprocessBase));
+                auto processInformation = activeProcessesSupervisor->getProcessInformationByBase(eprocessBase);
+                pluginSystem->passProcessTerminationEventToRegisteredPlugins(processInformation);
                 activeProcessesSupervisor->removeActiveProcess(eprocessBase);
+                passProcessTerminationEventToDeferredPlugins(processInformation);
             }
             catch (const std::invalid_argument& e)
             {
                 logger->warning("InvalidArgumentException", {logfield::create("exception", e.what())});
             }
         }
+        else if (eventWorkers)
+        {
+            // Only identify the process while the vCPU waits. The _EPROCESS stays valid until the termination
+            // event, which waits for the enrichment to finish.
+            activeProcessesSupervisor->registerNewProcess(eprocessBase);
+            eventWorkers->dispatch(InterruptEvent::getVcpuId(),
+                                   [activeProcessesSupervisor = activeProcessesSupervisor, eprocessBase]()
+                                   { activeProcessesSupervisor->enrichProcess(eprocessBase); });
+        }
         else
         {
             activeProcessesSupervisor->addNewProcess(eprocessBase);
@@ -100,13 +119,36 @@ namespace Windows
         logger->warning("BSOD detected!", {logfield::create("BugCheckCode", fmt::format("{:#x}", bugCheckCode))});
         GlobalControl::endVmi = true;
         GlobalControl::postRunPluginAction = false;
+        finishPendingEvents();
         pluginSystem->passShutdownEventToRegisteredPlugins();
         // deactivate the interrupt event because we are terminating immediately (no single stepping)
         return InterruptEvent::InterruptResponse::Deactivate;
     }
 
+    void SystemEventSupervisor::passProcessTerminationEventToDeferredPlugins(
+        const std::shared_ptr<const ActiveProcessInformation>& processInformation)
+    {
+        if (!eventWorkers)
+        {
+            pluginSystem->passProcessTerminationEventToDeferredPlugins(processInformation);
+            return;
+        }
+        eventWorkers->dispatch(InterruptEvent::getVcpuId(),
+                               [pluginSystem = pluginSystem, processInformation]()
+                               { pluginSystem->passProcessTerminationEventToDeferredPlugins(processInformation); });
+    }
+
+    void SystemEventSupervisor::finishPendingEvents()
+    {
+        if (eventWorkers)
+        {
+            eventWorkers->drain();
+        }
+    }
+
     void SystemEventSupervisor::teardown()
     {
+        finishPendingEvents();
         interruptFactory->teardown();
     }
 }
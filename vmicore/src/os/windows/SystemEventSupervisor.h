@@ -7,6 +7,7 @@
 #include "../../vmi/InterruptFactory.h"
 #include "../../vmi/LibvmiInterface.h"
 #include "../../vmi/SingleStepSupervisor.h"
+#include "../../vmi/VcpuEventWorkers.h"
 #include "../ISystemEventSupervisor.h"
 #include "ActiveProcessesSupervisor.h"
 #include <memory>
@@ -33,6 +34,8 @@ namespace Windows
 
         InterruptEvent::InterruptResponse keBugCheckExCallback(InterruptEvent& interruptEvent);
 
+        void finishPendingEvents() override;
+
         void teardown() override;
 
       private:
@@ -46,10 +49,16 @@ namespace Windows
         std::shared_ptr<ILogging> loggingLib;
         std::unique_ptr<ILogger> logger;
         std::shared_ptr<IEventStream> eventStream;
+        // Only present if per vCPU event processing is enabled. Declared last so that pending work finishes first.
+        std::unique_ptr<VcpuEventWorkers> eventWorkers;
 
         void startPspCallProcessNotifyRoutinesMonitoring();
 
         void startKeBugCheckExMonitoring();
+
+        // Runs on the event worker of the current vCPU if there is one, after the event response has been sent
+        void passProcessTerminationEventToDeferredPlugins(
+            const std::shared_ptr<const ActiveProcessInformation>& processInformation);
     };
 }
 
@@ -1,17 +1,21 @@
 #include "VadTreeWin10.h"
 #include "../PageProtection.h"
 #include "../PagingDefinitions.h"
+#include "../../vmi/VmiException.h"
+#include <array>
 #include <fmt/core.h>
-#include <unordered_set>
+#include <optional>
 
 namespace Windows
 {
-    VadTreeWin10::VadTreeWin10(std::shared_ptr<IKernelAccess> kernelAccess,
+    VadTreeWin10::VadTreeWin10(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                               std::shared_ptr<IKernelAccess> kernelAccess,
                                uint64_t eprocessBase,
                                pid_t pid,
                                std::string processName,
                                const std::shared_ptr<ILogging>& loggingLib)
-        : kernelAccess(std::move(kernelAccess)),
+        : vmiInterface(std::move(vmiInterface)),
+          kernelAccess(std::move(kernelAccess)),
           eprocessBase(eprocessBase),
           pid(pid),
           processName(std::move(processName)),
@@ -21,81 +25,209 @@ namespace Windows
 
     std::unique_ptr<std::list<MemoryRegion>> VadTreeWin10::extractAllMemoryRegions() const
     {
-        auto regions = std::make_unique<std::list<MemoryRegion>>();
-        std::list<uint64_t> nextVadEntries;
-        std::unordered_set<uint64_t> visitedVadVAs;
-        auto nodeAddress = kernelAccess->extractVadTreeRootAddress(eprocessBase);
-        nextVadEntries.push_back(nodeAddress);
-        while (!nextVadEntries.empty())
+        std::array vadTrees{this};
+        auto regions = std::move(extractAllMemoryRegions(vadTrees).front());
+        if (!regions)
         {
-            auto currentVadEntryBaseVA = nextVadEntries.back();
-            nextVadEntries.pop_back();
-
-            auto insertionResult = visitedVadVAs.insert(currentVadEntryBaseVA);
-            if (!insertionResult.second)
-            {
-                logger->warning("Cycle detected! Vad entry already visited",
-                                {logfield::create("VadEntryBaseVA", fmt::format("{:#x}", currentVadEntryBaseVA))});
-                continue;
-            }
+            throw VmiException(fmt::format("{}: Unable to walk VAD tree of process {}", __func__, pid));
+        }
+        return regions;
+    }
 
-            addr_t leftChildAddress = 0;
-            addr_t rightChildAddress = 0;
+    std::vector<std::unique_ptr<std::list<MemoryRegion>>>
+    VadTreeWin10::extractAllMemoryRegions(std::span<const VadTreeWin10* const> vadTrees)
+    {
+        std::vector<std::unique_ptr<std::list<MemoryRegion>>> regions(vadTrees.size());
+        if (vadTrees.empty())
+        {
+            return regions;
+        }
+#ifdef TRACE_MODE
+        auto libvmiCallsAtStart = vadTrees.front()->vmiInterface->getNumberOfLibvmiCalls();
+        uint64_t numberOfLevels = 0;
+#endif
+        // Pairs of the index of the VAD tree and the address of a node on the current level
+        std::vector<std::pair<size_t, addr_t>> currentLevel;
+        std::vector<std::optional<VadTreeWalk>> walks(vadTrees.size());
+        for (size_t i = 0; i < vadTrees.size(); i++)
+        {
             try
             {
-                std::tie(leftChildAddress, rightChildAddress) =
-                    kernelAccess->extractMmVadShortChildNodeAddresses(currentVadEntryBaseVA);
+                walks[i] = vadTrees[i]->startWalk();
+                currentLevel.emplace_back(i, walks[i]->rootAddress);
             }
             catch (const std::exception& e)
             {
-                logger->warning("Unable to extract process",
-                                {logfield::create("ProcessName", processName),
-                                 logfield::create("ProcessId", static_cast<int64_t>(pid)),
-                                 logfield::create("_MMVAD_SHORT", fmt::format("{:#x}", currentVadEntryBaseVA)),
-                                 logfield::create("exception", e.what())});
-                continue;
+                vadTrees[i]->logger->warning("Unable to walk VAD tree of process",
+                                             {logfield::create("ProcessName", vadTrees[i]->processName),
+                                              logfield::create("ProcessId", static_cast<int64_t>(vadTrees[i]->pid)),
+                                              logfield::create("exception", e.what())});
             }
-            if (leftChildAddress != 0)
+        }
+
+        while (!currentLevel.empty())
+        {
+            std::vector<std::pair<size_t, addr_t>> levelNodes;
+            std::vector<addr_t> levelNodeAddresses;
+            for (const auto& [treeIndex, vadEntryBaseVA] : currentLevel)
             {
-                nextVadEntries.push_back(leftChildAddress);
+                if (!walks[treeIndex]->visitedVadVAs.insert(vadEntryBaseVA).second)
+                {
+                    vadTrees[treeIndex]->logger->warning(
+                        "Cycle detected! Vad entry already visited",
+                        {logfield::create("VadEntryBaseVA", fmt::format("{:#x}", vadEntryBaseVA))});
+                    continue;
+                }
+                levelNodes.emplace_back(treeIndex, vadEntryBaseVA);
+                levelNodeAddresses.push_back(vadEntryBaseVA);
             }
-            if (rightChildAddress != 0)
+
+            // Unreadable VAD nodes are common for processes being torn down, so this path avoids exceptions
+            auto mmVads = vadTrees.front()->kernelAccess->tryExtractMmVadSnapshots(levelNodeAddresses);
+            std::vector<std::pair<size_t, addr_t>> nextLevel;
+            for (size_t i = 0; i < levelNodes.size(); i++)
             {
-                nextVadEntries.push_back(rightChildAddress);
+                const auto& [treeIndex, vadEntryBaseVA] = levelNodes[i];
+                const auto* vadTree = vadTrees[treeIndex];
+                if (!mmVads[i])
+                {
+                    vadTree->logger->warning("Unable to extract process",
+                                             {logfield::create("ProcessName", vadTree->processName),
+                                              logfield::create("ProcessId", static_cast<int64_t>(vadTree->pid)),
+                                              logfield::create("_MMVAD_SHORT", fmt::format("{:#x}", vadEntryBaseVA))});
+                    continue;
+                }
+                // The snapshot always covers the _MMVAD_SHORT so reading the child node pointers cannot fail
+                auto [leftChildAddress, rightChildAddress] =
+                    vadTree->kernelAccess->extractMmVadShortChildNodeAddresses(*mmVads[i]);
+                if (leftChildAddress != 0)
+                {
+                    nextLevel.emplace_back(treeIndex, leftChildAddress);
+                }
+                if (rightChildAddress != 0)
+                {
+                    nextLevel.emplace_back(treeIndex, rightChildAddress);
+                }
+
+                vadTree->visitVad(*walks[treeIndex], *mmVads[i]);
             }
+            currentLevel = std::move(nextLevel);
+#ifdef TRACE_MODE
+            numberOfLevels++;
+#endif
+        }
 
-            try
+        for (size_t i = 0; i < vadTrees.size(); i++)
+        {
+            if (walks[i])
             {
-                const auto currentVad = createVadt(currentVadEntryBaseVA);
-
-                const auto startAddress = currentVad->startingVPN << PagingDefinitions::numberOfPageIndexBits;
-                const auto endAddress = ((currentVad->endingVPN + 1) << PagingDefinitions::numberOfPageIndexBits) - 1;
-                const auto size = endAddress - startAddress + 1;
-                logger->debug("Vadt element",
-                              {logfield::create("startingVPN", fmt::format("{:#x}", currentVad->startingVPN)),
-                               logfield::create("endingVPN", fmt::format("{:#x}", currentVad->endingVPN)),
-                               logfield::create("startAddress", fmt::format("{:#x}", startAddress)),
-                               logfield::create("endAddress", fmt::format("{:#x}", endAddress)),
-                               logfield::create("size", static_cast<uint64_t>(size))});
-                regions->emplace_back(startAddress,
-                                      size,
-                                      currentVad->fileName,
-                                      std::make_unique<PageProtection>(static_cast<uint32_t>(currentVad->protection),
-                                                                       OperatingSystem::WINDOWS),
-                                      currentVad->isSharedMemory,
-                                      currentVad->isBeingDeleted,
-                                      currentVad->isProcessBaseImage);
+                regions[i] = vadTrees[i]->finishWalk(*walks[i]);
             }
-            catch (const std::exception& e)
+        }
+#ifdef TRACE_MODE
+        vadTrees.front()->logger->debug(
+            "VAD tree walks finished",
+            {logfield::create("numberOfVadTrees", static_cast<uint64_t>(vadTrees.size())),
+             logfield::create("numberOfLevels", numberOfLevels),
+             logfield::create("libvmiCalls",
+                              vadTrees.front()->vmiInterface->getNumberOfLibvmiCalls() - libvmiCallsAtStart)});
+#endif
+        return regions;
+    }
+
+    VadTreeWin10::VadTreeWalk VadTreeWin10::startWalk() const
+    {
+        std::shared_ptr<const VadCache> previousVadCache;
+        {
+            std::scoped_lock lock(vadCacheLock);
+            previousVadCache = vadCache;
+        }
+        return {kernelAccess->extractVadTreeRootAddress(eprocessBase),
+                std::move(previousVadCache),
+                std::make_shared<VadCache>(),
+                {},
+                std::make_unique<std::list<MemoryRegion>>(),
+                0,
+                0};
+    }
+
+    void VadTreeWin10::visitVad(VadTreeWalk& walk, const StructSnapshot& mmVad) const
+    {
+        auto vadEntryBaseVA = mmVad.getBaseVA();
+        try
+        {
+            auto vadShortValues = kernelAccess->extractMmVadShortValues(mmVad);
+            // Private allocations may only be backed by an _MMVAD_SHORT, which has no subsection
+            auto subsection =
+                vadShortValues.isPrivateMemory ? addr_t{0} : kernelAccess->extractSubsectionPointer(mmVad);
+            auto controlArea = vadShortValues.isPrivateMemory ? ControlAreaState{} : extractControlAreaState(mmVad);
+            VadFingerprint fingerprint{vadShortValues.startingVpn,
+                                       vadShortValues.endingVpn,
+                                       vadShortValues.protection,
+                                       vadShortValues.isPrivateMemory,
+                                       subsection,
+                                       controlArea};
+            std::shared_ptr<const Vadt> currentVad;
+            if (auto cachedVad = walk.previousVadCache->find(vadEntryBaseVA);
+                cachedVad != walk.previousVadCache->end() && cachedVad->second.fingerprint == fingerprint)
             {
-                logger->warning("Unable to create Vadt object for process",
-                                {logfield::create("ProcessName", processName),
-                                 logfield::create("ProcessId", static_cast<int64_t>(pid)),
-                                 logfield::create("exception", e.what())});
+                currentVad = cachedVad->second.vadt;
+                walk.hits++;
             }
+            else
+            {
+                currentVad = createVadt(mmVad, vadShortValues, controlArea);
+                walk.misses++;
+            }
+            // Incomplete nodes are resolved again on the next walk
+            if (currentVad->isComplete)
+            {
+                walk.nextVadCache->emplace(vadEntryBaseVA, CachedVad{fingerprint, currentVad});
+            }
+
+            const auto startAddress = currentVad->startingVPN << PagingDefinitions::numberOfPageIndexBits;
+            const auto endAddress = ((currentVad->endingVPN + 1) << PagingDefinitions::numberOfPageIndexBits) - 1;
+            const auto size = endAddress - startAddress + 1;
+            logger->debug("Vadt element",
+                          {logfield::create("startingVPN", fmt::format("{:#x}", currentVad->startingVPN)),
+                           logfield::create("endingVPN", fmt::format("{:#x}", currentVad->endingVPN)),
+                           logfield::create("startAddress", fmt::format("{:#x}", startAddress)),
+                           logfield::create("endAddress", fmt::format("{:#x}", endAddress)),
+                           logfield::create("size", static_cast<uint64_t>(size))});
+            walk.regions->emplace_back(startAddress,
+                                       size,
+                                       currentVad->fileName,
+                                       std::make_unique<PageProtection>(static_cast<uint32_t>(currentVad->protection),
+                                                                        OperatingSystem::WINDOWS),
+                                       currentVad->isSharedMemory,
+                                       currentVad->isBeingDeleted,
+                                       currentVad->isProcessBaseImage);
+        }
+        catch (const std::exception& e)
+        {
+            logger->warning("Unable to create Vadt object for process",
+                            {logfield::create("ProcessName", processName),
+                             logfield::create("ProcessId", static_cast<int64_t>(pid)),
+                             logfield::create("exception", e.what())});
         }
+    }
 
-        return regions;
+    std::unique_ptr<std::list<MemoryRegion>> VadTreeWin10::finishWalk(VadTreeWalk& walk) const
+    {
+        {
+            std::scoped_lock lock(vadCacheLock);
+            vadCache = std::move(walk.nextVadCache);
+        }
+#ifdef TRACE_MODE
+        logger->debug("VAD tree walk finished",
+                      {logfield::create("ProcessId", static_cast<int64_t>(pid)),
+                       logfield::create("numberOfRegions", static_cast<uint64_t>(walk.regions->size())),
+                       logfield::create("vadCacheHits", walk.hits),
+                       logfield::create("vadCacheMisses", walk.misses)});
+#endif
+        // The walk order depends on how the regions are batched, so return them in address order instead
+        walk.regions->sort([](const MemoryRegion& lhs, const MemoryRegion& rhs) { return lhs.base < rhs.base; });
+        return std::move(walk.regions);
     }
 
     bool vadEntryIsFileBacked(bool imageFlag, bool fileFlag)
@@ -103,35 +235,60 @@ namespace Windows
         return imageFlag || fileFlag;
     }
 
-    std::unique_ptr<Vadt> VadTreeWin10::createVadt(uint64_t vadEntryBaseVA) const
+    VadTreeWin10::ControlAreaState VadTreeWin10::extractControlAreaState(const StructSnapshot& mmVad) const
+    {
+        ControlAreaState controlArea{kernelAccess->extractControlAreaBasePointer(mmVad), {}, std::nullopt};
+        controlArea.sectionFlags = kernelAccess->extractMmSectionFlagsValues(controlArea.baseVA);
+        if (vadEntryIsFileBacked(controlArea.sectionFlags.isImage, controlArea.sectionFlags.isFile))
+        {
+            try
+            {
+                controlArea.filePointerObjectAddress =
+                    kernelAccess->extractFilePointerObjectAddress(controlArea.baseVA);
+            }
+            catch (const std::exception&)
+            {
+                // Reported when the node is resolved, which leaves it incomplete
+            }
+        }
+        return controlArea;
+    }
+
+    std::unique_ptr<Vadt> VadTreeWin10::createVadt(const StructSnapshot& mmVad,
+                                                   const MmVadShortValues& vadShortValues,
+                                                   const ControlAreaState& controlArea) const
     {
+        auto vadEntryBaseVA = mmVad.getBaseVA();
         auto vadt = std::make_unique<Vadt>();
-        auto vadShortBaseVA = kernelAccess->getVadShortBaseVA(vadEntryBaseVA);
-        std::tie(vadt->startingVPN, vadt->endingVPN) = kernelAccess->extractMmVadShortVpns(vadShortBaseVA);
-        vadt->protection = static_cast<ProtectionValues>(kernelAccess->extractProtectionFlagValue(vadShortBaseVA));
+        vadt->startingVPN = vadShortValues.startingVpn;
+        vadt->endingVPN = vadShortValues.endingVpn;
+        vadt->protection = static_cast<ProtectionValues>(vadShortValues.protection);
         vadt->isFileBacked = false;
         vadt->isBeingDeleted = false;
-        vadt->isSharedMemory = !kernelAccess->extractIsPrivateMemory(vadShortBaseVA);
+        vadt->isSharedMemory = !vadShortValues.isPrivateMemory;
         vadt->isProcessBaseImage = false;
 
         vadt->vadEntryBaseVA = vadEntryBaseVA;
 
         if (vadt->isSharedMemory)
         {
-            auto controlAreaBaseVA = kernelAccess->extractControlAreaBasePointer(vadEntryBaseVA);
-            auto imageFlag = kernelAccess->extractIsImage(controlAreaBaseVA);
-            auto fileFlag = kernelAccess->extractIsFile(controlAreaBaseVA);
-            if (vadEntryIsFileBacked(imageFlag, fileFlag))
+            const auto& sectionFlags = controlArea.sectionFlags;
+            if (vadEntryIsFileBacked(sectionFlags.isImage, sectionFlags.isFile))
             {
                 logger->debug("Is file backed",
                               {
-                                  logfield::create("mmSectionFlags.Image", fmt::format("{:#x}", imageFlag)),
-                                  logfield::create("mmSectionFlags.File", fmt::format("{:#x}", fileFlag)),
+                                  logfield::create("mmSectionFlags.Image", fmt::format("{:#x}", sectionFlags.isImage)),
+                                  logfield::create("mmSectionFlags.File", fmt::format("{:#x}", sectionFlags.isFile)),
                               });
                 vadt->isFileBacked = true;
                 try
                 {
-                    auto filePointerObjectAddress = kernelAccess->extractFilePointerObjectAddress(controlAreaBaseVA);
+                    if (!controlArea.filePointerObjectAddress)
+                    {
+                        throw VmiException(fmt::format(
+                            "{}: File pointer of control area {:#x} unknown", __func__, controlArea.baseVA));
+                    }
+                    auto filePointerObjectAddress = *controlArea.filePointerObjectAddress;
                     vadt->fileName = *extractFileName(filePointerObjectAddress);
 
                     auto imageFilePointerFromEprocess = kernelAccess->extractImageFilePointer(eprocessBase);
@@ -141,6 +298,7 @@ namespace Windows
                 catch (const std::exception& e)
                 {
                     vadt->fileName = "unknownFilename";
+                    vadt->isComplete = false;
                     logger->warning("Unable to extract file name for VAD",
                                     {
                                         logfield::create("ProcessName", processName),
@@ -150,7 +308,7 @@ namespace Windows
                                     });
                 }
             }
-            vadt->isBeingDeleted = kernelAccess->extractIsBeingDeleted(controlAreaBaseVA);
+            vadt->isBeingDeleted = sectionFlags.isBeingDeleted;
         }
         return vadt;
     }
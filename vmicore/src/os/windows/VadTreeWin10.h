@@ -6,6 +6,12 @@
 #include "Vadt.h"
 #include <list>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include <vmicore/os/IMemoryRegionExtractor.h>
 
 namespace Windows
@@ -13,7 +19,8 @@ namespace Windows
     class VadTreeWin10 : public IMemoryRegionExtractor
     {
       public:
-        VadTreeWin10(std::shared_ptr<IKernelAccess> kernelAccess,
+        VadTreeWin10(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                     std::shared_ptr<IKernelAccess> kernelAccess,
                      uint64_t eprocessBase,
                      pid_t pid,
                      std::string processName,
@@ -21,14 +28,83 @@ namespace Windows
 
         [[nodiscard]] std::unique_ptr<std::list<MemoryRegion>> extractAllMemoryRegions() const override;
 
+        // Walks all VAD trees together, level by level, and reads all nodes of a level with a single batched read. The
+        // result has one entry per VAD tree, which is null if the tree could not be walked. All VAD trees have to share
+        // the same kernel access.
+        [[nodiscard]] static std::vector<std::unique_ptr<std::list<MemoryRegion>>>
+        extractAllMemoryRegions(std::span<const VadTreeWin10* const> vadTrees);
+
       private:
+        // The control area of a shared VAD can change while the VAD itself stays the same, e.g. when its section is
+        // being deleted
+        struct ControlAreaState
+        {
+            addr_t baseVA;
+            MmSectionFlagsValues sectionFlags;
+            // Only present for file backed sections whose file pointer could be read
+            std::optional<addr_t> filePointerObjectAddress;
+
+            bool operator==(const ControlAreaState& rhs) const = default;
+        };
+
+        // Everything a VAD node is resolved from. Nodes whose fingerprint has not changed since the previous walk
+        // describe the same memory region.
+        struct VadFingerprint
+        {
+            uint64_t startingVpn;
+            uint64_t endingVpn;
+            uint8_t protection;
+            bool isPrivateMemory;
+            addr_t subsection;
+            // Empty for private memory
+            ControlAreaState controlArea;
+
+            bool operator==(const VadFingerprint& rhs) const = default;
+        };
+
+        struct CachedVad
+        {
+            VadFingerprint fingerprint;
+            std::shared_ptr<const Vadt> vadt;
+        };
+
+        using VadCache = std::unordered_map<addr_t, CachedVad>;
+
+        struct VadTreeWalk
+        {
+            addr_t rootAddress;
+            std::shared_ptr<const VadCache> previousVadCache;
+            std::shared_ptr<VadCache> nextVadCache;
+            std::unordered_set<addr_t> visitedVadVAs;
+            std::unique_ptr<std::list<MemoryRegion>> regions;
+            // Only logged in trace mode
+            uint64_t hits;
+            uint64_t misses;
+        };
+
+        std::shared_ptr<ILibvmiInterface> vmiInterface;
         std::shared_ptr<IKernelAccess> kernelAccess;
         uint64_t eprocessBase;
         pid_t pid;
         std::string processName;
         std::unique_ptr<ILogger> logger;
+        // Nodes of the previous walk keyed by their _MMVAD address. Each walk replaces the cache as a whole, so nodes
+        // that have been removed from the tree are dropped. The fingerprint is read on every walk, so a cached node only
+        // saves the file name and image file pointer reads.
+        mutable std::mutex vadCacheLock;
+        mutable std::shared_ptr<const VadCache> vadCache = std::make_shared<const VadCache>();
+
+        [[nodiscard]] VadTreeWalk startWalk() const;
+
+        void visitVad(VadTreeWalk& walk, const StructSnapshot& mmVad) const;
+
+        [[nodiscard]] std::unique_ptr<std::list<MemoryRegion>> finishWalk(VadTreeWalk& walk) const;
+
+        [[nodiscard]] ControlAreaState extractControlAreaState(const StructSnapshot& mmVad) const;
 
-        [[nodiscard]] std::unique_ptr<Vadt> createVadt(uint64_t vadEntryBaseVA) const;
+        [[nodiscard]] std::unique_ptr<Vadt> createVadt(const StructSnapshot& mmVad,
+                                                       const MmVadShortValues& vadShortValues,
+                                                       const ControlAreaState& controlArea) const;
 
         [[nodiscard]] std::unique_ptr<std::string> extractFileName(addr_t filePointerObjectAddress) const;
     };
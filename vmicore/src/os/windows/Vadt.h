@@ -18,6 +18,8 @@ namespace Windows
         bool isSharedMemory;
         bool isBeingDeleted;
         bool isProcessBaseImage;
+        // Cleared if some of the information could not be read, e.g. because it was paged out
+        bool isComplete = true;
 
         bool operator==(const Vadt& rhs) const
         {
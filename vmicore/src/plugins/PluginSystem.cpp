@@ -1,5 +1,7 @@
 #include "PluginSystem.h"
+#include "../GlobalControl.h"
 #include "../os/PagingDefinitions.h"
+#include <algorithm>
 #include <cstdint>
 #include <dlfcn.h>
 #include <exception>
@@ -44,51 +46,103 @@ PluginSystem::~PluginSystem()
 }
 
 std::unique_ptr<std::vector<uint8_t>>
-PluginSystem::readPagesWithUnmappedRegionPadding(uint64_t pageAlignedVA, uint64_t cr3, uint64_t numberOfPages) const
+PluginSystem::readPagesWithUnmappedRegionPadding(uint64_t pageAlignedVA,
+                                                 uint64_t cr3,
+                                                 uint64_t numberOfPages,
+                                                 const std::vector<PageTranslation>& translations) const
 {
-    if (pageAlignedVA % PagingDefinitions::pageSizeInBytes != 0)
-    {
-        throw std::invalid_argument(
-            fmt::format("{}: Starting address {:#x} is not aligned to page boundary", __func__, pageAlignedVA));
-    }
     auto vadIdentifier(fmt::format("CR3 {:#x} VAD @ {:#x}-{:#x}",
                                    cr3,
                                    pageAlignedVA,
                                    (pageAlignedVA + numberOfPages * PagingDefinitions::pageSizeInBytes)));
     auto memoryRegion = std::make_unique<std::vector<uint8_t>>();
+    memoryRegion->reserve(numberOfPages * PagingDefinitions::pageSizeInBytes);
     auto needsPadding = true;
-    for (uint64_t currentPageIndex = 0; currentPageIndex < numberOfPages; currentPageIndex++)
+
+    auto logEndOfPadding = [&](uint64_t virtualAddress)
     {
-        auto memoryPage = std::vector<uint8_t>(PagingDefinitions::pageSizeInBytes);
-        if (vmiInterface->readXVA(pageAlignedVA, cr3, memoryPage))
+        if (!needsPadding)
         {
-            if (!needsPadding)
-            {
-                needsPadding = true;
-                logger->info("First successful page extraction after padding",
-                             {logfield::create(WRITE_TO_FILE_TAG, paddingLogFile),
-                              logfield::create("vadIdentifier", vadIdentifier),
-                              logfield::create("pageAlignedVA", fmt::format("{:#x}", pageAlignedVA))});
-            }
-            memoryRegion->insert(memoryRegion->cend(), memoryPage.cbegin(), memoryPage.cend());
+            needsPadding = true;
+            logger->info("First successful page extraction after padding",
+                         {logfield::create(WRITE_TO_FILE_TAG, paddingLogFile),
+                          logfield::create("vadIdentifier", vadIdentifier),
+                          logfield::create("pageAlignedVA", fmt::format("{:#x}", virtualAddress))});
+        }
+    };
+    auto appendContent = [&](uint64_t virtualAddress, uint64_t physicalAddress, uint64_t size)
+    {
+        auto offset = memoryRegion->size();
+        memoryRegion->resize(offset + size);
+        if (!vmiInterface->readPA(physicalAddress, std::span(memoryRegion->data() + offset, size)))
+        {
+            memoryRegion->resize(offset);
+            return false;
+        }
+        logEndOfPadding(virtualAddress);
+        return true;
+    };
+    auto appendPadding = [&](uint64_t virtualAddress)
+    {
+        if (needsPadding)
+        {
+            memoryRegion->insert(memoryRegion->cend(), PagingDefinitions::pageSizeInBytes, 0x0);
+            needsPadding = false;
+            logger->info("Start of padding",
+                         {logfield::create(WRITE_TO_FILE_TAG, paddingLogFile),
+                          logfield::create("vadIdentifier", vadIdentifier),
+                          logfield::create("pageAlignedVA", fmt::format("{:#x}", virtualAddress))});
         }
-        else
+    };
+
+    for (const auto& translation : translations)
+    {
+        if (!translation.present)
+        {
+            appendPadding(translation.virtualAddress);
+            continue;
+        }
+        if (appendContent(translation.virtualAddress, translation.physicalAddress, translation.size))
+        {
+            continue;
+        }
+        // Retry each (large) page of the run on its own so that one unreadable frame does not discard the whole run.
+        // Large pages are only split into 4 KiB frames if they cannot be read as a whole.
+        for (uint64_t offset = 0; offset < translation.size;)
         {
-            if (needsPadding)
+            auto virtualAddress = translation.virtualAddress + offset;
+            auto physicalAddress = translation.physicalAddress + offset;
+            auto chunkSize = std::min(translation.size - offset,
+                                      translation.pageSize - (virtualAddress & (translation.pageSize - 1)));
+            if (translation.pageSize == PagingDefinitions::pageSizeInBytes || chunkSize == translation.size ||
+                !appendContent(virtualAddress, physicalAddress, chunkSize))
             {
-                memoryRegion->insert(memoryRegion->cend(), PagingDefinitions::pageSizeInBytes, 0x0);
-                needsPadding = false;
-                logger->info("Start of padding",
-                             {logfield::create(WRITE_TO_FILE_TAG, paddingLogFile),
-                              logfield::create("vadIdentifier", vadIdentifier),
-                              logfield::create("pageAlignedVA", fmt::format("{:#x}", pageAlignedVA))});
+                for (uint64_t frameOffset = 0; frameOffset < chunkSize;
+                     frameOffset += PagingDefinitions::pageSizeInBytes)
+                {
+                    if (!appendContent(virtualAddress + frameOffset,
+                                       physicalAddress + frameOffset,
+                                       PagingDefinitions::pageSizeInBytes))
+                    {
+                        appendPadding(virtualAddress + frameOffset);
+                    }
+                }
             }
+            offset += chunkSize;
         }
-        pageAlignedVA += PagingDefinitions::pageSizeInBytes;
     }
     return memoryRegion;
 }
 
+void PluginSystem::expectPageAlignedAddress(uint64_t address, const char* caller)
+{
+    if (address % PagingDefinitions::pageSizeInBytes != 0)
+    {
+        throw std::invalid_argument(
+            fmt::format("{}: Starting address {:#x} is not aligned to page boundary", caller, address));
+    }
+}
+
 std::unique_ptr<std::vector<uint8_t>>
 PluginSystem::readProcessMemoryRegion(pid_t pid, Plugin::virtual_address_t address, size_t count) const
 {
@@ -96,9 +150,24 @@ PluginSystem::readProcessMemoryRegion(pid_t pid, Plugin::virtual_address_t addre
     {
         throw std::invalid_argument("Size of memory region must be page size aligned.");
     }
+    expectPageAlignedAddress(address, static_cast<const char*>(__func__));
     auto numberOfPages = count >> PagingDefinitions::numberOfPageIndexBits;
     auto process = activeProcessesSupervisor->getProcessInformationByPid(pid);
-    return readPagesWithUnmappedRegionPadding(address, process->processCR3, numberOfPages);
+    auto translations = vmiInterface->translateRange(address, count, process->processCR3);
+    return readPagesWithUnmappedRegionPadding(address, process->processCR3, numberOfPages, translations);
+}
+
+std::unique_ptr<IMemoryMapping>
+PluginSystem::mapProcessMemoryRegion(pid_t pid, Plugin::virtual_address_t address, size_t numberOfBytes) const
+{
+    expectPageAlignedAddress(address, static_cast<const char*>(__func__));
+    if (numberOfBytes % PagingDefinitions::pageSizeInBytes != 0)
+    {
+        throw std::invalid_argument("Size of memory region must be page size aligned.");
+    }
+    auto numberOfPages = numberOfBytes >> PagingDefinitions::numberOfPageIndexBits;
+    auto process = activeProcessesSupervisor->getProcessInformationByPid(pid);
+    return vmiInterface->mmapGuest(address, process->processCR3, numberOfPages);
 }
 
 void PluginSystem::registerProcessTerminationEvent(Plugin::processTerminationCallback_f terminationCallback)
@@ -106,6 +175,11 @@ void PluginSystem::registerProcessTerminationEvent(Plugin::processTerminationCal
     registeredProcessTerminationCallbacks.push_back(terminationCallback);
 }
 
+void PluginSystem::registerDeferredProcessTerminationEvent(Plugin::processTerminationCallback_f terminationCallback)
+{
+    registeredDeferredProcessTerminationCallbacks.push_back(terminationCallback);
+}
+
 void PluginSystem::registerShutdownEvent(Plugin::shutdownCallback_f shutdownCallback)
 {
     registeredShutdownCallbacks.push_back(shutdownCallback);
@@ -172,6 +246,12 @@ void PluginSystem::sendInMemDetectionEvent(const std::string& message) const
     eventStream->sendInMemDetectionEvent(message);
 }
 
+void PluginSystem::requestShutdown() const
+{
+    GlobalControl::endVmi = true;
+    GlobalControl::wakeUpEventLoop();
+}
+
 std::unique_ptr<std::string> PluginSystem::getResultsDir() const
 {
     return std::make_unique<std::string>(configInterface->getResultsDirectory());
@@ -182,6 +262,12 @@ std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>> Pl
     return activeProcessesSupervisor->getActiveProcesses();
 }
 
+std::vector<std::unique_ptr<std::list<MemoryRegion>>> PluginSystem::extractAllMemoryRegions(
+    const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes) const
+{
+    return activeProcessesSupervisor->extractAllMemoryRegions(processes);
+}
+
 void PluginSystem::initializePlugin(const std::string& pluginName,
                                     std::shared_ptr<Plugin::IPluginConfig> config,
                                     const std::vector<std::string>& args)
@@ -246,6 +332,15 @@ void PluginSystem::passProcessTerminationEventToRegisteredPlugins(
     }
 }
 
+void PluginSystem::passProcessTerminationEventToDeferredPlugins(
+    std::shared_ptr<const ActiveProcessInformation> processInformation)
+{
+    for (auto& processTerminationCallback : registeredDeferredProcessTerminationCallbacks)
+    {
+        processTerminationCallback(processInformation);
+    }
+}
+
 void PluginSystem::passShutdownEventToRegisteredPlugins()
 {
     vmiInterface->flushV2PCache(LibvmiInterface::flushAllPTs);
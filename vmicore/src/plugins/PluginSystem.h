@@ -23,6 +23,10 @@ class IPluginSystem : public Plugin::PluginInterface
     virtual void passProcessTerminationEventToRegisteredPlugins(
         std::shared_ptr<const ActiveProcessInformation> processInformation) = 0;
 
+    // Has to be called after the terminating process has been resumed
+    virtual void passProcessTerminationEventToDeferredPlugins(
+        std::shared_ptr<const ActiveProcessInformation> processInformation) = 0;
+
     virtual void passShutdownEventToRegisteredPlugins() = 0;
 
   protected:
@@ -48,6 +52,9 @@ class PluginSystem : public IPluginSystem
     void passProcessTerminationEventToRegisteredPlugins(
         std::shared_ptr<const ActiveProcessInformation> processInformation) override;
 
+    void passProcessTerminationEventToDeferredPlugins(
+        std::shared_ptr<const ActiveProcessInformation> processInformation) override;
+
     void passShutdownEventToRegisteredPlugins() override;
 
   private:
@@ -56,6 +63,7 @@ class PluginSystem : public IPluginSystem
     std::shared_ptr<IActiveProcessesSupervisor> activeProcessesSupervisor;
     std::shared_ptr<IFileTransport> legacyLogging;
     std::vector<Plugin::processTerminationCallback_f> registeredProcessTerminationCallbacks;
+    std::vector<Plugin::processTerminationCallback_f> registeredDeferredProcessTerminationCallbacks;
     std::vector<Plugin::shutdownCallback_f> registeredShutdownCallbacks;
     std::shared_ptr<ILogging> loggingLib;
     std::unique_ptr<ILogger> logger;
@@ -64,16 +72,29 @@ class PluginSystem : public IPluginSystem
     [[nodiscard]] std::unique_ptr<std::string> getResultsDir() const override;
 
     [[nodiscard]] std::unique_ptr<std::vector<uint8_t>>
-    readPagesWithUnmappedRegionPadding(uint64_t pageAlignedVA, uint64_t cr3, uint64_t numberOfPages) const;
+    readPagesWithUnmappedRegionPadding(uint64_t pageAlignedVA,
+                                       uint64_t cr3,
+                                       uint64_t numberOfPages,
+                                       const std::vector<PageTranslation>& translations) const;
+
+    static void expectPageAlignedAddress(uint64_t address, const char* caller);
 
     [[nodiscard]] std::unique_ptr<std::vector<uint8_t>>
     readProcessMemoryRegion(pid_t pid, Plugin::virtual_address_t address, size_t numberOfBytes) const override;
 
+    [[nodiscard]] std::unique_ptr<IMemoryMapping>
+    mapProcessMemoryRegion(pid_t pid, Plugin::virtual_address_t address, size_t numberOfBytes) const override;
+
     [[nodiscard]] std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>
     getRunningProcesses() const override;
 
+    [[nodiscard]] std::vector<std::unique_ptr<std::list<MemoryRegion>>> extractAllMemoryRegions(
+        const std::vector<std::shared_ptr<const ActiveProcessInformation>>& processes) const override;
+
     void registerProcessTerminationEvent(Plugin::processTerminationCallback_f terminationCallback) override;
 
+    void registerDeferredProcessTerminationEvent(Plugin::processTerminationCallback_f terminationCallback) override;
+
     void registerShutdownEvent(Plugin::shutdownCallback_f shutdownCallback) override;
 
     void writeToFile(const std::string& filename, const std::string& message) const override;
@@ -85,6 +106,8 @@ class PluginSystem : public IPluginSystem
     void sendErrorEvent(const std::string& message) const override;
 
     void sendInMemDetectionEvent(const std::string& message) const override;
+
+    void requestShutdown() const override;
 };
 
 #endif // VMICORE_PLUGINSYSTEM_H
@@ -0,0 +1,198 @@
+#include "AltP2mBreakpointEngine.h"
+#include "../GlobalControl.h"
+#include "../io/grpc/GRPCLogger.h"
+#include "../os/PagingDefinitions.h"
+#include "VmiException.h"
+#include <array>
+#include <filesystem>
+#include <fmt/core.h>
+
+namespace
+{
+    constexpr uint64_t restoreOriginalGfn = ~0ull;
+    const std::string loggerName = std::filesystem::path(__FILE__).filename().stem();
+}
+
+AltP2mBreakpointEngine::AltP2mBreakpointEngine(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                                               std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor,
+                                               std::shared_ptr<ILogging> loggingLib)
+    : vmiInterface(std::move(vmiInterface)),
+      singleStepSupervisor(std::move(singleStepSupervisor)),
+      logger(NEW_LOGGER(loggingLib))
+{
+}
+
+void AltP2mBreakpointEngine::initialize()
+{
+    vmiInterface->setSlatEnabled(true);
+    executeView = vmiInterface->createSlatView();
+    vmiInterface->switchSlatView(executeView);
+    logger->debug("Switched to altp2m execute view", {logfield::create("view", static_cast<uint64_t>(executeView))});
+}
+
+void AltP2mBreakpointEngine::teardown()
+{
+    if (executeView == hostView)
+    {
+        return;
+    }
+    vmiInterface->pauseVm();
+    vmiInterface->switchSlatView(hostView);
+    for (auto& [gfn, shadowPage] : shadowPagesByGfn)
+    {
+        releaseShadowPage(gfn, shadowPage);
+    }
+    shadowPagesByGfn.clear();
+    vmiInterface->destroySlatView(executeView);
+    executeView = hostView;
+    vmiInterface->setSlatEnabled(false);
+    vmiInterface->resumeVm();
+}
+
+void AltP2mBreakpointEngine::setBreakpoint(uint64_t targetPA, uint8_t value)
+{
+    auto& shadowPage = getOrCreateShadowPage(targetPA >> PagingDefinitions::numberOfPageIndexBits);
+    vmiInterface->write8PA((shadowPage.shadowGfn << PagingDefinitions::numberOfPageIndexBits) +
+                               (targetPA & ~PagingDefinitions::stripPageOffsetMask),
+                           value);
+    shadowPage.breakpoints[targetPA] = value;
+}
+
+void AltP2mBreakpointEngine::removeBreakpoint(uint64_t targetPA, uint8_t originalValue)
+{
+    auto gfn = targetPA >> PagingDefinitions::numberOfPageIndexBits;
+    auto shadowPageIterator = shadowPagesByGfn.find(gfn);
+    if (shadowPageIterator == shadowPagesByGfn.end() || !shadowPageIterator->second.breakpoints.contains(targetPA))
+    {
+        return;
+    }
+    auto& shadowPage = shadowPageIterator->second;
+    vmiInterface->write8PA((shadowPage.shadowGfn << PagingDefinitions::numberOfPageIndexBits) +
+                               (targetPA & ~PagingDefinitions::stripPageOffsetMask),
+                           originalValue);
+    shadowPage.breakpoints.erase(targetPA);
+    if (shadowPage.breakpoints.empty())
+    {
+        releaseShadowPage(gfn, shadowPage);
+        shadowPagesByGfn.erase(shadowPageIterator);
+    }
+}
+
+event_response_t AltP2mBreakpointEngine::stepInHostView(vmi_event_t* event) const
+{
+    event->slat_id = hostView;
+    event->next_slat_id = executeView;
+    return VMI_EVENT_RESPONSE_SLAT_ID | VMI_EVENT_RESPONSE_NEXT_SLAT_ID | VMI_EVENT_RESPONSE_TOGGLE_SINGLESTEP;
+}
+
+uint16_t AltP2mBreakpointEngine::getExecuteView() const
+{
+    return executeView;
+}
+
+AltP2mBreakpointEngine::ShadowPage& AltP2mBreakpointEngine::getOrCreateShadowPage(uint64_t gfn)
+{
+    if (auto shadowPageIterator = shadowPagesByGfn.find(gfn); shadowPageIterator != shadowPagesByGfn.end())
+    {
+        return shadowPageIterator->second;
+    }
+
+    auto shadowGfn = vmiInterface->allocateGfn();
+    copyOriginalFrame(gfn, shadowGfn);
+    vmiInterface->changeSlatGfn(executeView, gfn, shadowGfn);
+
+    // Allocate zeroed memory
+    auto* accessEvent = reinterpret_cast<vmi_event_t*>(calloc(1, sizeof(vmi_event_t)));
+    SETUP_MEM_EVENT(accessEvent, gfn, VMI_MEMACCESS_RW, &AltP2mBreakpointEngine::_shadowPageAccessCallback, false);
+    accessEvent->slat_id = executeView;
+    accessEvent->data = this;
+    vmiInterface->registerEvent(*accessEvent);
+
+    logger->debug("Created shadow page",
+                  {logfield::create("gfn", fmt::format("{:#x}", gfn)),
+                   logfield::create("shadowGfn", fmt::format("{:#x}", shadowGfn))});
+    return shadowPagesByGfn.emplace(gfn, ShadowPage{shadowGfn, accessEvent, {}}).first->second;
+}
+
+void AltP2mBreakpointEngine::copyOriginalFrame(uint64_t gfn, uint64_t shadowGfn)
+{
+    std::array<uint8_t, PagingDefinitions::pageSizeInBytes> pageContent{};
+    if (!vmiInterface->readPA(gfn << PagingDefinitions::numberOfPageIndexBits, pageContent))
+    {
+        throw VmiException(fmt::format("{}: Unable to read gfn {:#x}", __func__, gfn));
+    }
+    vmiInterface->writePA(shadowGfn << PagingDefinitions::numberOfPageIndexBits, pageContent);
+}
+
+void AltP2mBreakpointEngine::releaseShadowPage(uint64_t gfn, ShadowPage& shadowPage)
+{
+    vmiInterface->clearEvent(*shadowPage.accessEvent, true);
+    vmiInterface->changeSlatGfn(executeView, gfn, restoreOriginalGfn);
+    vmiInterface->freeGfn(shadowPage.shadowGfn);
+    logger->debug("Released shadow page", {logfield::create("gfn", fmt::format("{:#x}", gfn))});
+}
+
+event_response_t AltP2mBreakpointEngine::stepWriteInHostView(vmi_event_t* event)
+{
+    // A fast single step would return to the execute view without another VM exit, so the shadow copy could not be
+    // refreshed before the vCPU executes from it again
+    singleStepSupervisor->setSingleStepCallback(
+        event->vcpu_id,
+        [engine = weak_from_this(), gfn = event->mem_event.gfn](vmi_event_t* singleStepEvent)
+        {
+            if (auto engineShared = engine.lock())
+            {
+                engineShared->refreshShadowPage(gfn, singleStepEvent);
+            }
+            else
+            {
+                throw std::runtime_error("Callback target does not exist anymore.");
+            }
+        });
+    event->slat_id = hostView;
+    return VMI_EVENT_RESPONSE_SLAT_ID;
+}
+
+void AltP2mBreakpointEngine::refreshShadowPage(uint64_t gfn, vmi_event_t* singleStepEvent)
+{
+    // The shadow copy may have been released together with its last breakpoint in the meantime
+    if (auto shadowPageIterator = shadowPagesByGfn.find(gfn); shadowPageIterator != shadowPagesByGfn.end())
+    {
+        auto& shadowPage = shadowPageIterator->second;
+        copyOriginalFrame(gfn, shadowPage.shadowGfn);
+        for (const auto& [breakpointPA, value] : shadowPage.breakpoints)
+        {
+            vmiInterface->write8PA((shadowPage.shadowGfn << PagingDefinitions::numberOfPageIndexBits) +
+                                       (breakpointPA & ~PagingDefinitions::stripPageOffsetMask),
+                                   value);
+        }
+        logger->debug("Refreshed shadow page after write", {logfield::create("gfn", fmt::format("{:#x}", gfn))});
+    }
+    singleStepEvent->slat_id = executeView;
+}
+
+event_response_t AltP2mBreakpointEngine::_shadowPageAccessCallback(__attribute__((unused)) vmi_instance_t vmiInstance,
+                                                                   vmi_event_t* event)
+{
+    auto eventResponse = VMI_EVENT_RESPONSE_NONE;
+    try
+    {
+        auto* engine = reinterpret_cast<AltP2mBreakpointEngine*>(event->data);
+        if (event->mem_event.out_access & VMI_MEMACCESS_W)
+        {
+            eventResponse = engine->stepWriteInHostView(event);
+        }
+        else
+        {
+            eventResponse = engine->stepInHostView(event);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        GlobalControl::endVmi = true;
+        GlobalControl::logger()->error(
+            "Unexpected exception", {logfield::create("logger", loggerName), logfield::create("exception", e.what())});
+        GlobalControl::eventStream()->sendErrorEvent(e.what());
+    }
+    return eventResponse;
+}
@@ -0,0 +1,75 @@
+#ifndef VMICORE_ALTP2MBREAKPOINTENGINE_H
+#define VMICORE_ALTP2MBREAKPOINTENGINE_H
+
+#include "../io/ILogging.h"
+#include "LibvmiInterface.h"
+#include "SingleStepSupervisor.h"
+#include <map>
+#include <memory>
+
+// Keeps breakpoints out of guest memory. Every page that contains a breakpoint is backed by a shadow copy in a
+// separate execute view, in which all vCPUs run. Only the shadow copy contains the breakpoint instruction. A vCPU that
+// hits a breakpoint executes the original instruction in the host view and is switched back to the execute view by
+// Xen's fast single step, without another VM exit. Reads of shadowed pages are handled the same way, so the guest never
+// sees a breakpoint instruction. A write lands in the original frame, so the shadow copy is refreshed from it after the
+// writing instruction has been single stepped.
+class AltP2mBreakpointEngine : public std::enable_shared_from_this<AltP2mBreakpointEngine>
+{
+  public:
+    static constexpr uint16_t hostView = 0;
+
+    AltP2mBreakpointEngine(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                           std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor,
+                           std::shared_ptr<ILogging> loggingLib);
+
+    ~AltP2mBreakpointEngine() = default;
+
+    AltP2mBreakpointEngine(const AltP2mBreakpointEngine&) = delete;
+
+    AltP2mBreakpointEngine& operator=(const AltP2mBreakpointEngine&) = delete;
+
+    void initialize();
+
+    void teardown();
+
+    // Writes value at targetPA into the shadow copy of the page, creating the shadow copy if necessary
+    void setBreakpoint(uint64_t targetPA, uint8_t value);
+
+    // Restores originalValue in the shadow copy. The shadow copy is released together with its last breakpoint.
+    void removeBreakpoint(uint64_t targetPA, uint8_t originalValue);
+
+    // Lets the vCPU of the event execute one instruction on the original pages before it returns to the execute view
+    [[nodiscard]] event_response_t stepInHostView(vmi_event_t* event) const;
+
+    [[nodiscard]] uint16_t getExecuteView() const;
+
+  private:
+    struct ShadowPage
+    {
+        uint64_t shadowGfn;
+        // Traps reads and writes of the shadowed frame in the execute view
+        vmi_event_t* accessEvent;
+        // Breakpoint values by physical address, needed to reapply them after a refresh
+        std::map<uint64_t, uint8_t> breakpoints;
+    };
+
+    std::shared_ptr<ILibvmiInterface> vmiInterface;
+    std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor;
+    std::unique_ptr<ILogger> logger;
+    uint16_t executeView = hostView;
+    std::map<uint64_t, ShadowPage> shadowPagesByGfn;
+
+    ShadowPage& getOrCreateShadowPage(uint64_t gfn);
+
+    void copyOriginalFrame(uint64_t gfn, uint64_t shadowGfn);
+
+    void releaseShadowPage(uint64_t gfn, ShadowPage& shadowPage);
+
+    [[nodiscard]] event_response_t stepWriteInHostView(vmi_event_t* event);
+
+    void refreshShadowPage(uint64_t gfn, vmi_event_t* singleStepEvent);
+
+    static event_response_t _shadowPageAccessCallback(vmi_instance_t vmiInstance, vmi_event_t* event);
+};
+
+#endif // VMICORE_ALTP2MBREAKPOINTENGINE_H
@@ -0,0 +1,56 @@
+#include "EventMetrics.h"
+#include <fmt/core.h>
+
+EventMetrics::EventMetrics() = default;
+
+std::shared_ptr<LatencyHistogram> EventMetrics::getLatencyHistogram(const std::string& source)
+{
+    if (source == vmPauseSource || source == singleStepSource || source == interruptGuardSource)
+    {
+        throw std::invalid_argument(fmt::format("{}: Event source name {} is reserved", __func__, source));
+    }
+    return getOrCreateLatencyHistogram(source);
+}
+
+std::shared_ptr<LatencyHistogram> EventMetrics::getSingleStepLatencyHistogram()
+{
+    return getOrCreateLatencyHistogram(singleStepSource);
+}
+
+std::shared_ptr<LatencyHistogram> EventMetrics::getInterruptGuardLatencyHistogram()
+{
+    return getOrCreateLatencyHistogram(interruptGuardSource);
+}
+
+std::shared_ptr<LatencyHistogram> EventMetrics::getOrCreateLatencyHistogram(const std::string& source)
+{
+    std::scoped_lock lock(histogramsLock);
+    auto& histogram = histogramsBySource[source];
+    if (!histogram)
+    {
+        histogram = std::make_shared<LatencyHistogram>();
+    }
+    return histogram;
+}
+
+void EventMetrics::recordVmPause(std::chrono::nanoseconds duration)
+{
+    vmPauseHistogram->record(duration);
+}
+
+EventMetricsSnapshot EventMetrics::createSnapshot() const
+{
+    EventMetricsSnapshot snapshot{{}, vmPauseHistogram->getTotalNanoseconds(), vmPauseHistogram->getCount()};
+    std::scoped_lock lock(histogramsLock);
+    for (const auto& [source, histogram] : histogramsBySource)
+    {
+        snapshot.eventLatencies.push_back({source,
+                                           histogram->getCount(),
+                                           histogram->getTotalNanoseconds(),
+                                           histogram->getValueAtPercentile(50),
+                                           histogram->getValueAtPercentile(90),
+                                           histogram->getValueAtPercentile(99),
+                                           histogram->getMaxNanoseconds()});
+    }
+    return snapshot;
+}
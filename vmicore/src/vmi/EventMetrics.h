@@ -0,0 +1,92 @@
+#ifndef VMICORE_EVENTMETRICS_H
+#define VMICORE_EVENTMETRICS_H
+
+#include "LatencyHistogram.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct EventLatencySummary
+{
+    std::string source;
+    uint64_t count;
+    uint64_t totalNanoseconds;
+    uint64_t p50Nanoseconds;
+    uint64_t p90Nanoseconds;
+    uint64_t p99Nanoseconds;
+    uint64_t maxNanoseconds;
+};
+
+struct EventMetricsSnapshot
+{
+    std::vector<EventLatencySummary> eventLatencies;
+    uint64_t totalVmPauseNanoseconds;
+    uint64_t numberOfVmPauses;
+};
+
+// Measures how long the guest is blocked by event callbacks and paused sections. Histograms are created once per
+// event source and can be recorded to afterwards without taking a lock.
+class EventMetrics
+{
+  public:
+    static constexpr auto vmPauseSource = "VmPause";
+    static constexpr auto singleStepSource = "SingleStep";
+    // Guards are shared between interrupts, so their latencies are not attributed to a single interrupt
+    static constexpr auto interruptGuardSource = "InterruptGuard";
+
+    EventMetrics();
+
+    // Sources are named after interrupts, which plugins may choose. Throws std::invalid_argument for the names of the
+    // built-in sources.
+    std::shared_ptr<LatencyHistogram> getLatencyHistogram(const std::string& source);
+
+    std::shared_ptr<LatencyHistogram> getSingleStepLatencyHistogram();
+
+    std::shared_ptr<LatencyHistogram> getInterruptGuardLatencyHistogram();
+
+    void recordVmPause(std::chrono::nanoseconds duration);
+
+    [[nodiscard]] EventMetricsSnapshot createSnapshot() const;
+
+  private:
+    mutable std::mutex histogramsLock;
+    std::map<std::string, std::shared_ptr<LatencyHistogram>> histogramsBySource;
+    // Reported through the pause totals of the snapshot only
+    std::shared_ptr<LatencyHistogram> vmPauseHistogram = std::make_shared<LatencyHistogram>();
+
+    std::shared_ptr<LatencyHistogram> getOrCreateLatencyHistogram(const std::string& source);
+};
+
+// Records the time from its construction to its destruction into histogram, which may be null
+class ScopedLatencyRecorder
+{
+  public:
+    explicit ScopedLatencyRecorder(LatencyHistogram* histogram)
+        : histogram(histogram), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    ~ScopedLatencyRecorder()
+    {
+        if (histogram)
+        {
+            histogram->record(std::chrono::steady_clock::now() - start);
+        }
+    }
+
+    ScopedLatencyRecorder(const ScopedLatencyRecorder&) = delete;
+
+    ScopedLatencyRecorder& operator=(const ScopedLatencyRecorder&) = delete;
+
+  private:
+    LatencyHistogram* histogram;
+    std::chrono::steady_clock::time_point start;
+};
+
+#endif // VMICORE_EVENTMETRICS_H
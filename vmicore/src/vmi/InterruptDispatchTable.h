@@ -0,0 +1,177 @@
+#ifndef VMICORE_INTERRUPTDISPATCHTABLE_H
+#define VMICORE_INTERRUPTDISPATCHTABLE_H
+
+#include "../os/PagingDefinitions.h"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Maps physical breakpoint addresses to their handlers. Lookups first test a bitmap over all guest frames, so
+// breakpoints on frames without any registered handler, e.g. from debuggers inside the guest, are rejected with a
+// single memory access. Registered frames are resolved in an open addressing table with linear probing. Not thread
+// safe.
+template <typename T> class InterruptDispatchTable
+{
+  public:
+    static constexpr size_t initialCapacity = 64;
+
+    InterruptDispatchTable()
+    {
+        resize(initialCapacity);
+    }
+
+    // Returns false if a handler is already registered for the address
+    bool insert(uint64_t physicalAddress, T* handler)
+    {
+        if (find(physicalAddress) != nullptr)
+        {
+            return false;
+        }
+        if ((numberOfEntries + 1) * 2 > slots.size())
+        {
+            resize(slots.size() * 2);
+        }
+        insertIntoSlots(physicalAddress, handler);
+        numberOfEntries++;
+
+        auto gfn = physicalAddress >> PagingDefinitions::numberOfPageIndexBits;
+        if (gfn / 64 >= gfnBitmap.size())
+        {
+            gfnBitmap.resize(gfn / 64 + 1);
+        }
+        gfnBitmap[gfn / 64] |= 1ull << (gfn % 64);
+        entriesPerGfn[gfn]++;
+        return true;
+    }
+
+    bool erase(uint64_t physicalAddress)
+    {
+        auto index = findSlot(physicalAddress);
+        if (slots[index].handler == nullptr)
+        {
+            return false;
+        }
+        removeFromSlots(index);
+        numberOfEntries--;
+
+        auto gfn = physicalAddress >> PagingDefinitions::numberOfPageIndexBits;
+        if (--entriesPerGfn[gfn] == 0)
+        {
+            entriesPerGfn.erase(gfn);
+            gfnBitmap[gfn / 64] &= ~(1ull << (gfn % 64));
+        }
+        return true;
+    }
+
+    // Returns nullptr if there is no handler for the address
+    [[nodiscard]] T* find(uint64_t physicalAddress) const
+    {
+        auto gfn = physicalAddress >> PagingDefinitions::numberOfPageIndexBits;
+        if (gfn / 64 >= gfnBitmap.size() || (gfnBitmap[gfn / 64] & (1ull << (gfn % 64))) == 0)
+        {
+            return nullptr;
+        }
+        return slots[findSlot(physicalAddress)].handler;
+    }
+
+    template <typename Function> void forEach(Function function) const
+    {
+        for (const auto& slot : slots)
+        {
+            if (slot.handler != nullptr)
+            {
+                function(slot.physicalAddress, *slot.handler);
+            }
+        }
+    }
+
+    void clear()
+    {
+        slots.clear();
+        resize(initialCapacity);
+        numberOfEntries = 0;
+        gfnBitmap.clear();
+        entriesPerGfn.clear();
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return numberOfEntries;
+    }
+
+  private:
+    struct Slot
+    {
+        uint64_t physicalAddress = 0;
+        // nullptr marks an empty slot
+        T* handler = nullptr;
+    };
+
+    std::vector<Slot> slots;
+    size_t numberOfEntries = 0;
+    int hashShift = 0;
+    std::vector<uint64_t> gfnBitmap;
+    // Only needed to know when a bit in the bitmap can be cleared again
+    std::unordered_map<uint64_t, size_t> entriesPerGfn;
+
+    [[nodiscard]] size_t homeSlot(uint64_t physicalAddress) const
+    {
+        // Fibonacci hashing, spreads breakpoints within the same page across the whole table
+        return (physicalAddress * 0x9E3779B97F4A7C15ull) >> hashShift;
+    }
+
+    // Returns the slot holding the address or the empty slot terminating its probe sequence
+    [[nodiscard]] size_t findSlot(uint64_t physicalAddress) const
+    {
+        auto mask = slots.size() - 1;
+        auto index = homeSlot(physicalAddress);
+        while (slots[index].handler != nullptr && slots[index].physicalAddress != physicalAddress)
+        {
+            index = (index + 1) & mask;
+        }
+        return index;
+    }
+
+    void insertIntoSlots(uint64_t physicalAddress, T* handler)
+    {
+        slots[findSlot(physicalAddress)] = {physicalAddress, handler};
+    }
+
+    // Backward shift deletion keeps probe sequences intact without tombstones
+    void removeFromSlots(size_t index)
+    {
+        auto mask = slots.size() - 1;
+        auto next = (index + 1) & mask;
+        while (slots[next].handler != nullptr)
+        {
+            auto home = homeSlot(slots[next].physicalAddress);
+            // Move the entry into the gap unless its home slot lies cyclically between the gap and its position
+            if (((next - home) & mask) >= ((next - index) & mask))
+            {
+                slots[index] = slots[next];
+                index = next;
+            }
+            next = (next + 1) & mask;
+        }
+        slots[index] = {};
+    }
+
+    void resize(size_t capacity)
+    {
+        auto oldSlots = std::move(slots);
+        slots = std::vector<Slot>(capacity);
+        hashShift = 64 - std::countr_zero(capacity);
+        for (const auto& slot : oldSlots)
+        {
+            if (slot.handler != nullptr)
+            {
+                insertIntoSlots(slot.physicalAddress, slot.handler);
+            }
+        }
+    }
+};
+
+#endif // VMICORE_INTERRUPTDISPATCHTABLE_H
@@ -2,6 +2,7 @@
 #include "../GlobalControl.h"
 #include "../io/grpc/GRPCLogger.h"
 #include "../os/PagingDefinitions.h"
+#include "InterruptDispatchTable.h"
 #include "VmiException.h"
 #include <fmt/core.h>
 #include <memory>
@@ -10,7 +11,7 @@
 namespace
 {
     auto event = vmi_event_t{};
-    std::map<addr_t, InterruptEvent*> interruptsByPA;
+    InterruptDispatchTable<InterruptEvent> interruptsByPA;
     const std::string loggerName = std::filesystem::path(__FILE__).filename().stem();
 }
 
@@ -30,10 +31,8 @@ void InterruptEvent::clearInterruptEventHandling(ILibvmiInterface& vmiInterface)
                                          {logfield::create("logger", loggerName)});
     }
 
-    for (auto const& [_addr, interruptEvent] : interruptsByPA)
-    {
-        interruptEvent->teardown();
-    }
+    interruptsByPA.forEach([](addr_t /*physicalAddress*/, InterruptEvent& interruptEvent)
+                           { interruptEvent.teardown(); });
 
     interruptsByPA.clear();
     vmiInterface.clearEvent(event, false);
@@ -43,14 +42,18 @@ void InterruptEvent::clearInterruptEventHandling(ILibvmiInterface& vmiInterface)
 InterruptEvent::InterruptEvent(std::shared_ptr<ILibvmiInterface> vmiInterface,
                                uint64_t targetPA,
                                std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor,
-                               std::unique_ptr<InterruptGuard> interruptGuard,
+                               std::shared_ptr<InterruptGuard> interruptGuard,
+                               std::shared_ptr<AltP2mBreakpointEngine> altP2mEngine,
                                std::function<InterruptResponse(InterruptEvent&)> callbackFunction,
+                               std::shared_ptr<LatencyHistogram> callbackLatency,
                                std::unique_ptr<ILogger> logger)
     : Event(std::move(vmiInterface), std::move(logger)),
       targetPA(targetPA),
       singleStepSupervisor(std::move(singleStepSupervisor)),
       interruptGuard(std::move(interruptGuard)),
-      callbackFunction(std::move(callbackFunction))
+      altP2mEngine(std::move(altP2mEngine)),
+      callbackFunction(std::move(callbackFunction)),
+      callbackLatency(std::move(callbackLatency))
 {
 }
 
@@ -59,10 +62,15 @@ void InterruptEvent::initialize()
     targetPAString = fmt::format("{:#x}", targetPA);
     singleStepCallbackFunction =
         SingleStepSupervisor::createSingleStepCallback(shared_from_this(), &InterruptEvent::singleStepCallback);
-    vmiInterface->flushV2PCache(LibvmiInterface::flushAllPTs);
-    vmiInterface->flushPageCache();
+    vmiInterface->invalidateCaches();
     storeOriginalValue();
     setupVmiInterruptEvent();
+#if defined(X86_64)
+    if (interruptGuard)
+    {
+        interruptGuard->addBreakpoint(targetPA, originalValue);
+    }
+#endif
     enableEvent();
 }
 
@@ -71,7 +79,7 @@ void InterruptEvent::teardown()
     disableEvent();
 
     if (interruptGuard)
-        interruptGuard->teardown();
+        interruptGuard->removeBreakpoint(targetPA);
 }
 
 InterruptEvent::~InterruptEvent()
@@ -81,18 +89,24 @@ InterruptEvent::~InterruptEvent()
 
 void InterruptEvent::setupVmiInterruptEvent()
 {
-    if (interruptsByPA.find(targetPA) != interruptsByPA.end())
+    if (!interruptsByPA.insert(targetPA, this))
     {
         throw VmiException(
             fmt::format("{}: Interrupt already registered at this address: {}", __func__, targetPAString));
     }
-    interruptsByPA[targetPA] = this;
 }
 
 void InterruptEvent::enableEvent()
 {
 #if defined(X86_64)
-    vmiInterface->write8PA(targetPA, INT3_BREAKPOINT);
+    if (altP2mEngine)
+    {
+        altP2mEngine->setBreakpoint(targetPA, INT3_BREAKPOINT);
+    }
+    else
+    {
+        vmiInterface->write8PA(targetPA, INT3_BREAKPOINT);
+    }
 #elif defined(ARM64)
     vmiInterface->write32PA(targetPA, BRK64_BREAKPOINT);
 #endif
@@ -102,7 +116,14 @@ void InterruptEvent::enableEvent()
 void InterruptEvent::disableEvent()
 {
 #if defined(X86_64)
-    vmiInterface->write8PA(targetPA, originalValue);
+    if (altP2mEngine)
+    {
+        altP2mEngine->removeBreakpoint(targetPA, originalValue);
+    }
+    else
+    {
+        vmiInterface->write8PA(targetPA, originalValue);
+    }
 #elif defined(ARM64)
     vmiInterface->write32PA(targetPA, originalValue);
 #endif
@@ -114,6 +135,11 @@ registers_t* InterruptEvent::getRegisters()
     return (registers_t*)event.x86_regs;
 }
 
+uint32_t InterruptEvent::getVcpuId()
+{
+    return event.vcpu_id;
+}
+
 void InterruptEvent::storeOriginalValue()
 {
 #if defined(X86_64)
@@ -154,10 +180,9 @@ event_response_t InterruptEvent::_defaultInterruptCallback(vmi_instance_t vmi, v
             vmi_pagetable_lookup(vmi, event->arm_regs->ttbr1 & VMI_BIT_MASK(12, 47), event->arm_regs->pc, &eventPA))
             throw std::runtime_error("Failed address translation of breakpoint hit.");
 #endif
-        auto interruptEventIterator = interruptsByPA.find(eventPA);
-        if (interruptEventIterator != interruptsByPA.end())
+        if (auto* interruptEvent = interruptsByPA.find(eventPA))
         {
-            eventResponse = interruptEventIterator->second->interruptCallback(event->vcpu_id);
+            eventResponse = interruptEvent->interruptCallback(event);
             event->interrupt_event.reinject = DONT_REINJECT_INTERRUPT;
         }
         else
@@ -179,10 +204,10 @@ event_response_t InterruptEvent::_defaultInterruptCallback(vmi_instance_t vmi, v
     return eventResponse;
 }
 
-event_response_t InterruptEvent::interruptCallback(uint32_t vcpuId)
+event_response_t InterruptEvent::interruptCallback(vmi_event_t* vmiEvent)
 {
-    vmiInterface->flushV2PCache(LibvmiInterface::flushAllPTs);
-    vmiInterface->flushPageCache();
+    ScopedLatencyRecorder latencyRecorder(callbackLatency.get());
+    vmiInterface->invalidateCaches();
 
     InterruptResponse response;
     try
@@ -194,10 +219,14 @@ event_response_t InterruptEvent::interruptCallback(uint32_t vcpuId)
         throw std::runtime_error(
             fmt::format("{}: {} Target physical address = {}", __func__, e.what(), targetPAString));
     }
+    if (altP2mEngine && response == InterruptResponse::Continue)
+    {
+        return altP2mEngine->stepInHostView(vmiEvent);
+    }
     disableEvent();
     if (response == InterruptResponse::Continue)
     {
-        singleStepSupervisor->setSingleStepCallback(vcpuId, singleStepCallbackFunction);
+        singleStepSupervisor->setSingleStepCallback(vmiEvent->vcpu_id, singleStepCallbackFunction);
     }
     return VMI_EVENT_RESPONSE_NONE;
 }
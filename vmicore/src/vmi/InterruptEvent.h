@@ -2,7 +2,9 @@
 #define VMICORE_INTERRUPTEVENT_H
 
 #include "../io/ILogging.h"
+#include "AltP2mBreakpointEngine.h"
 #include "Event.h"
+#include "EventMetrics.h"
 #include "InterruptGuard.h"
 #include "SingleStepSupervisor.h"
 #include <config.h>
@@ -25,8 +27,10 @@ class InterruptEvent final : public Event, public std::enable_shared_from_this<I
     InterruptEvent(std::shared_ptr<ILibvmiInterface> vmiInterface,
                    uint64_t targetPA,
                    std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor,
-                   std::unique_ptr<InterruptGuard> interruptGuard,
+                   std::shared_ptr<InterruptGuard> interruptGuard,
+                   std::shared_ptr<AltP2mBreakpointEngine> altP2mEngine,
                    std::function<InterruptResponse(InterruptEvent&)> callbackFunction,
+                   std::shared_ptr<LatencyHistogram> callbackLatency,
                    std::unique_ptr<ILogger> logger);
 
     ~InterruptEvent() override;
@@ -37,6 +41,8 @@ class InterruptEvent final : public Event, public std::enable_shared_from_this<I
 
     static registers_t* getRegisters();
 
+    static uint32_t getVcpuId();
+
     static void initializeInterruptEventHandling(ILibvmiInterface& vmiInterface);
 
     static void clearInterruptEventHandling(ILibvmiInterface& vmiInterface);
@@ -63,9 +69,14 @@ class InterruptEvent final : public Event, public std::enable_shared_from_this<I
   private:
     uint64_t targetPA;
     std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor;
-    std::unique_ptr<InterruptGuard> interruptGuard;
+    // Shared with all other interrupt events on the same frame
+    std::shared_ptr<InterruptGuard> interruptGuard;
+    // Breakpoints are patched into guest memory and re-armed after a single step if not set
+    std::shared_ptr<AltP2mBreakpointEngine> altP2mEngine;
     std::function<InterruptResponse(InterruptEvent&)> callbackFunction;
     std::function<void(vmi_event_t*)> singleStepCallbackFunction;
+    // Time the vCPU is blocked by interruptCallback
+    std::shared_ptr<LatencyHistogram> callbackLatency;
     std::string targetPAString;
 
 #if defined(X86_64)
@@ -82,7 +93,7 @@ class InterruptEvent final : public Event, public std::enable_shared_from_this<I
 
     void storeOriginalValue();
 
-    event_response_t interruptCallback(uint32_t vcpuId);
+    event_response_t interruptCallback(vmi_event_t* vmiEvent);
 
     void singleStepCallback(vmi_event_t* singleStepEvent);
 };
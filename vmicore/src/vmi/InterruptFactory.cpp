@@ -1,15 +1,21 @@
 #include "InterruptFactory.h"
 #include "../io/grpc/GRPCLogger.h"
+#include "../os/PagingDefinitions.h"
 #include "InterruptGuard.h"
 #include <config.h>
+#include <fmt/core.h>
 #include <memory>
 
-InterruptFactory::InterruptFactory(std::shared_ptr<ILibvmiInterface> vmiInterface,
+InterruptFactory::InterruptFactory(std::shared_ptr<IConfigParser> configInterface,
+                                   std::shared_ptr<ILibvmiInterface> vmiInterface,
                                    std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor,
-                                   std::shared_ptr<ILogging> loggingLib)
+                                   std::shared_ptr<ILogging> loggingLib,
+                                   std::shared_ptr<EventMetrics> eventMetrics)
     : vmiInterface(std::move(vmiInterface)),
       singleStepSupervisor(std::move(singleStepSupervisor)),
-      loggingLib(std::move(loggingLib))
+      loggingLib(std::move(loggingLib)),
+      eventMetrics(std::move(eventMetrics)),
+      breakpointEngine(parseBreakpointEngine(configInterface->getBreakpointEngine()))
 {
 }
 
@@ -17,11 +23,22 @@ void InterruptFactory::initialize()
 {
     InterruptEvent::initializeInterruptEventHandling(*vmiInterface);
     singleStepSupervisor->initializeSingleStepEvents();
+    if (breakpointEngine == BreakpointEngine::AltP2m && !altP2mEngine)
+    {
+        altP2mEngine = std::make_shared<AltP2mBreakpointEngine>(vmiInterface, singleStepSupervisor, loggingLib);
+        altP2mEngine->initialize();
+    }
 }
 
 void InterruptFactory::teardown()
 {
     InterruptEvent::clearInterruptEventHandling(*vmiInterface);
+    interruptGuardsByGFN.clear();
+    if (altP2mEngine)
+    {
+        altP2mEngine->teardown();
+        altP2mEngine.reset();
+    }
     singleStepSupervisor->teardown();
 }
 
@@ -31,30 +48,69 @@ std::shared_ptr<InterruptEvent> InterruptFactory::createInterruptEvent(
     uint64_t systemCr3,
     std::function<InterruptEvent::InterruptResponse(InterruptEvent&)> callbackFunction)
 {
-
+    auto callbackLatency = eventMetrics->getLatencyHistogram(interruptName);
     auto targetPA = vmiInterface->convertVAToPA(targetVA, systemCr3);
 
 #if defined(X86_64)
-    auto interruptGuard = std::make_unique<InterruptGuard>(
-        vmiInterface, loggingLib->newNamedLogger(interruptName), targetVA, targetPA, systemCr3);
-
-    interruptGuard->initialize();
+    // The altp2m engine hides its breakpoints from the guest itself
+    auto interruptGuard =
+        altP2mEngine ? nullptr : getOrCreateInterruptGuard(interruptName, targetVA, targetPA, systemCr3);
 
     auto interruptEvent = std::make_shared<InterruptEvent>(vmiInterface,
                                                            targetPA,
                                                            singleStepSupervisor,
-                                                           std::move(interruptGuard),
+                                                           interruptGuard,
+                                                           altP2mEngine,
                                                            callbackFunction,
+                                                           callbackLatency,
                                                            loggingLib->newNamedLogger(interruptName));
 #elif defined(ARM64)
     auto interruptEvent = std::make_shared<InterruptEvent>(vmiInterface,
                                                            targetPA,
                                                            singleStepSupervisor,
                                                            nullptr,
+                                                           nullptr,
                                                            callbackFunction,
+                                                           callbackLatency,
                                                            loggingLib->newNamedLogger(interruptName));
 #endif
 
     interruptEvent->initialize();
     return interruptEvent;
 }
+
+std::shared_ptr<InterruptGuard> InterruptFactory::getOrCreateInterruptGuard(const std::string& interruptName,
+                                                                             uint64_t targetVA,
+                                                                             uint64_t targetPA,
+                                                                             uint64_t systemCr3)
+{
+    auto gfn = targetPA >> PagingDefinitions::numberOfPageIndexBits;
+    if (auto interruptGuard = interruptGuardsByGFN[gfn].lock())
+    {
+        return interruptGuard;
+    }
+    auto interruptGuard = std::make_shared<InterruptGuard>(vmiInterface,
+                                                           loggingLib->newNamedLogger(interruptName),
+                                                           eventMetrics->getInterruptGuardLatencyHistogram(),
+                                                           targetVA,
+                                                           targetPA,
+                                                           systemCr3);
+    interruptGuard->initialize();
+    interruptGuardsByGFN[gfn] = interruptGuard;
+    return interruptGuard;
+}
+
+BreakpointEngine InterruptFactory::parseBreakpointEngine(const std::string& engine)
+{
+    if (engine == "int3")
+    {
+        return BreakpointEngine::Int3;
+    }
+#if defined(X86_64)
+    if (engine == "altp2m")
+    {
+        return BreakpointEngine::AltP2m;
+    }
+#endif
+    throw std::invalid_argument(fmt::format("{}: Unknown breakpoint engine {}", __func__, engine));
+}
@@ -1,10 +1,14 @@
 #ifndef VMICORE_INTERRUPTFACTORY_H
 #define VMICORE_INTERRUPTFACTORY_H
 
+#include "../config/IConfigParser.h"
 #include "../io/ILogging.h"
+#include "AltP2mBreakpointEngine.h"
+#include "EventMetrics.h"
 #include "InterruptEvent.h"
 #include "LibvmiInterface.h"
 #include "SingleStepSupervisor.h"
+#include <map>
 
 class IInterruptFactory
 {
@@ -23,12 +27,22 @@ class IInterruptFactory
     IInterruptFactory() = default;
 };
 
+enum class BreakpointEngine
+{
+    // Write the breakpoint into guest memory and restore it around a single step on every hit
+    Int3,
+    // Keep the breakpoint in a shadow page of an altp2m execute view, see AltP2mBreakpointEngine
+    AltP2m
+};
+
 class InterruptFactory : public IInterruptFactory
 {
   public:
-    explicit InterruptFactory(std::shared_ptr<ILibvmiInterface> vmiInterface,
+    explicit InterruptFactory(std::shared_ptr<IConfigParser> configInterface,
+                              std::shared_ptr<ILibvmiInterface> vmiInterface,
                               std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor,
-                              std::shared_ptr<ILogging> loggingLib);
+                              std::shared_ptr<ILogging> loggingLib,
+                              std::shared_ptr<EventMetrics> eventMetrics);
 
     ~InterruptFactory() override = default;
 
@@ -40,10 +54,23 @@ class InterruptFactory : public IInterruptFactory
                          uint64_t systemCr3,
                          std::function<InterruptEvent::InterruptResponse(InterruptEvent&)> callbackFunction) override;
 
+    static BreakpointEngine parseBreakpointEngine(const std::string& engine);
+
   private:
     std::shared_ptr<ILibvmiInterface> vmiInterface;
     std::shared_ptr<ISingleStepSupervisor> singleStepSupervisor;
     std::shared_ptr<ILogging> loggingLib;
+    std::shared_ptr<EventMetrics> eventMetrics;
+    BreakpointEngine breakpointEngine;
+    // Only present while the altp2m breakpoint engine is active
+    std::shared_ptr<AltP2mBreakpointEngine> altP2mEngine;
+    // One guard per frame, kept alive by the interrupt events on that frame
+    std::map<uint64_t, std::weak_ptr<InterruptGuard>> interruptGuardsByGFN;
+
+    std::shared_ptr<InterruptGuard> getOrCreateInterruptGuard(const std::string& interruptName,
+                                                              uint64_t targetVA,
+                                                              uint64_t targetPA,
+                                                              uint64_t systemCr3);
 };
 
 #endif // VMICORE_INTERRUPTFACTORY_H
@@ -1,6 +1,7 @@
 #include "InterruptGuard.h"
 #include "../GlobalControl.h"
 #include "../os/PagingDefinitions.h"
+#include <cstring>
 #include <fmt/core.h>
 #include <memory>
 
@@ -11,29 +12,21 @@ namespace
 
 InterruptGuard::InterruptGuard(std::shared_ptr<ILibvmiInterface> vmiInterface,
                                std::unique_ptr<ILogger> logger,
+                               std::shared_ptr<LatencyHistogram> callbackLatency,
                                uint64_t targetVA,
                                uint64_t targetPA,
                                uint64_t systemCr3)
     : Event(std::move(vmiInterface), std::move(logger)),
       targetVA(targetVA),
-      targetPA(targetPA),
-      shadowPage(PagingDefinitions::pageSizeInBytes + 16),
-      systemCr3(systemCr3)
+      targetGFN(targetPA >> PagingDefinitions::numberOfPageIndexBits),
+      shadowPage(PagingDefinitions::pageSizeInBytes + emulatedReadSize),
+      systemCr3(systemCr3),
+      callbackLatency(std::move(callbackLatency))
 {
 }
 
 void InterruptGuard::initialize()
 {
-    // Allocate zeroed memory
-    guardEvent = reinterpret_cast<vmi_event_t*>(calloc(1, sizeof(vmi_event_t)));
-    // setting simple read events is unsupported by EPT
-    SETUP_MEM_EVENT(guardEvent,
-                    targetPA >> PagingDefinitions::numberOfPageIndexBits,
-                    VMI_MEMACCESS_RW,
-                    &InterruptGuard::_guardCallback,
-                    false);
-    guardEvent->data = this;
-
     // This will never change so we initialize this here once
     emulateReadData.dont_free = true;
     emulateReadData.size = 8;
@@ -45,25 +38,52 @@ void InterruptGuard::initialize()
         throw VmiException(fmt::format(
             "{}: Unable to create Interrupt @ {:#x} in system with cr3 {:#x}", __func__, pageBaseVA, systemCr3));
     }
-    enableEvent();
-    logger->debug(
-        "Interrupt guard: Register RW event on gfn",
-        {logfield::create("targetGFN", fmt::format("{:#x}", targetPA >> PagingDefinitions::numberOfPageIndexBits))});
 }
 
 void InterruptGuard::teardown()
 {
-    disableEvent();
+    if (!breakpointOffsets.empty())
+    {
+        breakpointOffsets.clear();
+        disableEvent();
+    }
+}
+
+void InterruptGuard::addBreakpoint(uint64_t targetPA, uint8_t originalValue)
+{
+    auto offset = targetPA & ~PagingDefinitions::stripPageOffsetMask;
+    shadowPage[offset] = originalValue;
+    if (breakpointOffsets.empty())
+    {
+        enableEvent();
+    }
+    breakpointOffsets.insert(offset);
+}
+
+void InterruptGuard::removeBreakpoint(uint64_t targetPA)
+{
+    if (breakpointOffsets.erase(targetPA & ~PagingDefinitions::stripPageOffsetMask) > 0 && breakpointOffsets.empty())
+    {
+        disableEvent();
+    }
 }
 
 void InterruptGuard::enableEvent()
 {
+    // Allocate zeroed memory. Freed by libvmi when the event is cleared.
+    guardEvent = reinterpret_cast<vmi_event_t*>(calloc(1, sizeof(vmi_event_t)));
+    // setting simple read events is unsupported by EPT
+    SETUP_MEM_EVENT(guardEvent, targetGFN, VMI_MEMACCESS_RW, &InterruptGuard::_guardCallback, false);
+    guardEvent->data = this;
     vmiInterface->registerEvent(*guardEvent);
+    logger->debug("Interrupt guard: Register RW event on gfn",
+                  {logfield::create("targetGFN", fmt::format("{:#x}", targetGFN))});
 }
 
 void InterruptGuard::disableEvent()
 {
     vmiInterface->clearEvent(*guardEvent, true);
+    guardEvent = nullptr;
 }
 
 event_response_t InterruptGuard::_guardCallback(__attribute__((unused)) vmi_instance_t vmiInstance, vmi_event_t* event)
@@ -85,6 +105,7 @@ event_response_t InterruptGuard::_guardCallback(__attribute__((unused)) vmi_inst
 
 event_response_t InterruptGuard::guardCallback(vmi_event_t* event)
 {
+    ScopedLatencyRecorder latencyRecorder(callbackLatency.get());
     auto eventPA = (event->mem_event.gfn << PagingDefinitions::numberOfPageIndexBits) + event->mem_event.offset;
     if (!interruptGuardHit)
     {
@@ -92,11 +113,12 @@ event_response_t InterruptGuard::guardCallback(vmi_event_t* event)
         interruptGuardHit = true;
     }
     logger->debug("Interrupt guard hit", {logfield::create("eventPA", fmt::format("{:#x}", eventPA))});
-    event->emul_read = &emulateReadData;
-    // we are allowed to provide more data than actually needed but empirically no more than 16 bytes are read at a time
-    for (int i = 0; i < 16; ++i)
+    if (event->mem_event.offset >= PagingDefinitions::pageSizeInBytes)
     {
-        event->emul_read->data[i] = shadowPage.at(event->mem_event.offset + i);
+        throw VmiException(fmt::format("{}: Invalid offset {:#x} in guarded page", __func__, event->mem_event.offset));
     }
+    event->emul_read = &emulateReadData;
+    // we are allowed to provide more data than actually needed but empirically no more than 16 bytes are read at a time
+    std::memcpy(event->emul_read->data, &shadowPage[event->mem_event.offset], emulatedReadSize);
     return VMI_EVENT_RESPONSE_SET_EMUL_READ_DATA;
 }
@@ -4,13 +4,21 @@
 #define INT3_BREAKPOINT 0xCC
 
 #include "Event.h"
+#include "EventMetrics.h"
 #include "SingleStepSupervisor.h"
+#include <set>
 
+// Hides all breakpoints on one guest frame from the guest. Shared by every InterruptEvent on that frame, so there is
+// only one mem event and one shadow copy per GFN. The mem event is registered while at least one breakpoint is set.
 class InterruptGuard final : public Event
 {
   public:
+    // Emulated reads never cross more than this many bytes past the trapped offset
+    static constexpr size_t emulatedReadSize = 16;
+
     InterruptGuard(std::shared_ptr<ILibvmiInterface> vmiInterface,
                    std::unique_ptr<ILogger> logger,
+                   std::shared_ptr<LatencyHistogram> callbackLatency,
                    uint64_t targetVA,
                    uint64_t targetPA,
                    uint64_t systemCr3);
@@ -21,14 +29,22 @@ class InterruptGuard final : public Event
 
     void teardown() override;
 
+    // Keeps originalValue visible to the guest at targetPA
+    void addBreakpoint(uint64_t targetPA, uint8_t originalValue);
+
+    void removeBreakpoint(uint64_t targetPA);
+
   private:
     uint64_t targetVA;
-    uint64_t targetPA;
+    uint64_t targetGFN;
     vmi_event* guardEvent{};
     std::vector<uint8_t> shadowPage;
     uint64_t systemCr3;
     emul_read_t emulateReadData{};
     bool interruptGuardHit = false;
+    std::shared_ptr<LatencyHistogram> callbackLatency;
+    // Page offsets of the breakpoints on this frame
+    std::set<uint64_t> breakpointOffsets;
 
     void enableEvent() override;
 
@@ -0,0 +1,34 @@
+#include "KernelDtbCache.h"
+#include "LibvmiInterface.h"
+#include "VmiException.h"
+#include <fmt/core.h>
+
+KernelDtbCache::KernelDtbCache(ILibvmiInterface& vmiInterface) : vmiInterface(vmiInterface) {}
+
+void KernelDtbCache::setKernelPid(pid_t pid)
+{
+    kernelPid = pid;
+}
+
+uint64_t KernelDtbCache::get()
+{
+    auto dtb = kernelDtb.load();
+    if (dtb != 0)
+    {
+        return dtb;
+    }
+
+    std::lock_guard<std::mutex> lock(resolveLock);
+    dtb = kernelDtb.load();
+    if (dtb == 0)
+    {
+        auto pid = kernelPid.load();
+        if (pid == unknownPid)
+        {
+            throw VmiException(fmt::format("{}: Unable to determine kernel dtb for unknown kernel process", __func__));
+        }
+        dtb = vmiInterface.convertPidToDtb(pid);
+        kernelDtb = dtb;
+    }
+    return dtb;
+}
@@ -0,0 +1,32 @@
+#ifndef VMICORE_KERNELDTBCACHE_H
+#define VMICORE_KERNELDTBCACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <sys/types.h>
+
+class ILibvmiInterface;
+
+// Resolves the DTB of the kernel address space from the page tables of a kernel process on first use. These page tables
+// stay in place as long as the guest kernel runs, so the DTB is never resolved again.
+class KernelDtbCache
+{
+  public:
+    explicit KernelDtbCache(ILibvmiInterface& vmiInterface);
+
+    // The kernel process depends on the operating system, e.g. the System process on Windows
+    void setKernelPid(pid_t pid);
+
+    [[nodiscard]] uint64_t get();
+
+  private:
+    static constexpr pid_t unknownPid = -1;
+
+    ILibvmiInterface& vmiInterface;
+    std::atomic<pid_t> kernelPid = unknownPid;
+    std::mutex resolveLock{};
+    std::atomic<uint64_t> kernelDtb = 0;
+};
+
+#endif // VMICORE_KERNELDTBCACHE_H
@@ -0,0 +1,77 @@
+#include "LatencyHistogram.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+void LatencyHistogram::record(uint64_t valueNanoseconds)
+{
+    counts[getBucketIndex(valueNanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    totalNanoseconds.fetch_add(valueNanoseconds, std::memory_order_relaxed);
+
+    auto currentMax = maxNanoseconds.load(std::memory_order_relaxed);
+    while (valueNanoseconds > currentMax &&
+           !maxNanoseconds.compare_exchange_weak(currentMax, valueNanoseconds, std::memory_order_relaxed))
+    {
+    }
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration)
+{
+    record(static_cast<uint64_t>(std::max(duration.count(), std::chrono::nanoseconds::rep{0})));
+}
+
+uint64_t LatencyHistogram::getCount() const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getTotalNanoseconds() const
+{
+    return totalNanoseconds.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getMaxNanoseconds() const
+{
+    return maxNanoseconds.load(std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::getValueAtPercentile(double percentile) const
+{
+    auto maxValue = getMaxNanoseconds();
+    auto targetCount =
+        std::max(uint64_t{1}, static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 *
+                                                              static_cast<double>(getCount()))));
+    uint64_t accumulatedCount = 0;
+    for (size_t bucketIndex = 0; bucketIndex < numberOfBuckets; bucketIndex++)
+    {
+        accumulatedCount += counts[bucketIndex].load(std::memory_order_relaxed);
+        if (accumulatedCount >= targetCount)
+        {
+            return std::min(getHighestEquivalentValue(bucketIndex), maxValue);
+        }
+    }
+    // Only reached if nothing has been recorded or if records are in flight
+    return maxValue;
+}
+
+size_t LatencyHistogram::getBucketIndex(uint64_t value)
+{
+    if (value < 2 * subBucketCount)
+    {
+        return value;
+    }
+    auto shift = static_cast<size_t>(std::bit_width(value)) - 1 - subBucketBits;
+    return shift * subBucketCount + (value >> shift);
+}
+
+uint64_t LatencyHistogram::getHighestEquivalentValue(size_t bucketIndex)
+{
+    if (bucketIndex < 2 * subBucketCount)
+    {
+        return bucketIndex;
+    }
+    auto shift = bucketIndex / subBucketCount - 1;
+    auto subBucket = static_cast<uint64_t>(bucketIndex - shift * subBucketCount);
+    return (subBucket << shift) + ((uint64_t{1} << shift) - 1);
+}
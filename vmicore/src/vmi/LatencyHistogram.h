@@ -0,0 +1,44 @@
+#ifndef VMICORE_LATENCYHISTOGRAM_H
+#define VMICORE_LATENCYHISTOGRAM_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+// Latency histogram with HdrHistogram style log-linear buckets. Every power of two range is split into
+// subBucketCount linear sub-buckets, so a reported value is at most 1/subBucketCount above the recorded one. Values
+// below 2 * subBucketCount are recorded exactly. Recording is lock free and may happen from any number of threads.
+class LatencyHistogram
+{
+  public:
+    static constexpr size_t subBucketBits = 4;
+    static constexpr size_t subBucketCount = 1 << subBucketBits;
+    static constexpr size_t numberOfBuckets = (64 - subBucketBits + 1) * subBucketCount;
+
+    void record(uint64_t valueNanoseconds);
+
+    void record(std::chrono::nanoseconds duration);
+
+    [[nodiscard]] uint64_t getCount() const;
+
+    [[nodiscard]] uint64_t getTotalNanoseconds() const;
+
+    [[nodiscard]] uint64_t getMaxNanoseconds() const;
+
+    // Highest value that is equivalent to the value at the given percentile, capped by the maximum recorded value
+    [[nodiscard]] uint64_t getValueAtPercentile(double percentile) const;
+
+    [[nodiscard]] static size_t getBucketIndex(uint64_t value);
+
+    [[nodiscard]] static uint64_t getHighestEquivalentValue(size_t bucketIndex);
+
+  private:
+    std::array<std::atomic<uint64_t>, numberOfBuckets> counts{};
+    std::atomic<uint64_t> count = 0;
+    std::atomic<uint64_t> totalNanoseconds = 0;
+    std::atomic<uint64_t> maxNanoseconds = 0;
+};
+
+#endif // VMICORE_LATENCYHISTOGRAM_H
@@ -1,7 +1,10 @@
 #include "LibvmiInterface.h"
 #include "../GlobalControl.h"
 #include "../io/grpc/GRPCLogger.h"
+#include "../os/PageTableWalker.h"
 #include "../os/PagingDefinitions.h"
+#include "MemoryMapping.h"
+#include "Utf16Converter.h"
 #include "VmiInitData.h"
 #include <fmt/core.h>
 #include <utility>
@@ -9,12 +12,28 @@
 namespace
 {
     LibvmiInterface* libvmiInterfaceInstance = nullptr;
+
+    // Layout of _UNICODE_STRING on 64 bit guests
+    struct UnicodeString
+    {
+        uint16_t length;
+        uint16_t maximumLength;
+        uint32_t padding;
+        uint64_t buffer;
+    };
+    static_assert(sizeof(UnicodeString) == 16);
 }
 
 LibvmiInterface::LibvmiInterface(std::shared_ptr<IConfigParser> configInterface,
                                  std::shared_ptr<ILogging> loggingLib,
-                                 std::shared_ptr<IEventStream> eventStream)
-    : configInterface(std::move(configInterface)), logger(NEW_LOGGER(loggingLib)), eventStream(std::move(eventStream))
+                                 std::shared_ptr<IEventStream> eventStream,
+                                 std::shared_ptr<EventMetrics> eventMetrics)
+    : configInterface(std::move(configInterface)),
+      loggingLib(std::move(loggingLib)),
+      logger(NEW_LOGGER(this->loggingLib)),
+      eventStream(std::move(eventStream)),
+      eventMetrics(std::move(eventMetrics)),
+      pageTableWalker(std::make_unique<PageTableWalker>(*this))
 {
     if (libvmiInterfaceInstance != nullptr)
     {
@@ -25,6 +44,16 @@ LibvmiInterface::LibvmiInterface(std::shared_ptr<IConfigParser> configInterface,
 
 LibvmiInterface::~LibvmiInterface()
 {
+    auto utilization = getReadHandleUtilization();
+    for (size_t handleIndex = 0; handleIndex < utilization.size(); handleIndex++)
+    {
+        auto busyTime = std::chrono::duration_cast<std::chrono::milliseconds>(utilization[handleIndex].busyTime);
+        logger->info("Read handle utilization",
+                     {logfield::create("handle", static_cast<uint64_t>(handleIndex)),
+                      logfield::create("reads", utilization[handleIndex].numberOfReads),
+                      logfield::create("busyMs", static_cast<uint64_t>(busyTime.count()))});
+    }
+    readHandlePool.reset();
     vmi_resume_vm(vmiInstance);
     vmi_destroy(vmiInstance);
     libvmiInterfaceInstance = nullptr;
@@ -35,13 +64,23 @@ void LibvmiInterface::initializeVmi()
     logger->info("Initialize libvmi", {logfield::create("domain", configInterface->getVmName())});
     logger->info("Initialize successfully initialized", {logfield::create("domain", configInterface->getVmName())});
 
+    initializeLibvmi(
+        configInterface->getVmName(), VMI_INIT_DOMAINNAME | VMI_INIT_EVENTS, configInterface->getSocketPath());
+}
+
+void LibvmiInterface::initializeLibvmi(const std::string& domain,
+                                       uint64_t initFlags,
+                                       const std::filesystem::path& socketPath)
+{
+    translationCacheInvalidator.setPolicy(parseCacheInvalidationPolicy(configInterface->getCacheInvalidationPolicy()));
+    eventListenTimeoutMilliseconds = configInterface->getEventListenTimeoutMilliseconds();
     auto configString = createConfigString(configInterface->getOffsetsFile());
-    auto initData = VmiInitData(configInterface->getSocketPath());
+    auto initData = VmiInitData(socketPath);
     vmi_init_error initError;
 
     if (vmi_init_complete(&vmiInstance,
-                          reinterpret_cast<const void*>(configInterface->getVmName().c_str()),
-                          VMI_INIT_DOMAINNAME | VMI_INIT_EVENTS,
+                          reinterpret_cast<const void*>(domain.c_str()),
+                          initFlags,
                           initData.data,
                           VMI_CONFIG_STRING,
                           reinterpret_cast<void*>(const_cast<char*>(configString->c_str())),
@@ -51,6 +90,52 @@ void LibvmiInterface::initializeVmi()
     }
 
     numberOfVCPUs = vmi_get_num_vcpus(vmiInstance);
+    isPageTableWalkerSupported = isFourLevelPaging();
+    logger->info("Range translation", {logfield::create("pageTableWalker", isPageTableWalkerSupported)});
+
+    if (configInterface->getNumberOfReadHandles() > 0)
+    {
+        vmi_mode_t accessMode{};
+        if (vmi_get_access_mode(vmiInstance, nullptr, 0, nullptr, &accessMode) == VMI_FAILURE)
+        {
+            throw VmiException(fmt::format("{}: Unable to determine the libvmi access mode", __func__));
+        }
+        validateNumberOfReadHandles(accessMode, configInterface->getNumberOfReadHandles());
+        initializeReadHandlePool(domain, initFlags, socketPath, *configString);
+    }
+}
+
+void LibvmiInterface::initializeReadHandlePool(const std::string& domain,
+                                               uint64_t initFlags,
+                                               const std::filesystem::path& socketPath,
+                                               const std::string& configString)
+{
+    std::vector<vmi_instance_t> readInstances;
+    for (uint i = 0; i < configInterface->getNumberOfReadHandles(); i++)
+    {
+        auto initData = VmiInitData(socketPath);
+        vmi_instance_t readInstance{};
+        vmi_init_error initError;
+        // Events can only be handled by a single session per domain
+        if (vmi_init_complete(&readInstance,
+                              reinterpret_cast<const void*>(domain.c_str()),
+                              initFlags & ~static_cast<uint64_t>(VMI_INIT_EVENTS),
+                              initData.data,
+                              VMI_CONFIG_STRING,
+                              reinterpret_cast<void*>(const_cast<char*>(configString.c_str())),
+                              &initError) == VMI_FAILURE)
+        {
+            for (auto* initializedInstance : readInstances)
+            {
+                vmi_destroy(initializedInstance);
+            }
+            throw VmiInitError(initError);
+        }
+        readInstances.push_back(readInstance);
+    }
+    readHandlePool = std::make_unique<VmiReadHandlePool>(readInstances);
+    logger->info("Initialized read handle pool",
+                 {logfield::create("handles", static_cast<uint64_t>(readInstances.size()))});
 }
 
 std::unique_ptr<std::string> LibvmiInterface::createConfigString(const std::string& offsetsFile)
@@ -82,8 +167,9 @@ uint8_t LibvmiInterface::read8PA(const uint64_t physicalAddress)
 {
     uint8_t extractedValue = 0;
     auto accessContext = createPhysicalAddressAccessContext(physicalAddress);
-    std::lock_guard<std::mutex> lock(libvmiLock);
-    if (vmi_read_8(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+    numberOfLibvmiCalls++;
+    auto read = [&](vmi_instance_t instance) { return vmi_read_8(instance, &accessContext, &extractedValue); };
+    if (readWithHandle(read) == VMI_FAILURE)
     {
         throw VmiException(fmt::format("{}: Unable to read one byte from PA: {:#x}", __func__, physicalAddress));
     }
@@ -94,65 +180,182 @@ uint32_t LibvmiInterface::read32PA(const uint64_t physicalAddress)
 {
     uint32_t extractedValue = 0;
     auto accessContext = createPhysicalAddressAccessContext(physicalAddress);
-    std::lock_guard<std::mutex> lock(libvmiLock);
-    if (vmi_read_32(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+    numberOfLibvmiCalls++;
+    auto read = [&](vmi_instance_t instance) { return vmi_read_32(instance, &accessContext, &extractedValue); };
+    if (readWithHandle(read) == VMI_FAILURE)
     {
         throw VmiException(fmt::format("{}: Unable to read four byte from PA: {:#x}", __func__, physicalAddress));
     }
     return extractedValue;
 }
 
+bool LibvmiInterface::readPA(const uint64_t physicalAddress, std::span<uint8_t> content)
+{
+    numberOfLibvmiCalls++;
+    return readWithHandle([&](vmi_instance_t instance) {
+               return vmi_read_pa(instance, physicalAddress, content.size(), content.data(), nullptr);
+           }) == VMI_SUCCESS;
+}
+
 uint8_t LibvmiInterface::read8VA(const uint64_t virtualAddress, const uint64_t cr3)
+{
+    auto extractedValue = tryRead8VA(virtualAddress, cr3);
+    if (!extractedValue)
+    {
+        throw VmiException(fmt::format("{}: Unable to read one byte from VA: {:#x}", __func__, virtualAddress));
+    }
+    return *extractedValue;
+}
+
+std::optional<uint8_t> LibvmiInterface::tryRead8VA(const uint64_t virtualAddress, const uint64_t cr3)
 {
     uint8_t extractedValue = 0;
+    expireStaleTranslations(cr3);
     auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-    std::lock_guard<std::mutex> lock(libvmiLock);
-    if (vmi_read_8(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+    numberOfLibvmiCalls++;
+    auto read = [&](vmi_instance_t instance) { return vmi_read_8(instance, &accessContext, &extractedValue); };
+    if (readWithHandle(read) == VMI_FAILURE)
     {
-        throw VmiException(fmt::format("{}: Unable to read one byte from VA: {:#x}", __func__, virtualAddress));
+        return std::nullopt;
     }
     return extractedValue;
 }
 
 uint32_t LibvmiInterface::read32VA(const uint64_t virtualAddress, const uint64_t cr3)
+{
+    auto extractedValue = tryRead32VA(virtualAddress, cr3);
+    if (!extractedValue)
+    {
+        throw VmiException(fmt::format("{}: Unable to read 4 bytes from VA {:#x}", __func__, virtualAddress));
+    }
+    return *extractedValue;
+}
+
+std::optional<uint32_t> LibvmiInterface::tryRead32VA(const uint64_t virtualAddress, const uint64_t cr3)
 {
     uint32_t extractedValue = 0;
+    expireStaleTranslations(cr3);
     auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-    std::lock_guard<std::mutex> lock(libvmiLock);
-    if (vmi_read_32(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+    numberOfLibvmiCalls++;
+    auto read = [&](vmi_instance_t instance) { return vmi_read_32(instance, &accessContext, &extractedValue); };
+    if (readWithHandle(read) == VMI_FAILURE)
     {
-        throw VmiException(fmt::format("{}: Unable to read 4 bytes from VA {:#x}", __func__, virtualAddress));
+        return std::nullopt;
     }
     return extractedValue;
 }
 
 uint64_t LibvmiInterface::read64VA(const uint64_t virtualAddress, const uint64_t cr3)
+{
+    auto extractedValue = tryRead64VA(virtualAddress, cr3);
+    if (!extractedValue)
+    {
+        throw VmiException(fmt::format("{}: Unable to read 8 bytes from VA {:#x}", __func__, virtualAddress));
+    }
+    return *extractedValue;
+}
+
+std::optional<uint64_t> LibvmiInterface::tryRead64VA(const uint64_t virtualAddress, const uint64_t cr3)
 {
     uint64_t extractedValue = 0;
+    expireStaleTranslations(cr3);
     auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-    std::lock_guard<std::mutex> lock(libvmiLock);
-    if (vmi_read_64(vmiInstance, &accessContext, &extractedValue) == VMI_FAILURE)
+    numberOfLibvmiCalls++;
+    auto read = [&](vmi_instance_t instance) { return vmi_read_64(instance, &accessContext, &extractedValue); };
+    if (readWithHandle(read) == VMI_FAILURE)
     {
-        throw VmiException(fmt::format("{}: Unable to read 8 bytes from VA {:#x}", __func__, virtualAddress));
+        return std::nullopt;
     }
     return extractedValue;
 }
 
 bool LibvmiInterface::readXVA(const uint64_t virtualAddress, const uint64_t cr3, std::vector<uint8_t>& content)
 {
+    expireStaleTranslations(cr3);
     auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-    std::lock_guard<std::mutex> lock(libvmiLock);
-    if (vmi_read(vmiInstance, &accessContext, content.size(), content.data(), nullptr) != VMI_SUCCESS)
+    numberOfLibvmiCalls++;
+    return readWithHandle([&](vmi_instance_t instance) {
+               return vmi_read(instance, &accessContext, content.size(), content.data(), nullptr);
+           }) == VMI_SUCCESS;
+}
+
+uint8_t LibvmiInterface::readKernel8(const uint64_t virtualAddress)
+{
+    return read8VA(virtualAddress, getKernelDtb());
+}
+
+uint32_t LibvmiInterface::readKernel32(const uint64_t virtualAddress)
+{
+    return read32VA(virtualAddress, getKernelDtb());
+}
+
+uint64_t LibvmiInterface::readKernel64(const uint64_t virtualAddress)
+{
+    return read64VA(virtualAddress, getKernelDtb());
+}
+
+std::optional<uint64_t> LibvmiInterface::tryReadKernel64(const uint64_t virtualAddress)
+{
+    return tryRead64VA(virtualAddress, getKernelDtb());
+}
+
+bool LibvmiInterface::readBatchVA(const uint64_t cr3, std::span<ReadRequest> requests)
+{
+    expireStaleTranslations(cr3);
+    auto accessContext = createVirtualAddressAccessContext(0, cr3);
+    numberOfLibvmiCalls += requests.size();
+    return readWithHandle(
+        [&](vmi_instance_t instance)
+        {
+            bool allSucceeded = true;
+            for (auto& request : requests)
+            {
+                accessContext.addr = request.virtualAddress;
+                request.success =
+                    vmi_read(instance, &accessContext, request.size, request.destination, nullptr) == VMI_SUCCESS;
+                allSucceeded &= request.success;
+            }
+            return allSucceeded;
+        });
+}
+
+void ILibvmiInterface::readBatchVAOrThrow(uint64_t cr3, std::span<ReadRequest> requests, const char* caller)
+{
+    if (readBatchVA(cr3, requests))
     {
-        return false;
+        return;
+    }
+    for (const auto& request : requests)
+    {
+        if (!request.success)
+        {
+            throw VmiException(fmt::format(
+                "{}: Unable to read {} bytes from VA {:#x}", caller, request.size, request.virtualAddress));
+        }
+    }
+}
+
+std::unique_ptr<IMemoryMapping> LibvmiInterface::mmapGuest(uint64_t baseVA, uint64_t cr3, size_t numberOfPages)
+{
+    expireStaleTranslations(cr3);
+    auto accessContext = createVirtualAddressAccessContext(baseVA, cr3);
+    auto accessPointers = std::vector<void*>(numberOfPages);
+    numberOfLibvmiCalls++;
+    if (readWithHandle([&](vmi_instance_t instance)
+                       { return vmi_mmap_guest(instance, &accessContext, numberOfPages, accessPointers.data()); }) !=
+        VMI_SUCCESS)
+    {
+        // libvmi also fails if none of the pages is present, which is not an error from the caller's point of view
+        accessPointers.assign(numberOfPages, nullptr);
     }
-    return true;
+    return std::make_unique<MemoryMapping>(baseVA, accessPointers, loggingLib);
 }
 
 void LibvmiInterface::write8PA(const uint64_t physicalAddress, uint8_t value)
 {
     auto accessContext = createPhysicalAddressAccessContext(physicalAddress);
     std::lock_guard<std::mutex> lock(libvmiLock);
+    numberOfLibvmiCalls++;
     if (vmi_write_8(vmiInstance, &accessContext, &value) == VMI_FAILURE)
     {
         throw VmiException(fmt::format("{}: Unable to write {:#x} to PA {:#x}", __func__, value, physicalAddress));
@@ -163,12 +366,26 @@ void LibvmiInterface::write32PA(const uint64_t physicalAddress, uint32_t value)
 {
     auto accessContext = createPhysicalAddressAccessContext(physicalAddress);
     std::lock_guard<std::mutex> lock(libvmiLock);
+    numberOfLibvmiCalls++;
     if (vmi_write_32(vmiInstance, &accessContext, &value) == VMI_FAILURE)
     {
         throw VmiException(fmt::format("{}: Unable to write {:#x} to PA {:#x}", __func__, value, physicalAddress));
     }
 }
 
+void LibvmiInterface::writePA(uint64_t physicalAddress, std::span<const uint8_t> content)
+{
+    auto accessContext = createPhysicalAddressAccessContext(physicalAddress);
+    std::lock_guard<std::mutex> lock(libvmiLock);
+    numberOfLibvmiCalls++;
+    if (vmi_write(vmiInstance, &accessContext, content.size(), const_cast<uint8_t*>(content.data()), nullptr) !=
+        VMI_SUCCESS)
+    {
+        throw VmiException(
+            fmt::format("{}: Unable to write {} bytes to PA {:#x}", __func__, content.size(), physicalAddress));
+    }
+}
+
 access_context_t LibvmiInterface::createPhysicalAddressAccessContext(uint64_t physicalAddress)
 {
     access_context_t accessContext{};
@@ -188,9 +405,36 @@ access_context_t LibvmiInterface::createVirtualAddressAccessContext(uint64_t vir
     return accessContext;
 }
 
-void LibvmiInterface::waitForEvent()
+uint LibvmiInterface::waitForEvent()
 {
-    auto status = vmi_events_listen(vmiInstance, 500);
+    if (!GlobalControl::consumeEventLoopWakeup())
+    {
+        listenForEvents(eventListenTimeoutMilliseconds);
+    }
+    // Events that arrived while the callbacks were running are processed before going back to sleep
+    uint drainRounds = 0;
+    while (areEventsPending())
+    {
+        listenForEvents(0);
+        drainRounds++;
+    }
+    return drainRounds;
+}
+
+void LibvmiInterface::listenForEvents(uint timeoutMilliseconds)
+{
+    // An interrupted poll is not an error for libvmi, so wakeups end up here as a regular return. Calls that do not
+    // block are not interrupted.
+    auto isBlocking = timeoutMilliseconds > 0;
+    if (isBlocking)
+    {
+        GlobalControl::enterEventLoopListen();
+    }
+    auto status = vmi_events_listen(vmiInstance, timeoutMilliseconds);
+    if (isBlocking)
+    {
+        GlobalControl::leaveEventLoopListen();
+    }
     if (status != VMI_SUCCESS)
     {
         throw VmiException(fmt::format("{}: Error while waiting for vmi events.", __func__));
@@ -253,7 +497,11 @@ uint64_t LibvmiInterface::translateKernelSymbolToVA(const std::string& kernelSym
 uint64_t LibvmiInterface::convertVAToPA(uint64_t virtualAddress, uint64_t processCr3)
 {
     uint64_t physicalAddress = 0;
-    if (vmi_pagetable_lookup(vmiInstance, processCr3, virtualAddress, &physicalAddress) != VMI_SUCCESS)
+    expireStaleTranslations(processCr3);
+    numberOfLibvmiCalls++;
+    if (readWithHandle([&](vmi_instance_t instance)
+                       { return vmi_pagetable_lookup(instance, processCr3, virtualAddress, &physicalAddress); }) !=
+        VMI_SUCCESS)
     {
         throw VmiException(fmt::format(
             "{}: Conversion of address {:#x} with cr3 {:#x} not possible.", __func__, virtualAddress, processCr3));
@@ -261,9 +509,63 @@ uint64_t LibvmiInterface::convertVAToPA(uint64_t virtualAddress, uint64_t proces
     return physicalAddress;
 }
 
+std::vector<PageTranslation> LibvmiInterface::translateRange(uint64_t virtualAddress, uint64_t size, uint64_t cr3)
+{
+    expireStaleTranslations(cr3);
+    if (isPageTableWalkerSupported)
+    {
+        return pageTableWalker->translateRange(virtualAddress, size, cr3);
+    }
+    return translateRangeByPage(virtualAddress, size, cr3);
+}
+
+std::vector<PageTranslation>
+LibvmiInterface::translateRangeByPage(uint64_t virtualAddress, uint64_t size, uint64_t cr3)
+{
+    std::vector<PageTranslation> translations;
+    auto endAddress = virtualAddress + size;
+    while (virtualAddress < endAddress)
+    {
+        constexpr auto pageSize = PagingDefinitions::pageSizeInBytes;
+        auto pageEnd = (virtualAddress & ~(pageSize - 1)) + pageSize;
+        auto runEnd = pageEnd == 0 || pageEnd > endAddress ? endAddress : pageEnd;
+        uint64_t physicalAddress = 0;
+        numberOfLibvmiCalls++;
+        auto present =
+            readWithHandle([&](vmi_instance_t instance)
+                           { return vmi_pagetable_lookup(instance, cr3, virtualAddress, &physicalAddress); }) ==
+            VMI_SUCCESS;
+        PageTableWalker::appendTranslation(translations,
+                                           {virtualAddress,
+                                            present ? physicalAddress : 0,
+                                            runEnd - virtualAddress,
+                                            pageSize,
+                                            present});
+        virtualAddress = runEnd;
+    }
+    return translations;
+}
+
+bool LibvmiInterface::isFourLevelPaging()
+{
+    if (vmi_get_page_mode(vmiInstance, 0) != VMI_PM_IA32E)
+    {
+        return false;
+    }
+    // libvmi has no separate page mode for 5-level paging, which is only visible in CR4.LA57
+    constexpr uint64_t cr4La57Bit = 1ull << 12;
+    uint64_t cr4 = 0;
+    if (vmi_get_vcpureg(vmiInstance, &cr4, CR4, 0) != VMI_SUCCESS)
+    {
+        return false;
+    }
+    return (cr4 & cr4La57Bit) == 0;
+}
+
 uint64_t LibvmiInterface::convertPidToDtb(pid_t processID)
 {
     uint64_t dtb = 0;
+    numberOfLibvmiCalls++;
     if (vmi_pid_to_dtb(vmiInstance, processID, &dtb) != VMI_SUCCESS)
     {
         throw VmiException(fmt::format("Unable to obtain the dtb for pid {}", processID));
@@ -274,6 +576,7 @@ uint64_t LibvmiInterface::convertPidToDtb(pid_t processID)
 pid_t LibvmiInterface::convertDtbToPid(uint64_t dtb)
 {
     pid_t pid = 0;
+    numberOfLibvmiCalls++;
     if (vmi_dtb_to_pid(vmiInstance, dtb, &pid) != VMI_SUCCESS)
     {
         throw VmiException(fmt::format("Unable obtain the pid for dtb {:#x}", dtb));
@@ -281,6 +584,16 @@ pid_t LibvmiInterface::convertDtbToPid(uint64_t dtb)
     return pid;
 }
 
+void LibvmiInterface::setKernelPid(pid_t pid)
+{
+    kernelDtbCache.setKernelPid(pid);
+}
+
+uint64_t LibvmiInterface::getKernelDtb()
+{
+    return kernelDtbCache.get();
+}
+
 void LibvmiInterface::pauseVm()
 {
     auto status = vmi_pause_vm(vmiInstance);
@@ -288,6 +601,7 @@ void LibvmiInterface::pauseVm()
     {
         throw VmiException(fmt::format("{}: Unable to pause the vm", __func__));
     }
+    beginVmPause();
 }
 
 void LibvmiInterface::resumeVm()
@@ -297,6 +611,24 @@ void LibvmiInterface::resumeVm()
     {
         throw VmiException(fmt::format("{}: Unable to resume the vm", __func__));
     }
+    endVmPause();
+}
+
+void LibvmiInterface::beginVmPause()
+{
+    if (pauseDepth++ == 0)
+    {
+        pauseStartTicks = std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+}
+
+void LibvmiInterface::endVmPause()
+{
+    if (--pauseDepth == 0 && eventMetrics)
+    {
+        eventMetrics->recordVmPause(std::chrono::steady_clock::now().time_since_epoch() -
+                                    std::chrono::steady_clock::duration(pauseStartTicks.load()));
+    }
 }
 
 bool LibvmiInterface::areEventsPending()
@@ -317,32 +649,71 @@ bool LibvmiInterface::areEventsPending()
 
 std::unique_ptr<std::string> LibvmiInterface::extractUnicodeStringAtVA(const uint64_t stringVA, const uint64_t cr3)
 {
+    expireStaleTranslations(cr3);
     auto accessContext = createVirtualAddressAccessContext(stringVA, cr3);
-    std::lock_guard<std::mutex> lock(libvmiLock);
-    auto* extractedUnicodeString = vmi_read_unicode_str(vmiInstance, &accessContext);
-    auto convertedUnicodeString = unicode_string_t{};
-    auto success = vmi_convert_str_encoding(extractedUnicodeString, &convertedUnicodeString, "UTF-8");
-    vmi_free_unicode_str(extractedUnicodeString);
-    if (success != VMI_SUCCESS)
+    UnicodeString unicodeString{};
+    numberOfLibvmiCalls++;
+    auto readUnicodeString = [&](vmi_instance_t instance)
+    { return vmi_read(instance, &accessContext, sizeof(unicodeString), &unicodeString, nullptr); };
+    if (readWithHandle(readUnicodeString) != VMI_SUCCESS)
+    {
+        throw VmiException(fmt::format("{}: Unable to read UNICODE_STRING at VA {:#x}", __func__, stringVA));
+    }
+
+    auto key = UnicodeStringKey{cr3, stringVA, unicodeString.buffer, unicodeString.length};
+    uint64_t cacheGeneration = 0;
     {
-        throw VmiException(fmt::format("{}: Unable to convert unicode string", __func__));
+        std::lock_guard<std::mutex> lock(unicodeStringCacheLock);
+        if (const auto* cachedString = unicodeStringCache.find(key))
+        {
+            return std::make_unique<std::string>(*cachedString);
+        }
+        cacheGeneration = unicodeStringCacheGeneration;
+    }
+
+    std::u16string utf16(unicodeString.length / sizeof(char16_t), u'\0');
+    accessContext.addr = unicodeString.buffer;
+    numberOfLibvmiCalls++;
+    if (!utf16.empty() &&
+        readWithHandle(
+            [&](vmi_instance_t instance)
+            { return vmi_read(instance, &accessContext, utf16.size() * sizeof(char16_t), utf16.data(), nullptr); }) !=
+            VMI_SUCCESS)
+    {
+        throw VmiException(
+            fmt::format("{}: Unable to read unicode string buffer at VA {:#x}", __func__, unicodeString.buffer));
+    }
+    auto result = std::make_unique<std::string>(Utf16Converter::toUtf8(utf16));
+    std::lock_guard<std::mutex> lock(unicodeStringCacheLock);
+    // The buffer may have been read before the guest ran again, so it must not end up in the cleared cache
+    if (cacheGeneration == unicodeStringCacheGeneration)
+    {
+        unicodeStringCache.insert(key, *result);
     }
-    auto result = std::make_unique<std::string>(reinterpret_cast<char*>(convertedUnicodeString.contents),
-                                                convertedUnicodeString.length);
-    free(convertedUnicodeString.contents); // NOLINT(cppcoreguidelines-owning-memory, cppcoreguidelines-no-malloc)
     return result;
 }
 
 std::unique_ptr<std::string> LibvmiInterface::extractStringAtVA(const uint64_t virtualAddress, const uint64_t cr3)
 {
+    auto result = tryExtractStringAtVA(virtualAddress, cr3);
+    if (!result)
+    {
+        throw VmiException(fmt::format("{}: Unable to read string at VA {:#x}", __func__, virtualAddress));
+    }
+    return std::make_unique<std::string>(std::move(*result));
+}
+
+std::optional<std::string> LibvmiInterface::tryExtractStringAtVA(const uint64_t virtualAddress, const uint64_t cr3)
+{
+    expireStaleTranslations(cr3);
     auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-    std::lock_guard<std::mutex> lock(libvmiLock);
-    auto rawString = vmi_read_str(vmiInstance, &accessContext);
+    numberOfLibvmiCalls++;
+    auto* rawString = readWithHandle([&](vmi_instance_t instance) { return vmi_read_str(instance, &accessContext); });
     if (rawString == nullptr)
     {
-        throw VmiException(fmt::format("{}: Unable to read string at VA {:#x}", __func__, virtualAddress));
+        return std::nullopt;
     }
-    auto result = std::make_unique<std::string>(rawString);
+    auto result = std::make_optional<std::string>(rawString);
     free(rawString);
     return result;
 }
@@ -355,6 +726,74 @@ void LibvmiInterface::stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId)
     }
 }
 
+void LibvmiInterface::setSlatEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(libvmiLock);
+    if (vmi_slat_set_domain_state(vmiInstance, enabled) != VMI_SUCCESS)
+    {
+        throw VmiException(fmt::format("{}: Unable to set altp2m state to {}", __func__, enabled));
+    }
+}
+
+uint16_t LibvmiInterface::createSlatView()
+{
+    uint16_t view = 0;
+    std::lock_guard<std::mutex> lock(libvmiLock);
+    if (vmi_slat_create(vmiInstance, &view) != VMI_SUCCESS)
+    {
+        throw VmiException(fmt::format("{}: Unable to create altp2m view", __func__));
+    }
+    return view;
+}
+
+void LibvmiInterface::destroySlatView(uint16_t view)
+{
+    std::lock_guard<std::mutex> lock(libvmiLock);
+    if (vmi_slat_destroy(vmiInstance, view) != VMI_SUCCESS)
+    {
+        throw VmiException(fmt::format("{}: Unable to destroy altp2m view {}", __func__, view));
+    }
+}
+
+void LibvmiInterface::switchSlatView(uint16_t view)
+{
+    std::lock_guard<std::mutex> lock(libvmiLock);
+    if (vmi_slat_switch(vmiInstance, view) != VMI_SUCCESS)
+    {
+        throw VmiException(fmt::format("{}: Unable to switch to altp2m view {}", __func__, view));
+    }
+}
+
+void LibvmiInterface::changeSlatGfn(uint16_t view, uint64_t gfn, uint64_t newGfn)
+{
+    std::lock_guard<std::mutex> lock(libvmiLock);
+    if (vmi_slat_change_gfn(vmiInstance, view, gfn, newGfn) != VMI_SUCCESS)
+    {
+        throw VmiException(
+            fmt::format("{}: Unable to remap gfn {:#x} to {:#x} in altp2m view {}", __func__, gfn, newGfn, view));
+    }
+}
+
+uint64_t LibvmiInterface::allocateGfn()
+{
+    addr_t gfn = 0;
+    std::lock_guard<std::mutex> lock(libvmiLock);
+    if (vmi_get_next_available_gfn(vmiInstance, &gfn) != VMI_SUCCESS || vmi_alloc_gfn(vmiInstance, gfn) != VMI_SUCCESS)
+    {
+        throw VmiException(fmt::format("{}: Unable to allocate a guest frame", __func__));
+    }
+    return gfn;
+}
+
+void LibvmiInterface::freeGfn(uint64_t gfn)
+{
+    std::lock_guard<std::mutex> lock(libvmiLock);
+    if (vmi_free_gfn(vmiInstance, gfn) != VMI_SUCCESS)
+    {
+        throw VmiException(fmt::format("{}: Unable to free gfn {:#x}", __func__, gfn));
+    }
+}
+
 os_t LibvmiInterface::getOsType()
 {
     return vmi_get_ostype(vmiInstance);
@@ -420,10 +859,87 @@ std::tuple<addr_t, size_t, size_t> LibvmiInterface::getBitfieldOffsetAndSizeFrom
 
 void LibvmiInterface::flushV2PCache(addr_t pt)
 {
-    vmi_v2pcache_flush(vmiInstance, pt);
+    {
+        // Event workers and plugin threads may read concurrently
+        std::lock_guard<std::mutex> lock(libvmiLock);
+        vmi_v2pcache_flush(vmiInstance, pt);
+    }
+    if (readHandlePool)
+    {
+        readHandlePool->forEachHandle([pt](vmi_instance_t instance) { vmi_v2pcache_flush(instance, pt); });
+    }
+    if (pt == flushAllPTs)
+    {
+        pageTableWalker->flushAll();
+    }
+    else
+    {
+        pageTableWalker->flush(pt);
+    }
 }
 
 void LibvmiInterface::flushPageCache()
 {
-    vmi_pagecache_flush(vmiInstance);
+    {
+        std::lock_guard<std::mutex> lock(libvmiLock);
+        vmi_pagecache_flush(vmiInstance);
+    }
+    if (readHandlePool)
+    {
+        readHandlePool->forEachHandle([](vmi_instance_t instance) { vmi_pagecache_flush(instance); });
+    }
+}
+
+void LibvmiInterface::invalidateCaches()
+{
+    // Cached frame contents are stale as soon as the guest has run, regardless of the policy
+    flushPageCache();
+    translationCacheInvalidator.invalidate();
+    // A freed string buffer can be reused with the same address and length
+    std::lock_guard<std::mutex> lock(unicodeStringCacheLock);
+    unicodeStringCache.clear();
+    unicodeStringCacheGeneration++;
+}
+
+CacheInvalidationPolicy LibvmiInterface::parseCacheInvalidationPolicy(const std::string& policy)
+{
+    if (policy == "full")
+    {
+        return CacheInvalidationPolicy::Full;
+    }
+    if (policy == "per_address_space")
+    {
+        return CacheInvalidationPolicy::PerAddressSpace;
+    }
+    throw std::invalid_argument(fmt::format("{}: Unknown cache invalidation policy {}", __func__, policy));
+}
+
+void LibvmiInterface::validateNumberOfReadHandles(vmi_mode_t accessMode, uint numberOfReadHandles)
+{
+    // Every read handle is a separate introspection session, but KVMi only allows a single one per VM
+    if (accessMode == VMI_KVM && numberOfReadHandles > 0)
+    {
+        throw std::invalid_argument(
+            fmt::format("{}: read_handles has to be 0 on KVM, which allows only a single introspection session per VM",
+                        __func__));
+    }
+}
+
+void LibvmiInterface::expireStaleTranslations(uint64_t cr3)
+{
+    translationCacheInvalidator.expireStaleTranslations(cr3);
+}
+
+uint64_t LibvmiInterface::getNumberOfLibvmiCalls()
+{
+    return numberOfLibvmiCalls;
+}
+
+std::vector<ReadHandleUtilization> LibvmiInterface::getReadHandleUtilization() const
+{
+    if (!readHandlePool)
+    {
+        return {};
+    }
+    return readHandlePool->getUtilization();
 }
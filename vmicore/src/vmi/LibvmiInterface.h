@@ -4,21 +4,35 @@
 #include "../config/IConfigParser.h"
 #include "../io/IEventStream.h"
 #include "../io/ILogging.h"
+#include "../os/PageTranslation.h"
+#include "EventMetrics.h"
+#include "KernelDtbCache.h"
+#include "LruCache.h"
+#include "ReadRequest.h"
+#include "TranslationCacheInvalidator.h"
 #include "VmiException.h"
 #include "VmiInitError.h"
+#include "VmiReadHandlePool.h"
+#include <atomic>
 #include <codecvt>
 #include <fmt/core.h>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <vector>
+#include <vmicore/vmi/IMemoryMapping.h>
 
 #define LIBVMI_EXTRA_JSON
 
 #include "libvmi/libvmi_extra.h"
 #include <json-c/json.h>
 
+class PageTableWalker;
+
 class ILibvmiInterface
 {
   public:
@@ -34,19 +48,49 @@ class ILibvmiInterface
 
     virtual uint32_t read32PA(uint64_t pyhsicalAddress) = 0;
 
+    virtual bool readPA(uint64_t physicalAddress, std::span<uint8_t> content) = 0;
+
     virtual uint8_t read8VA(const uint64_t virtualAddress, const uint64_t cr3) = 0;
 
     virtual uint32_t read32VA(uint64_t virtualAddress, uint64_t cr3) = 0;
 
     virtual uint64_t read64VA(uint64_t virtualAddress, uint64_t cr3) = 0;
 
+    virtual uint8_t readKernel8(uint64_t virtualAddress) = 0;
+
+    virtual uint32_t readKernel32(uint64_t virtualAddress) = 0;
+
+    virtual uint64_t readKernel64(uint64_t virtualAddress) = 0;
+
+    // Non-throwing variants for traversal code that regularly runs into paged out memory
+    virtual std::optional<uint8_t> tryRead8VA(uint64_t virtualAddress, uint64_t cr3) = 0;
+
+    virtual std::optional<uint32_t> tryRead32VA(uint64_t virtualAddress, uint64_t cr3) = 0;
+
+    virtual std::optional<uint64_t> tryRead64VA(uint64_t virtualAddress, uint64_t cr3) = 0;
+
+    virtual std::optional<uint64_t> tryReadKernel64(uint64_t virtualAddress) = 0;
+
     virtual bool readXVA(uint64_t virtualAddress, uint64_t cr3, std::vector<uint8_t>& content) = 0;
 
+    // Reads all requests under a single lock acquisition. Returns false if at least one request failed.
+    virtual bool readBatchVA(uint64_t cr3, std::span<ReadRequest> requests) = 0;
+
+    // Same as readBatchVA, but throws a VmiException naming the caller and the first failed request
+    void readBatchVAOrThrow(uint64_t cr3, std::span<ReadRequest> requests, const char* caller);
+
+    // Maps the guest pages into the host address space instead of copying them. Unmapped pages are left out.
+    virtual std::unique_ptr<IMemoryMapping> mmapGuest(uint64_t baseVA, uint64_t cr3, size_t numberOfPages) = 0;
+
     virtual void write8PA(uint64_t physicalAddress, uint8_t value) = 0;
 
     virtual void write32PA(uint64_t physicalAddress, uint32_t value) = 0;
 
-    virtual void waitForEvent() = 0;
+    virtual void writePA(uint64_t physicalAddress, std::span<const uint8_t> content) = 0;
+
+    // Processes the next events and all events that arrive meanwhile. Returns the number of additional listen rounds
+    // that were necessary to drain the pending events.
+    virtual uint waitForEvent() = 0;
 
     virtual void registerEvent(vmi_event_t& event) = 0;
 
@@ -58,10 +102,18 @@ class ILibvmiInterface
 
     virtual uint64_t convertVAToPA(uint64_t virtualAddress, uint64_t cr3Register) = 0;
 
+    // Walks the page tables once for the whole range and returns runs of present and non-present pages.
+    virtual std::vector<PageTranslation> translateRange(uint64_t virtualAddress, uint64_t size, uint64_t cr3) = 0;
+
     virtual uint64_t convertPidToDtb(pid_t processID) = 0;
 
     virtual pid_t convertDtbToPid(uint64_t dtb) = 0;
 
+    // Has to be called with the process whose page tables map the kernel before the kernel DTB is used
+    virtual void setKernelPid(pid_t pid) = 0;
+
+    virtual uint64_t getKernelDtb() = 0;
+
     virtual void pauseVm() = 0;
 
     virtual void resumeVm() = 0;
@@ -72,8 +124,28 @@ class ILibvmiInterface
 
     virtual std::unique_ptr<std::string> extractStringAtVA(uint64_t virtualAddress, uint64_t cr3) = 0;
 
+    virtual std::optional<std::string> tryExtractStringAtVA(uint64_t virtualAddress, uint64_t cr3) = 0;
+
     virtual void stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId) = 0;
 
+    // Alternate SLAT views (altp2m on Xen). View 0 is the host view, which always maps the original frames.
+    virtual void setSlatEnabled(bool enabled) = 0;
+
+    virtual uint16_t createSlatView() = 0;
+
+    virtual void destroySlatView(uint16_t view) = 0;
+
+    // Switches all vCPUs to the given view
+    virtual void switchSlatView(uint16_t view) = 0;
+
+    // Backs gfn with newGfn in the given view. Passing ~0 as newGfn restores the original mapping.
+    virtual void changeSlatGfn(uint16_t view, uint64_t gfn, uint64_t newGfn) = 0;
+
+    // Adds a frame to the guest physical address space which the guest itself does not know about
+    virtual uint64_t allocateGfn() = 0;
+
+    virtual void freeGfn(uint64_t gfn) = 0;
+
     virtual os_t getOsType() = 0;
 
     virtual uint64_t getOffset(const std::string& name) = 0;
@@ -91,16 +163,42 @@ class ILibvmiInterface
 
     virtual void flushPageCache() = 0;
 
+    // Has to be called whenever the guest may have run since the last memory access, e.g. on every event
+    virtual void invalidateCaches() = 0;
+
+    virtual uint64_t getNumberOfLibvmiCalls() = 0;
+
   protected:
     ILibvmiInterface() = default;
 };
 
+struct UnicodeStringKey
+{
+    uint64_t cr3;
+    uint64_t stringVA;
+    uint64_t bufferVA;
+    uint16_t length;
+
+    bool operator==(const UnicodeStringKey&) const = default;
+};
+
+struct UnicodeStringKeyHash
+{
+    size_t operator()(const UnicodeStringKey& key) const
+    {
+        return std::hash<uint64_t>{}(key.stringVA ^ (key.bufferVA << 1) ^ (key.cr3 << 2) ^ key.length);
+    }
+};
+
 class LibvmiInterface : public ILibvmiInterface
 {
   public:
+    static constexpr size_t maximumNumberOfCachedUnicodeStrings = 4096;
+
     LibvmiInterface(std::shared_ptr<IConfigParser> configInterface,
                     std::shared_ptr<ILogging> loggingLib,
-                    std::shared_ptr<IEventStream> eventStream);
+                    std::shared_ptr<IEventStream> eventStream,
+                    std::shared_ptr<EventMetrics> eventMetrics);
 
     ~LibvmiInterface() override;
 
@@ -112,19 +210,41 @@ class LibvmiInterface : public ILibvmiInterface
 
     uint32_t read32PA(uint64_t pyhsicalAddress) override;
 
+    bool readPA(uint64_t physicalAddress, std::span<uint8_t> content) override;
+
     uint8_t read8VA(const uint64_t virtualAddress, const uint64_t cr3) override;
 
     uint32_t read32VA(uint64_t virtualAddress, uint64_t cr3) override;
 
     uint64_t read64VA(uint64_t virtualAddress, uint64_t cr3) override;
 
+    uint8_t readKernel8(uint64_t virtualAddress) override;
+
+    uint32_t readKernel32(uint64_t virtualAddress) override;
+
+    uint64_t readKernel64(uint64_t virtualAddress) override;
+
+    std::optional<uint8_t> tryRead8VA(uint64_t virtualAddress, uint64_t cr3) override;
+
+    std::optional<uint32_t> tryRead32VA(uint64_t virtualAddress, uint64_t cr3) override;
+
+    std::optional<uint64_t> tryRead64VA(uint64_t virtualAddress, uint64_t cr3) override;
+
+    std::optional<uint64_t> tryReadKernel64(uint64_t virtualAddress) override;
+
     bool readXVA(uint64_t virtualAddress, uint64_t cr3, std::vector<uint8_t>& content) override;
 
+    bool readBatchVA(uint64_t cr3, std::span<ReadRequest> requests) override;
+
+    std::unique_ptr<IMemoryMapping> mmapGuest(uint64_t baseVA, uint64_t cr3, size_t numberOfPages) override;
+
     void write8PA(uint64_t physicalAddress, uint8_t value) override;
 
     void write32PA(uint64_t physicalAddress, uint32_t value) override;
 
-    void waitForEvent() override;
+    void writePA(uint64_t physicalAddress, std::span<const uint8_t> content) override;
+
+    uint waitForEvent() override;
 
     void registerEvent(vmi_event_t& event) override;
 
@@ -136,10 +256,16 @@ class LibvmiInterface : public ILibvmiInterface
 
     uint64_t convertVAToPA(uint64_t virtualAddress, uint64_t processCr3) override;
 
+    std::vector<PageTranslation> translateRange(uint64_t virtualAddress, uint64_t size, uint64_t cr3) override;
+
     uint64_t convertPidToDtb(pid_t processID) override;
 
     pid_t convertDtbToPid(uint64_t dtb) override;
 
+    void setKernelPid(pid_t pid) override;
+
+    uint64_t getKernelDtb() override;
+
     void pauseVm() override;
 
     void resumeVm() override;
@@ -150,24 +276,50 @@ class LibvmiInterface : public ILibvmiInterface
 
     std::unique_ptr<std::string> extractStringAtVA(uint64_t virtualAddress, uint64_t cr3) override;
 
+    std::optional<std::string> tryExtractStringAtVA(uint64_t virtualAddress, uint64_t cr3) override;
+
     void stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId) override;
 
+    void setSlatEnabled(bool enabled) override;
+
+    uint16_t createSlatView() override;
+
+    void destroySlatView(uint16_t view) override;
+
+    void switchSlatView(uint16_t view) override;
+
+    void changeSlatGfn(uint16_t view, uint64_t gfn, uint64_t newGfn) override;
+
+    uint64_t allocateGfn() override;
+
+    void freeGfn(uint64_t gfn) override;
+
     os_t getOsType() override;
 
-    template <typename T> std::unique_ptr<T> readVa(const uint64_t virtualAddress, const uint64_t cr3)
+    template <typename T> std::optional<T> tryReadVa(const uint64_t virtualAddress, const uint64_t cr3)
     {
+        expireStaleTranslations(cr3);
         auto accessContext = createVirtualAddressAccessContext(virtualAddress, cr3);
-        auto exctractedValue = std::make_unique<T>();
-        std::lock_guard<std::mutex> lock(libvmiLock);
-        if (vmi_read(vmiInstance, &accessContext, sizeof(T), exctractedValue.get(), nullptr) != VMI_SUCCESS)
+        T extractedValue{};
+        numberOfLibvmiCalls++;
+        if (readWithHandle([&](vmi_instance_t instance)
+                           { return vmi_read(instance, &accessContext, sizeof(T), &extractedValue, nullptr); }) !=
+            VMI_SUCCESS)
         {
-            throw VmiException(fmt::format("{}: Unable to read {} bytes from VA {:#x} with cr3 {:#x}",
-                                           __func__,
-                                           sizeof(T),
-                                           accessContext.addr,
-                                           accessContext.pt));
+            return std::nullopt;
         }
-        return exctractedValue;
+        return extractedValue;
+    }
+
+    template <typename T> std::unique_ptr<T> readVa(const uint64_t virtualAddress, const uint64_t cr3)
+    {
+        auto extractedValue = tryReadVa<T>(virtualAddress, cr3);
+        if (!extractedValue)
+        {
+            throw VmiException(fmt::format(
+                "{}: Unable to read {} bytes from VA {:#x} with cr3 {:#x}", __func__, sizeof(T), virtualAddress, cr3));
+        }
+        return std::make_unique<T>(*extractedValue);
     }
 
     uint64_t getOffset(const std::string& name) override;
@@ -181,22 +333,89 @@ class LibvmiInterface : public ILibvmiInterface
     std::tuple<addr_t, size_t, size_t> getBitfieldOffsetAndSizeFromJson(const std::string& structName,
                                                                         const std::string& structMember) override;
 
-  private:
-    uint numberOfVCPUs{};
+    uint64_t getNumberOfLibvmiCalls() override;
+
+    void invalidateCaches() override;
+
+    static CacheInvalidationPolicy parseCacheInvalidationPolicy(const std::string& policy);
+
+    // Throws if the access mode does not allow additional read handles
+    static void validateNumberOfReadHandles(vmi_mode_t accessMode, uint numberOfReadHandles);
+
+    // Reads per handle of the read handle pool. Empty if no additional read handles are configured.
+    [[nodiscard]] std::vector<ReadHandleUtilization> getReadHandleUtilization() const;
+
+  protected:
     std::shared_ptr<IConfigParser> configInterface;
+    std::shared_ptr<ILogging> loggingLib;
     std::unique_ptr<ILogger> logger;
+
+    void initializeLibvmi(const std::string& domain, uint64_t initFlags, const std::filesystem::path& socketPath);
+
+    // Accounts the time between the outermost pause and its resume to the pause totals of the event metrics
+    void beginVmPause();
+
+    void endVmPause();
+
+  private:
+    uint numberOfVCPUs{};
+    uint eventListenTimeoutMilliseconds = 500;
     std::shared_ptr<IEventStream> eventStream;
+    std::shared_ptr<EventMetrics> eventMetrics;
+    // Pauses nest, only the outermost paused section is accounted for
+    std::atomic<uint> pauseDepth{0};
+    std::atomic<std::chrono::steady_clock::rep> pauseStartTicks{0};
     vmi_instance_t vmiInstance{};
     std::mutex libvmiLock{};
+    KernelDtbCache kernelDtbCache{*this};
+    std::atomic<uint64_t> numberOfLibvmiCalls{0};
+    std::unique_ptr<PageTableWalker> pageTableWalker;
+    // The page table walker only supports IA-32e 4-level paging, other paging modes are translated page by page
+    bool isPageTableWalkerSupported = false;
+    // Read-only sessions used instead of vmiInstance for memory reads, if configured
+    std::unique_ptr<VmiReadHandlePool> readHandlePool;
+    TranslationCacheInvalidator translationCacheInvalidator{*this};
+    std::mutex unicodeStringCacheLock{};
+    // Decoded UNICODE_STRINGs, guarded by unicodeStringCacheLock. The key contains the buffer address and length, so a
+    // string that has been reallocated or resized is decoded again. The cache is cleared whenever the guest has run.
+    LruCache<UnicodeStringKey, std::string, UnicodeStringKeyHash> unicodeStringCache{
+        maximumNumberOfCachedUnicodeStrings};
+    // Incremented on every clear of unicodeStringCache, guarded by unicodeStringCacheLock
+    uint64_t unicodeStringCacheGeneration = 0;
 
     static std::unique_ptr<std::string> createConfigString(const std::string& offsetsFile);
 
     static void freeEvent(vmi_event_t* event, status_t rc);
 
+    void listenForEvents(uint timeoutMilliseconds);
+
     static access_context_t createPhysicalAddressAccessContext(uint64_t physicalAddress);
 
     static access_context_t createVirtualAddressAccessContext(uint64_t virtualAddress, uint64_t cr3);
 
+    void initializeReadHandlePool(const std::string& domain,
+                                  uint64_t initFlags,
+                                  const std::filesystem::path& socketPath,
+                                  const std::string& configString);
+
+    // Runs the read on the read handle of the calling thread, or on the primary instance if there is no pool
+    template <typename Read> auto readWithHandle(Read readFunction)
+    {
+        if (readHandlePool)
+        {
+            return readHandlePool->read(readFunction);
+        }
+        std::lock_guard<std::mutex> lock(libvmiLock);
+        return readFunction(vmiInstance);
+    }
+
+    [[nodiscard]] bool isFourLevelPaging();
+
+    [[nodiscard]] std::vector<PageTranslation>
+    translateRangeByPage(uint64_t virtualAddress, uint64_t size, uint64_t cr3);
+
+    void expireStaleTranslations(uint64_t cr3);
+
     void flushV2PCache(addr_t pt) override;
 
     void flushPageCache() override;
@@ -0,0 +1,75 @@
+#ifndef VMICORE_LRUCACHE_H
+#define VMICORE_LRUCACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+// Bounded map that evicts the least recently used entry once the capacity is reached. Not thread safe.
+template <typename Key, typename Value, typename Hash = std::hash<Key>> class LruCache
+{
+  public:
+    explicit LruCache(size_t capacity) : capacity(capacity) {}
+
+    // The returned pointer is only valid until the next modification of the cache
+    [[nodiscard]] const Value* find(const Key& key)
+    {
+        auto entry = index.find(key);
+        if (entry == index.end())
+        {
+            return nullptr;
+        }
+        entries.splice(entries.begin(), entries, entry->second);
+        return &entry->second->second;
+    }
+
+    void insert(const Key& key, Value value)
+    {
+        if (capacity == 0)
+        {
+            return;
+        }
+        if (auto entry = index.find(key); entry != index.end())
+        {
+            entry->second->second = std::move(value);
+            entries.splice(entries.begin(), entries, entry->second);
+            return;
+        }
+        if (entries.size() == capacity)
+        {
+            index.erase(entries.back().first);
+            entries.pop_back();
+        }
+        entries.emplace_front(key, std::move(value));
+        index.emplace(key, entries.begin());
+    }
+
+    void erase(const Key& key)
+    {
+        if (auto entry = index.find(key); entry != index.end())
+        {
+            entries.erase(entry->second);
+            index.erase(entry);
+        }
+    }
+
+    void clear()
+    {
+        index.clear();
+        entries.clear();
+    }
+
+    [[nodiscard]] size_t size() const
+    {
+        return entries.size();
+    }
+
+  private:
+    size_t capacity;
+    std::list<std::pair<Key, Value>> entries;
+    std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index;
+};
+
+#endif // VMICORE_LRUCACHE_H
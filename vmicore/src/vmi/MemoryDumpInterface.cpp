@@ -0,0 +1,56 @@
+#include "MemoryDumpInterface.h"
+#include "../io/grpc/GRPCLogger.h"
+#include <filesystem>
+#include <fmt/core.h>
+
+MemoryDumpInterface::MemoryDumpInterface(std::shared_ptr<IConfigParser> configInterface,
+                                         std::shared_ptr<ILogging> loggingLib,
+                                         std::shared_ptr<IEventStream> eventStream,
+                                         std::shared_ptr<EventMetrics> eventMetrics)
+    : LibvmiInterface(
+          std::move(configInterface), std::move(loggingLib), std::move(eventStream), std::move(eventMetrics))
+{
+}
+
+void MemoryDumpInterface::initializeVmi()
+{
+    auto dumpFile = configInterface->getDumpFile();
+    logger->info("Initialize libvmi from memory dump", {logfield::create("dumpFile", dumpFile.string())});
+
+    initializeLibvmi(dumpFile, VMI_INIT_DOMAINNAME, {});
+}
+
+void MemoryDumpInterface::clearEvent(vmi_event_t& /*event*/, bool /*deallocate*/) {}
+
+void MemoryDumpInterface::write8PA(uint64_t physicalAddress, uint8_t /*value*/)
+{
+    throw VmiException(fmt::format("{}: Memory dumps are read-only, PA: {:#x}", __func__, physicalAddress));
+}
+
+void MemoryDumpInterface::write32PA(uint64_t physicalAddress, uint32_t /*value*/)
+{
+    throw VmiException(fmt::format("{}: Memory dumps are read-only, PA: {:#x}", __func__, physicalAddress));
+}
+
+void MemoryDumpInterface::writePA(uint64_t physicalAddress, std::span<const uint8_t> /*content*/)
+{
+    throw VmiException(fmt::format("{}: Memory dumps are read-only, PA: {:#x}", __func__, physicalAddress));
+}
+
+uint MemoryDumpInterface::waitForEvent()
+{
+    return 0;
+}
+
+void MemoryDumpInterface::registerEvent(vmi_event_t& /*event*/) {}
+
+void MemoryDumpInterface::pauseVm() {}
+
+void MemoryDumpInterface::resumeVm() {}
+
+bool MemoryDumpInterface::areEventsPending()
+{
+    return false;
+}
+
+void MemoryDumpInterface::stopSingleStepForVcpu(vmi_event_t* /*event*/, uint /*vcpuId*/) {}
@@ -0,0 +1,39 @@
+#ifndef VMICORE_MEMORYDUMPINTERFACE_H
+#define VMICORE_MEMORYDUMPINTERFACE_H
+
+#include "LibvmiInterface.h"
+
+// Offline backend for raw physical memory dumps. Libvmi's file driver maps the dump into memory, so all reads and
+// translations work like on a live VM while event and execution control requests are ignored.
+class MemoryDumpInterface : public LibvmiInterface
+{
+  public:
+    MemoryDumpInterface(std::shared_ptr<IConfigParser> configInterface,
+                        std::shared_ptr<ILogging> loggingLib,
+                        std::shared_ptr<IEventStream> eventStream,
+                        std::shared_ptr<EventMetrics> eventMetrics);
+
+    void initializeVmi() override;
+
+    void clearEvent(vmi_event_t& event, bool deallocate) override;
+
+    void write8PA(uint64_t physicalAddress, uint8_t value) override;
+
+    void write32PA(uint64_t physicalAddress, uint32_t value) override;
+
+    void writePA(uint64_t physicalAddress, std::span<const uint8_t> content) override;
+
+    uint waitForEvent() override;
+
+    void registerEvent(vmi_event_t& event) override;
+
+    void pauseVm() override;
+
+    void resumeVm() override;
+
+    bool areEventsPending() override;
+
+    void stopSingleStepForVcpu(vmi_event_t* event, uint vcpuId) override;
+};
+
+#endif // VMICORE_MEMORYDUMPINTERFACE_H
@@ -0,0 +1,75 @@
+#include "MemoryMapping.h"
+#include "../os/PagingDefinitions.h"
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fmt/core.h>
+#include <sys/mman.h>
+
+MemoryMapping::MemoryMapping(uint64_t guestBaseVA,
+                             std::span<void* const> accessPointers,
+                             const std::shared_ptr<ILogging>& logging)
+    : logger(NEW_LOGGER(logging)),
+      guestBaseVA(guestBaseVA),
+      sizeInGuest(accessPointers.size() * PagingDefinitions::pageSizeInBytes)
+{
+    // Pages are only merged into a run if they are adjacent both in the guest and on the host. Depending on the driver,
+    // libvmi backs the pages with one dense host mapping or with separate mappings, so nothing else can be assumed.
+    const uint8_t* runStart = nullptr;
+    size_t runSize = 0;
+    uint64_t runGuestVA = 0;
+    for (size_t pageIndex = 0; pageIndex < accessPointers.size(); pageIndex++)
+    {
+        auto* page = static_cast<const uint8_t*>(accessPointers[pageIndex]);
+        if (page != nullptr && runStart != nullptr && page == runStart + runSize)
+        {
+            runSize += PagingDefinitions::pageSizeInBytes;
+            continue;
+        }
+        if (runStart != nullptr)
+        {
+            mappedRegions.push_back({runGuestVA, std::span<const uint8_t>(runStart, runSize)});
+            runStart = nullptr;
+        }
+        if (page != nullptr)
+        {
+            runStart = page;
+            runSize = PagingDefinitions::pageSizeInBytes;
+            runGuestVA = guestBaseVA + pageIndex * PagingDefinitions::pageSizeInBytes;
+        }
+    }
+    if (runStart != nullptr)
+    {
+        mappedRegions.push_back({runGuestVA, std::span<const uint8_t>(runStart, runSize)});
+    }
+}
+
+MemoryMapping::~MemoryMapping()
+{
+    // Only the host pages libvmi returned are unmapped, memory in between may belong to somebody else
+    for (const auto& mappedRegion : mappedRegions)
+    {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+        if (munmap(const_cast<uint8_t*>(mappedRegion.mapping.data()), mappedRegion.mapping.size()) != 0)
+        {
+            logger->warning("Failed to unmap guest memory",
+                            {logfield::create("baseVA", fmt::format("{:#x}", mappedRegion.guestBaseVA)),
+                             logfield::create("error", std::strerror(errno))});
+        }
+    }
+}
+
+uint64_t MemoryMapping::getBaseVA() const
+{
+    return guestBaseVA;
+}
+
+size_t MemoryMapping::getSizeInGuest() const
+{
+    return sizeInGuest;
+}
+
+const std::vector<MappedRegion>& MemoryMapping::getMappedRegions() const
+{
+    return mappedRegions;
+}
@@ -0,0 +1,38 @@
+#ifndef VMICORE_MEMORYMAPPING_H
+#define VMICORE_MEMORYMAPPING_H
+
+#include "../io/ILogger.h"
+#include "../io/ILogging.h"
+#include <memory>
+#include <span>
+#include <vector>
+#include <vmicore/vmi/IMemoryMapping.h>
+
+class MemoryMapping : public IMemoryMapping
+{
+  public:
+    // accessPointers holds one entry per guest page as returned by vmi_mmap_guest, nullptr for pages not mapped.
+    MemoryMapping(uint64_t guestBaseVA,
+                  std::span<void* const> accessPointers,
+                  const std::shared_ptr<ILogging>& logging);
+
+    ~MemoryMapping() override;
+
+    MemoryMapping(const MemoryMapping&) = delete;
+
+    MemoryMapping& operator=(const MemoryMapping&) = delete;
+
+    [[nodiscard]] uint64_t getBaseVA() const override;
+
+    [[nodiscard]] size_t getSizeInGuest() const override;
+
+    [[nodiscard]] const std::vector<MappedRegion>& getMappedRegions() const override;
+
+  private:
+    std::unique_ptr<ILogger> logger;
+    uint64_t guestBaseVA;
+    size_t sizeInGuest;
+    std::vector<MappedRegion> mappedRegions;
+};
+
+#endif // VMICORE_MEMORYMAPPING_H
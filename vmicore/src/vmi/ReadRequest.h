@@ -0,0 +1,20 @@
+#ifndef VMICORE_READREQUEST_H
+#define VMICORE_READREQUEST_H
+
+#include <cstddef>
+#include <cstdint>
+
+struct ReadRequest
+{
+    uint64_t virtualAddress;
+    size_t size;
+    void* destination;
+    bool success = false;
+
+    template <typename T> static ReadRequest create(uint64_t virtualAddress, T& destination)
+    {
+        return ReadRequest{virtualAddress, sizeof(T), &destination};
+    }
+};
+
+#endif // VMICORE_READREQUEST_H
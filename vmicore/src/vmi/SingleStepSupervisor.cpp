@@ -12,8 +12,10 @@ namespace
 std::unique_ptr<ILogger> SingleStepSupervisor::logger;
 
 SingleStepSupervisor::SingleStepSupervisor(std::shared_ptr<ILibvmiInterface> vmiInterface,
-                                           std::shared_ptr<ILogging> loggingLib)
-    : vmiInterface(std::move(vmiInterface))
+                                           std::shared_ptr<ILogging> loggingLib,
+                                           const std::shared_ptr<EventMetrics>& eventMetrics)
+    : vmiInterface(std::move(vmiInterface)),
+      callbackLatency(eventMetrics->getSingleStepLatencyHistogram())
 {
     if (singleStepSupervisorSingleton != nullptr)
     {
@@ -62,6 +64,8 @@ void SingleStepSupervisor::teardown()
 
 event_response_t SingleStepSupervisor::singleStepCallback(vmi_event_t* event)
 {
+    ScopedLatencyRecorder latencyRecorder(callbackLatency.get());
+    auto slatId = event->slat_id;
     try
     {
         callbacks[event->vcpu_id](event);
@@ -77,7 +81,7 @@ event_response_t SingleStepSupervisor::singleStepCallback(vmi_event_t* event)
     event->callback = nullptr;
     vmiInterface->stopSingleStepForVcpu(event, event->vcpu_id);
     event->ss_event.enable = false;
-    return VMI_EVENT_RESPONSE_NONE;
+    return event->slat_id != slatId ? VMI_EVENT_RESPONSE_SLAT_ID : VMI_EVENT_RESPONSE_NONE;
 }
 
 void SingleStepSupervisor::setSingleStepCallback(uint vcpuId, const std::function<void(vmi_event_t*)>& eventCallback)
@@ -2,6 +2,7 @@
 #define VMICORE_SINGLESTEPSUPERVISOR_H
 
 #include "../io/ILogging.h"
+#include "EventMetrics.h"
 #include "LibvmiInterface.h"
 #include <memory>
 #include <vector>
@@ -15,6 +16,7 @@ class ISingleStepSupervisor
 
     virtual void teardown() = 0;
 
+    // The callback may move the vCPU to another SLAT view by changing the slat_id of the single step event
     virtual void setSingleStepCallback(uint vcpuId, const std::function<void(vmi_event_t*)>& eventCallback) = 0;
 
   protected:
@@ -24,7 +26,9 @@ class ISingleStepSupervisor
 class SingleStepSupervisor : public ISingleStepSupervisor
 {
   public:
-    explicit SingleStepSupervisor(std::shared_ptr<ILibvmiInterface> vmiInterface, std::shared_ptr<ILogging> loggingLib);
+    SingleStepSupervisor(std::shared_ptr<ILibvmiInterface> vmiInterface,
+                         std::shared_ptr<ILogging> loggingLib,
+                         const std::shared_ptr<EventMetrics>& eventMetrics);
 
     ~SingleStepSupervisor() override;
 
@@ -57,6 +61,7 @@ class SingleStepSupervisor : public ISingleStepSupervisor
     std::shared_ptr<ILibvmiInterface> vmiInterface;
     std::vector<vmi_event_t> singleStepEvents{};
     std::vector<std::function<void(vmi_event_t*)>> callbacks;
+    std::shared_ptr<LatencyHistogram> callbackLatency;
 
     static std::unique_ptr<ILogger> logger;
 
@@ -0,0 +1,41 @@
+#include "TranslationCacheInvalidator.h"
+#include "LibvmiInterface.h"
+
+TranslationCacheInvalidator::TranslationCacheInvalidator(ILibvmiInterface& vmiInterface) : vmiInterface(vmiInterface)
+{
+}
+
+void TranslationCacheInvalidator::setPolicy(CacheInvalidationPolicy newPolicy)
+{
+    policy = newPolicy;
+}
+
+void TranslationCacheInvalidator::invalidate()
+{
+    if (policy == CacheInvalidationPolicy::Full)
+    {
+        vmiInterface.flushV2PCache(ILibvmiInterface::flushAllPTs);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(generationLock);
+    generation++;
+}
+
+void TranslationCacheInvalidator::expireStaleTranslations(uint64_t cr3)
+{
+    if (policy == CacheInvalidationPolicy::Full)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(generationLock);
+    auto [translationGeneration, inserted] = translationGenerations.try_emplace(cr3, generation);
+    if (inserted || translationGeneration->second == generation)
+    {
+        return;
+    }
+    translationGeneration->second = generation;
+    // Flushing under the lock keeps concurrent readers of the same address space from using stale translations
+    vmiInterface.flushV2PCache(cr3);
+}
@@ -0,0 +1,43 @@
+#ifndef VMICORE_TRANSLATIONCACHEINVALIDATOR_H
+#define VMICORE_TRANSLATIONCACHEINVALIDATOR_H
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+class ILibvmiInterface;
+
+enum class CacheInvalidationPolicy
+{
+    // Drop all cached translations on every event
+    Full,
+    // Drop the translations of an address space lazily on its first access after an event. The kernel address space is
+    // no exception, since the kernel may change its page tables on any level.
+    PerAddressSpace
+};
+
+// Decides when the cached translations of an address space have to be dropped because the guest may have changed its
+// page tables. Translations are dropped via flushV2PCache, which also drops the tables cached by the page table walker.
+class TranslationCacheInvalidator
+{
+  public:
+    explicit TranslationCacheInvalidator(ILibvmiInterface& vmiInterface);
+
+    void setPolicy(CacheInvalidationPolicy newPolicy);
+
+    // Has to be called every time the guest has run
+    void invalidate();
+
+    // Has to be called before cached translations of the address space are used
+    void expireStaleTranslations(uint64_t cr3);
+
+  private:
+    ILibvmiInterface& vmiInterface;
+    CacheInvalidationPolicy policy = CacheInvalidationPolicy::Full;
+    std::mutex generationLock{};
+    uint64_t generation = 0;
+    // Generation in which the translations of each address space were last flushed, guarded by generationLock
+    std::unordered_map<uint64_t, uint64_t> translationGenerations;
+};
+
+#endif // VMICORE_TRANSLATIONCACHEINVALIDATOR_H
@@ -0,0 +1,106 @@
+#include "Utf16Converter.h"
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace Utf16Converter
+{
+    namespace
+    {
+        constexpr char16_t highSurrogateStart = 0xD800;
+        constexpr char16_t lowSurrogateStart = 0xDC00;
+        constexpr char16_t surrogateEnd = 0xDFFF;
+        constexpr char32_t replacementCharacter = 0xFFFD;
+        // A single UTF-16 code unit never expands to more than three UTF-8 bytes, a surrogate pair needs four
+        constexpr size_t maximumUtf8BytesPerCodeUnit = 3;
+
+        // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers)
+        char* appendCodePoint(char32_t codePoint, char* output)
+        {
+            if (codePoint < 0x80)
+            {
+                *output++ = static_cast<char>(codePoint);
+            }
+            else if (codePoint < 0x800)
+            {
+                *output++ = static_cast<char>(0xC0 | (codePoint >> 6));
+                *output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else if (codePoint < 0x10000)
+            {
+                *output++ = static_cast<char>(0xE0 | (codePoint >> 12));
+                *output++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            else
+            {
+                *output++ = static_cast<char>(0xF0 | (codePoint >> 18));
+                *output++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+                *output++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+                *output++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+            }
+            return output;
+        }
+
+        // Converts the code point starting at index and returns the number of consumed code units
+        size_t convertCodePoint(std::u16string_view utf16, size_t index, char*& output)
+        {
+            auto codeUnit = utf16[index];
+            if (codeUnit < highSurrogateStart || codeUnit > surrogateEnd)
+            {
+                output = appendCodePoint(codeUnit, output);
+                return 1;
+            }
+            if (codeUnit < lowSurrogateStart && index + 1 < utf16.size() && utf16[index + 1] >= lowSurrogateStart &&
+                utf16[index + 1] <= surrogateEnd)
+            {
+                auto codePoint = 0x10000 + ((static_cast<char32_t>(codeUnit - highSurrogateStart) << 10) |
+                                            static_cast<char32_t>(utf16[index + 1] - lowSurrogateStart));
+                output = appendCodePoint(codePoint, output);
+                return 2;
+            }
+            output = appendCodePoint(replacementCharacter, output);
+            return 1;
+        }
+        // NOLINTEND(cppcoreguidelines-avoid-magic-numbers)
+    }
+
+    std::string toUtf8(std::u16string_view utf16)
+    {
+        std::string utf8(utf16.size() * maximumUtf8BytesPerCodeUnit, '\0');
+        auto* output = utf8.data();
+        size_t index = 0;
+
+#if defined(__SSE2__)
+        // ASCII fast path: eight code units at a time are narrowed to bytes if none of them exceeds 0x7F
+        constexpr size_t codeUnitsPerVector = sizeof(__m128i) / sizeof(char16_t);
+        const auto nonAsciiMask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+        const auto zero = _mm_setzero_si128();
+        while (index + codeUnitsPerVector <= utf16.size())
+        {
+            auto codeUnits = _mm_loadu_si128(reinterpret_cast<const __m128i*>(utf16.data() + index));
+            auto nonAsciiBits = _mm_and_si128(codeUnits, nonAsciiMask);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAsciiBits, zero)) == 0xFFFF)
+            {
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(output), _mm_packus_epi16(codeUnits, codeUnits));
+                output += codeUnitsPerVector;
+                index += codeUnitsPerVector;
+                continue;
+            }
+            auto vectorEnd = index + codeUnitsPerVector;
+            while (index < vectorEnd)
+            {
+                index += convertCodePoint(utf16, index, output);
+            }
+        }
+#endif
+
+        while (index < utf16.size())
+        {
+            index += convertCodePoint(utf16, index, output);
+        }
+        utf8.resize(static_cast<size_t>(output - utf8.data()));
+        return utf8;
+    }
+}
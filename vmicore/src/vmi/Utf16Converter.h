@@ -0,0 +1,14 @@
+#ifndef VMICORE_UTF16CONVERTER_H
+#define VMICORE_UTF16CONVERTER_H
+
+#include <string>
+#include <string_view>
+
+namespace Utf16Converter
+{
+    // Converts little endian UTF-16 to UTF-8. Unpaired surrogates are replaced by U+FFFD instead of failing, since
+    // guest strings are not guaranteed to be well-formed.
+    std::string toUtf8(std::u16string_view utf16);
+}
+
+#endif // VMICORE_UTF16CONVERTER_H
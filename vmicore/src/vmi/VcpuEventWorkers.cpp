@@ -0,0 +1,92 @@
+#include "VcpuEventWorkers.h"
+#include "../GlobalControl.h"
+#include "../io/grpc/GRPCLogger.h"
+#include "VmiException.h"
+#include <filesystem>
+#include <fmt/core.h>
+#include <utility>
+
+namespace
+{
+    const std::string loggerName = std::filesystem::path(__FILE__).filename().stem();
+}
+
+VcpuEventWorkers::VcpuEventWorkers(uint numberOfVcpus) : workPerVcpu(numberOfVcpus)
+{
+    for (uint vcpuId = 0; vcpuId < numberOfVcpus; vcpuId++)
+    {
+        workers.emplace_back(&VcpuEventWorkers::processWork, this, vcpuId);
+    }
+}
+
+VcpuEventWorkers::~VcpuEventWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(workLock);
+        stopRequested = true;
+    }
+    workAvailable.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+}
+
+void VcpuEventWorkers::dispatch(uint vcpuId, std::function<void()> work)
+{
+    if (vcpuId >= workPerVcpu.size())
+    {
+        throw VmiException(fmt::format("{}: No worker for vCPU {}", __func__, vcpuId));
+    }
+    {
+        std::lock_guard<std::mutex> lock(workLock);
+        workPerVcpu[vcpuId].push_back(std::move(work));
+        numberOfPendingWorkItems++;
+    }
+    workAvailable.notify_all();
+}
+
+void VcpuEventWorkers::drain()
+{
+    std::unique_lock<std::mutex> lock(workLock);
+    workFinished.wait(lock, [this]() { return numberOfPendingWorkItems == 0; });
+}
+
+void VcpuEventWorkers::processWork(uint vcpuId)
+{
+    auto& queue = workPerVcpu[vcpuId];
+    while (true)
+    {
+        std::function<void()> work;
+        {
+            std::unique_lock<std::mutex> lock(workLock);
+            workAvailable.wait(lock, [this, &queue]() { return stopRequested || !queue.empty(); });
+            if (queue.empty())
+            {
+                return;
+            }
+            work = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        try
+        {
+            work();
+        }
+        catch (const std::exception& e)
+        {
+            GlobalControl::endVmi = true;
+            GlobalControl::logger()->error("Unexpected exception in event worker",
+                                           {logfield::create("logger", loggerName),
+                                            logfield::create("vcpu", static_cast<uint64_t>(vcpuId)),
+                                            logfield::create("exception", e.what())});
+            GlobalControl::eventStream()->sendErrorEvent(e.what());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(workLock);
+            numberOfPendingWorkItems--;
+        }
+        workFinished.notify_all();
+    }
+}
@@ -0,0 +1,45 @@
+#ifndef VMICORE_VCPUEVENTWORKERS_H
+#define VMICORE_VCPUEVENTWORKERS_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <sys/types.h>
+#include <thread>
+#include <vector>
+
+// One worker thread per vCPU for event processing that does not have to finish before the event response is sent.
+// Work dispatched for the same vCPU is processed in order, work for different vCPUs in parallel.
+class VcpuEventWorkers
+{
+  public:
+    explicit VcpuEventWorkers(uint numberOfVcpus);
+
+    // Finishes all dispatched work before returning
+    ~VcpuEventWorkers();
+
+    VcpuEventWorkers(const VcpuEventWorkers&) = delete;
+
+    VcpuEventWorkers& operator=(const VcpuEventWorkers&) = delete;
+
+    void dispatch(uint vcpuId, std::function<void()> work);
+
+    // Blocks until all work dispatched so far has been processed
+    void drain();
+
+  private:
+    std::mutex workLock{};
+    std::condition_variable workAvailable{};
+    std::condition_variable workFinished{};
+    std::vector<std::deque<std::function<void()>>> workPerVcpu;
+    // Dispatched work that has not been finished yet, including work currently being processed
+    size_t numberOfPendingWorkItems = 0;
+    bool stopRequested = false;
+    // Have to be initialized last because they immediately start working on the members above
+    std::vector<std::thread> workers;
+
+    void processWork(uint vcpuId);
+};
+
+#endif // VMICORE_VCPUEVENTWORKERS_H
@@ -0,0 +1,63 @@
+#include "VmiReadHandlePool.h"
+
+namespace
+{
+    std::atomic<uint64_t> nextPoolId{1};
+
+    struct ThreadBinding
+    {
+        uint64_t poolId;
+        size_t handleIndex;
+    };
+
+    thread_local ThreadBinding threadBinding{0, 0};
+}
+
+VmiReadHandlePool::VmiReadHandlePool(const std::vector<vmi_instance_t>& vmiInstances) : poolId(nextPoolId++)
+{
+    for (auto* vmiInstance : vmiInstances)
+    {
+        auto handle = std::make_unique<Handle>();
+        handle->vmiInstance = vmiInstance;
+        handles.push_back(std::move(handle));
+    }
+}
+
+VmiReadHandlePool::~VmiReadHandlePool()
+{
+    for (auto& handle : handles)
+    {
+        vmi_destroy(handle->vmiInstance);
+    }
+}
+
+size_t VmiReadHandlePool::size() const
+{
+    return handles.size();
+}
+
+size_t VmiReadHandlePool::getHandleIndexForCurrentThread()
+{
+    if (threadBinding.poolId != poolId)
+    {
+        threadBinding = {poolId, nextHandleIndex++ % handles.size()};
+    }
+    return threadBinding.handleIndex;
+}
+
+VmiReadHandlePool::Handle& VmiReadHandlePool::handleForCurrentThread()
+{
+    return *handles[getHandleIndexForCurrentThread()];
+}
+
+std::vector<ReadHandleUtilization> VmiReadHandlePool::getUtilization() const
+{
+    std::vector<ReadHandleUtilization> utilization;
+    utilization.reserve(handles.size());
+    for (const auto& handle : handles)
+    {
+        std::lock_guard<std::mutex> lock(handle->lock);
+        utilization.push_back({handle->numberOfReads, handle->busyTime});
+    }
+    return utilization;
+}
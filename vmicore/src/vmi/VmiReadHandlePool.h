@@ -0,0 +1,79 @@
+#ifndef VMICORE_VMIREADHANDLEPOOL_H
+#define VMICORE_VMIREADHANDLEPOOL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <libvmi/libvmi.h>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+struct ReadHandleUtilization
+{
+    uint64_t numberOfReads;
+    std::chrono::nanoseconds busyTime;
+};
+
+// Additional libvmi sessions to the same guest that are only used for reading memory. Every thread is bound to one
+// handle on its first read, so concurrent readers only contend with the threads sharing their handle instead of with
+// the event loop and all other readers.
+class VmiReadHandlePool
+{
+  public:
+    // Takes ownership of the instances
+    explicit VmiReadHandlePool(const std::vector<vmi_instance_t>& vmiInstances);
+
+    ~VmiReadHandlePool();
+
+    VmiReadHandlePool(const VmiReadHandlePool&) = delete;
+
+    VmiReadHandlePool& operator=(const VmiReadHandlePool&) = delete;
+
+    // Runs the read with the handle of the calling thread while holding the lock of that handle
+    template <typename Read> auto read(Read readFunction)
+    {
+        auto& handle = handleForCurrentThread();
+        std::lock_guard<std::mutex> lock(handle.lock);
+        handle.numberOfReads++;
+        auto start = std::chrono::steady_clock::now();
+        auto result = readFunction(handle.vmiInstance);
+        handle.busyTime += std::chrono::steady_clock::now() - start;
+        return result;
+    }
+
+    // Runs the function for every handle, e.g. to flush caches, while holding the lock of the respective handle
+    template <typename Function> void forEachHandle(Function function)
+    {
+        for (auto& handle : handles)
+        {
+            std::lock_guard<std::mutex> lock(handle->lock);
+            function(handle->vmiInstance);
+        }
+    }
+
+    [[nodiscard]] size_t size() const;
+
+    [[nodiscard]] size_t getHandleIndexForCurrentThread();
+
+    [[nodiscard]] std::vector<ReadHandleUtilization> getUtilization() const;
+
+  private:
+    struct Handle
+    {
+        vmi_instance_t vmiInstance{};
+        mutable std::mutex lock{};
+        uint64_t numberOfReads = 0;
+        std::chrono::nanoseconds busyTime{0};
+    };
+
+    std::vector<std::unique_ptr<Handle>> handles;
+    std::atomic<size_t> nextHandleIndex{0};
+    // Distinguishes pools in the thread local bindings in case a new pool is created at the same address
+    uint64_t poolId;
+
+    Handle& handleForCurrentThread();
+};
+
+#endif // VMICORE_VMIREADHANDLEPOOL_H
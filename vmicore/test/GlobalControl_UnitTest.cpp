@@ -0,0 +1,107 @@
+#include "../src/GlobalControl.h"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace
+{
+    std::atomic<int> receivedWakeupSignals = 0;
+
+    void countWakeupSignal(int /*signal*/)
+    {
+        receivedWakeupSignals++;
+    }
+
+    constexpr auto signalDeliveryTimeout = std::chrono::seconds(1);
+    // Longer than the interval after which an undelivered wakeup signal is repeated
+    constexpr auto quietPeriod = std::chrono::milliseconds(100);
+}
+
+class GlobalControlFixture : public testing::Test
+{
+  protected:
+    struct sigaction previousAction
+    {
+    };
+
+    void SetUp() override
+    {
+        receivedWakeupSignals = 0;
+        struct sigaction action
+        {
+        };
+        action.sa_handler = countWakeupSignal;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(GlobalControl::eventLoopWakeupSignal, &action, &previousAction);
+        (void)GlobalControl::consumeEventLoopWakeup();
+        GlobalControl::registerEventLoopThread();
+    }
+
+    void TearDown() override
+    {
+        GlobalControl::unregisterEventLoopThread();
+        sigaction(GlobalControl::eventLoopWakeupSignal, &previousAction, nullptr);
+    }
+
+    static void listenUntilWakeupSignal()
+    {
+        GlobalControl::enterEventLoopListen();
+        auto deadline = std::chrono::steady_clock::now() + signalDeliveryTimeout;
+        while (receivedWakeupSignals == 0 && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        GlobalControl::leaveEventLoopListen();
+    }
+};
+
+TEST_F(GlobalControlFixture, wakeUpEventLoop_whileListening_signalDeliveredExactlyOnce)
+{
+    std::jthread waker(
+        []()
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            GlobalControl::wakeUpEventLoop();
+        });
+
+    listenUntilWakeupSignal();
+    waker.join();
+    std::this_thread::sleep_for(quietPeriod);
+
+    EXPECT_EQ(receivedWakeupSignals, 1);
+    EXPECT_TRUE(GlobalControl::consumeEventLoopWakeup());
+}
+
+TEST_F(GlobalControlFixture, wakeUpEventLoop_outsideOfListen_noSignal)
+{
+    GlobalControl::wakeUpEventLoop();
+    std::this_thread::sleep_for(quietPeriod);
+
+    EXPECT_EQ(receivedWakeupSignals, 0);
+    EXPECT_TRUE(GlobalControl::consumeEventLoopWakeup());
+}
+
+TEST_F(GlobalControlFixture, wakeUpEventLoop_pendingWakeupOutsideOfListen_signalDeliveredOnceListening)
+{
+    GlobalControl::wakeUpEventLoop();
+    std::this_thread::sleep_for(quietPeriod);
+
+    listenUntilWakeupSignal();
+    std::this_thread::sleep_for(quietPeriod);
+
+    EXPECT_EQ(receivedWakeupSignals, 1);
+}
+
+TEST_F(GlobalControlFixture, enterEventLoopListen_wakeupAlreadyConsumed_noSignal)
+{
+    GlobalControl::wakeUpEventLoop();
+    ASSERT_TRUE(GlobalControl::consumeEventLoopWakeup());
+
+    GlobalControl::enterEventLoopListen();
+    std::this_thread::sleep_for(quietPeriod);
+    GlobalControl::leaveEventLoopListen();
+
+    EXPECT_EQ(receivedWakeupSignals, 0);
+}
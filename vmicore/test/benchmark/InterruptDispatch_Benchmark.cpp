@@ -0,0 +1,73 @@
+// Compares the breakpoint dispatch of InterruptDispatchTable with the std::map it replaced. Most lookups are for
+// foreign breakpoints, as they occur when a debugger inside the guest is active.
+#include "../../src/vmi/InterruptDispatchTable.h"
+#include <chrono>
+#include <fmt/core.h>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr size_t numberOfBreakpoints = 500;
+    constexpr size_t numberOfLookups = 10000000;
+    constexpr size_t percentageOfForeignBreakpoints = 90;
+    constexpr uint64_t guestMemorySize = 8ull << 30;
+
+    template <typename Lookup>
+    void measure(const std::string& name, const std::vector<uint64_t>& addresses, Lookup lookup)
+    {
+        size_t hits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (auto address : addresses)
+        {
+            hits += lookup(address) != nullptr ? 1 : 0;
+        }
+        auto duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+        fmt::print("{:<24} {:>8.2f} ns/lookup ({} hits)\n", name, duration.count() / addresses.size(), hits);
+    }
+}
+
+int main()
+{
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<uint64_t> addressDistribution(0, guestMemorySize - 1);
+    std::uniform_int_distribution<size_t> percentageDistribution(0, 99);
+
+    std::vector<int> handlers(numberOfBreakpoints);
+    std::vector<uint64_t> breakpointAddresses;
+    std::map<uint64_t, int*> map;
+    InterruptDispatchTable<int> dispatchTable;
+    while (breakpointAddresses.size() < numberOfBreakpoints)
+    {
+        auto address = addressDistribution(random);
+        if (dispatchTable.insert(address, &handlers[breakpointAddresses.size()]))
+        {
+            map[address] = &handlers[breakpointAddresses.size()];
+            breakpointAddresses.push_back(address);
+        }
+    }
+
+    std::vector<uint64_t> lookupAddresses(numberOfLookups);
+    std::uniform_int_distribution<size_t> breakpointDistribution(0, numberOfBreakpoints - 1);
+    for (auto& address : lookupAddresses)
+    {
+        address = percentageDistribution(random) < percentageOfForeignBreakpoints
+                      ? addressDistribution(random)
+                      : breakpointAddresses[breakpointDistribution(random)];
+    }
+
+    measure("std::map",
+            lookupAddresses,
+            [&map](uint64_t address) -> int*
+            {
+                auto entry = map.find(address);
+                return entry != map.end() ? entry->second : nullptr;
+            });
+    measure("InterruptDispatchTable",
+            lookupAddresses,
+            [&dispatchTable](uint64_t address) { return dispatchTable.find(address); });
+
+    return 0;
+}
@@ -25,8 +25,22 @@ class MockConfigInterface : public IConfigParser
 
     MOCK_METHOD(void, setSocketPath, (const std::filesystem::path&), (override));
 
+    MOCK_METHOD(std::filesystem::path, getDumpFile, (), (const override));
+
+    MOCK_METHOD(void, setDumpFile, (const std::filesystem::path&), (override));
+
     MOCK_METHOD(std::string, getOffsetsFile, (), (const override));
 
+    MOCK_METHOD(std::string, getCacheInvalidationPolicy, (), (const override));
+
+    MOCK_METHOD(uint, getNumberOfReadHandles, (), (const override));
+
+    MOCK_METHOD(bool, isPerVcpuEventProcessingEnabled, (), (const override));
+
+    MOCK_METHOD(std::string, getBreakpointEngine, (), (const override));
+
+    MOCK_METHOD(uint, getEventListenTimeoutMilliseconds, (), (const override));
+
     MOCK_METHOD(std::filesystem::path, getPluginDirectory, (), (const override));
 
     MOCK_METHOD((const std::map<const std::string, const std::shared_ptr<Plugin::IPluginConfig>>&),
@@ -18,6 +18,7 @@ class MockEventStream : public IEventStream
     MOCK_METHOD(void, sendTerminationEvent, (), (override));
     MOCK_METHOD(void, sendErrorEvent, (const std::string& message), (override));
     MOCK_METHOD(void, sendInMemDetectionEvent, (const std::string& message), (override));
+    MOCK_METHOD(void, updateMetrics, (const EventMetricsSnapshot& snapshot), (override));
 };
 
 #endif // VMICORE_MOCK_EVENTSTREAM_H
@@ -0,0 +1,96 @@
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <vmicore/os/LazyValue.h>
+
+TEST(LazyValueTest, get_multipleAccesses_factoryInvokedOnce)
+{
+    int invocations = 0;
+    LazyValue<std::string> lazyValue(
+        [&invocations]()
+        {
+            invocations++;
+            return std::make_unique<std::string>("C:\\Windows\\explorer.exe");
+        });
+
+    EXPECT_EQ(*lazyValue, "C:\\Windows\\explorer.exe");
+    EXPECT_EQ(lazyValue->size(), 23);
+    EXPECT_EQ(invocations, 1);
+}
+
+TEST(LazyValueTest, get_noFactoryInvocationBeforeAccess_factoryNotInvoked)
+{
+    int invocations = 0;
+    LazyValue<std::string> lazyValue(
+        [&invocations]()
+        {
+            invocations++;
+            return std::make_unique<std::string>();
+        });
+
+    EXPECT_EQ(invocations, 0);
+}
+
+TEST(LazyValueTest, get_concurrentAccesses_factoryInvokedOnce)
+{
+    std::atomic_int invocations = 0;
+    LazyValue<std::string> lazyValue(
+        [&invocations]()
+        {
+            invocations++;
+            return std::make_unique<std::string>("explorer.exe");
+        });
+    std::vector<std::thread> threads;
+    std::vector<std::string*> results(8);
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        threads.emplace_back([&lazyValue, &results, i]() { results[i] = lazyValue.get(); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(invocations, 1);
+    for (auto* result : results)
+    {
+        EXPECT_EQ(result, results.front());
+    }
+}
+
+TEST(LazyValueTest, get_throwingFactory_retriedOnNextAccess)
+{
+    int invocations = 0;
+    LazyValue<std::string> lazyValue(
+        [&invocations]()
+        {
+            if (invocations++ == 0)
+            {
+                throw std::runtime_error("Unable to read guest memory");
+            }
+            return std::make_unique<std::string>("explorer.exe");
+        });
+
+    EXPECT_THROW(static_cast<void>(lazyValue.get()), std::runtime_error);
+    EXPECT_EQ(*lazyValue, "explorer.exe");
+    EXPECT_EQ(invocations, 2);
+}
+
+TEST(LazyValueTest, get_eagerValue_returnsValue)
+{
+    LazyValue<std::string> lazyValue(std::make_unique<std::string>("explorer.exe"));
+
+    EXPECT_EQ(*lazyValue, "explorer.exe");
+}
+
+TEST(LazyValueTest, operatorBool_noValueAndNoFactory_isFalse)
+{
+    LazyValue<std::string> lazyValue;
+
+    EXPECT_FALSE(lazyValue);
+    EXPECT_EQ(lazyValue.get(), nullptr);
+}
@@ -0,0 +1,133 @@
+#include "../../src/os/PageTableWalker.h"
+#include "../vmi/mock_LibvmiInterface.h"
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <map>
+
+using testing::_;
+using testing::AnyNumber;
+using testing::NiceMock;
+
+namespace
+{
+    constexpr uint64_t present = PagingDefinitions::tableEntryPresentBit;
+    constexpr uint64_t largePage = PagingDefinitions::tableEntryPageSizeBit;
+    constexpr uint64_t pageSize = PagingDefinitions::pageSizeInBytes;
+    constexpr uint64_t largePageSize = PagingDefinitions::largePageSizeInBytes;
+    constexpr uint64_t hugePageSize = PagingDefinitions::hugePageSizeInBytes;
+}
+
+class PageTableWalkerFixture : public testing::Test
+{
+  protected:
+    static constexpr uint64_t cr3 = 0x1000;
+    static constexpr uint64_t pdptPA = 0x2000;
+    static constexpr uint64_t pdPA = 0x3000;
+    static constexpr uint64_t ptPA = 0x4000;
+    // PD index 2 is backed by a page table, PD index 3 by a large page
+    static constexpr uint64_t smallPagesVA = 2 * largePageSize;
+    static constexpr uint64_t largePageVA = 3 * largePageSize;
+    static constexpr uint64_t smallPagesPA = 0x100000;
+    static constexpr uint64_t largePagePA = 0x40000000;
+    // PDPT index 1 maps a huge page
+    static constexpr uint64_t hugePageVA = hugePageSize;
+    static constexpr uint64_t hugePagePA = 0x80000000;
+
+    NiceMock<MockLibvmiInterface> mockVmiInterface;
+    std::map<uint64_t, std::array<uint64_t, PagingDefinitions::numberOfTableEntries>> pageTables;
+    PageTableWalker pageTableWalker{mockVmiInterface};
+
+    void SetUp() override
+    {
+        pageTables[cr3][0] = pdptPA | present;
+        pageTables[pdptPA][0] = pdPA | present;
+        pageTables[pdptPA][1] = hugePagePA | largePage | present;
+        pageTables[pdPA][2] = ptPA | present;
+        pageTables[pdPA][3] = largePagePA | largePage | present;
+        for (uint64_t i = 0; i < 4; i++)
+        {
+            pageTables[ptPA][i] = (smallPagesPA + i * pageSize) | present;
+        }
+        pageTables[ptPA][5] = 0x200000 | present;
+
+        ON_CALL(mockVmiInterface, readPA(_, _))
+            .WillByDefault(
+                [&pageTables = pageTables](uint64_t physicalAddress, std::span<uint8_t> content)
+                {
+                    auto table = pageTables.find(physicalAddress);
+                    if (table == pageTables.end() || content.size() != pageSize)
+                    {
+                        return false;
+                    }
+                    std::memcpy(content.data(), table->second.data(), content.size());
+                    return true;
+                });
+    }
+};
+
+TEST_F(PageTableWalkerFixture, translateRange_physicallyContiguousPages_singleRun)
+{
+    auto translations = pageTableWalker.translateRange(smallPagesVA, 4 * pageSize, cr3);
+
+    ASSERT_EQ(translations.size(), 1);
+    EXPECT_EQ(translations[0].virtualAddress, smallPagesVA);
+    EXPECT_EQ(translations[0].physicalAddress, smallPagesPA);
+    EXPECT_EQ(translations[0].size, 4 * pageSize);
+    EXPECT_TRUE(translations[0].present);
+}
+
+TEST_F(PageTableWalkerFixture, translateRange_nonPresentPage_separateRuns)
+{
+    auto translations = pageTableWalker.translateRange(smallPagesVA, 7 * pageSize, cr3);
+
+    ASSERT_EQ(translations.size(), 4);
+    EXPECT_FALSE(translations[1].present);
+    EXPECT_EQ(translations[1].virtualAddress, smallPagesVA + 4 * pageSize);
+    EXPECT_EQ(translations[1].size, pageSize);
+    EXPECT_EQ(translations[2].physicalAddress, 0x200000);
+    EXPECT_FALSE(translations[3].present);
+}
+
+TEST_F(PageTableWalkerFixture, translateRange_rangeInsideLargePage_offsetIntoLargePage)
+{
+    auto translations = pageTableWalker.translateRange(largePageVA + 3 * pageSize, 2 * pageSize, cr3);
+
+    ASSERT_EQ(translations.size(), 1);
+    EXPECT_EQ(translations[0].physicalAddress, largePagePA + 3 * pageSize);
+    EXPECT_EQ(translations[0].pageSize, largePageSize);
+    EXPECT_EQ(translations[0].size, 2 * pageSize);
+}
+
+TEST_F(PageTableWalkerFixture, translateRange_hugePage_leafTablesNotRead)
+{
+    EXPECT_CALL(mockVmiInterface, readPA(_, _)).Times(2);
+
+    auto translations = pageTableWalker.translateRange(hugePageVA, hugePageSize, cr3);
+
+    ASSERT_EQ(translations.size(), 1);
+    EXPECT_EQ(translations[0].physicalAddress, hugePagePA);
+    EXPECT_EQ(translations[0].pageSize, hugePageSize);
+    EXPECT_EQ(translations[0].size, hugePageSize);
+}
+
+TEST_F(PageTableWalkerFixture, translateRange_secondTranslation_onlyLeafTableReadAgain)
+{
+    EXPECT_CALL(mockVmiInterface, readPA(cr3, _)).Times(1);
+    EXPECT_CALL(mockVmiInterface, readPA(pdptPA, _)).Times(1);
+    EXPECT_CALL(mockVmiInterface, readPA(pdPA, _)).Times(1);
+    EXPECT_CALL(mockVmiInterface, readPA(ptPA, _)).Times(2);
+
+    (void)pageTableWalker.translateRange(smallPagesVA, 4 * pageSize, cr3);
+    (void)pageTableWalker.translateRange(smallPagesVA, 4 * pageSize, cr3);
+}
+
+TEST_F(PageTableWalkerFixture, translateRange_afterFlush_upperTablesReadAgain)
+{
+    EXPECT_CALL(mockVmiInterface, readPA(_, _)).Times(AnyNumber());
+    EXPECT_CALL(mockVmiInterface, readPA(cr3, _)).Times(2);
+
+    (void)pageTableWalker.translateRange(largePageVA, pageSize, cr3);
+    pageTableWalker.flush(cr3);
+    (void)pageTableWalker.translateRange(largePageVA, pageSize, cr3);
+}
@@ -0,0 +1,140 @@
+#include "../../src/os/ProcessTable.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::shared_ptr<ActiveProcessInformation> createProcessInformation(uint64_t base, pid_t pid)
+    {
+        auto processInformation = std::make_shared<ActiveProcessInformation>();
+        processInformation->base = base;
+        processInformation->processCR3 = base + 0x1000;
+        processInformation->pid = pid;
+        processInformation->parentPid = 4;
+        processInformation->name = "process" + std::to_string(pid);
+        return processInformation;
+    }
+}
+
+TEST(ProcessTableTest, insert_newProcess_findableByPidAndBase)
+{
+    ProcessTable processTable;
+    auto processInformation = createProcessInformation(0x8000, 332);
+
+    processTable.insert(processInformation);
+
+    auto snapshot = processTable.getSnapshot();
+    EXPECT_EQ(snapshot->findByPid(332), processInformation);
+    EXPECT_EQ(snapshot->findByBase(0x8000), processInformation);
+}
+
+TEST(ProcessTableTest, insert_samePid_replacesProcess)
+{
+    ProcessTable processTable;
+    processTable.insert(createProcessInformation(0x8000, 332));
+    auto reusedPidProcess = createProcessInformation(0x9000, 332);
+
+    processTable.insert(reusedPidProcess);
+
+    auto snapshot = processTable.getSnapshot();
+    EXPECT_EQ(snapshot->findByPid(332), reusedPidProcess);
+    EXPECT_EQ(snapshot->findByBase(0x8000), nullptr);
+    EXPECT_EQ(snapshot->processInformationByPid.size(), 1);
+    EXPECT_EQ(snapshot->pidsByBase.size(), 1);
+}
+
+TEST(ProcessTableTest, remove_knownProcess_returnsRemovedProcess)
+{
+    ProcessTable processTable;
+    auto processInformation = createProcessInformation(0x8000, 332);
+    processTable.insert(processInformation);
+
+    auto removedProcess = processTable.remove(0x8000);
+
+    EXPECT_EQ(removedProcess, processInformation);
+    EXPECT_EQ(processTable.getSnapshot()->findByPid(332), nullptr);
+}
+
+TEST(ProcessTableTest, remove_unknownProcess_returnsNullAndKeepsVersion)
+{
+    ProcessTable processTable;
+    auto version = processTable.getSnapshot()->version;
+
+    EXPECT_EQ(processTable.remove(0x8000), nullptr);
+    EXPECT_EQ(processTable.getSnapshot()->version, version);
+}
+
+TEST(ProcessTableTest, getSnapshot_laterChanges_snapshotUnchanged)
+{
+    ProcessTable processTable;
+    processTable.insert(createProcessInformation(0x8000, 332));
+    auto snapshot = processTable.getSnapshot();
+
+    processTable.remove(0x8000);
+    processTable.insert(createProcessInformation(0x9000, 400));
+
+    EXPECT_NE(snapshot->findByPid(332), nullptr);
+    EXPECT_EQ(snapshot->findByPid(400), nullptr);
+    EXPECT_LT(snapshot->version, processTable.getSnapshot()->version);
+}
+
+TEST(ProcessTableTest, getSnapshot_concurrentReadersAndWriter_snapshotsConsistent)
+{
+    constexpr pid_t numberOfProcesses = 64;
+    constexpr int numberOfWriterIterations = 2000;
+    ProcessTable processTable;
+    std::atomic_bool writerDone = false;
+    std::atomic_int inconsistentSnapshots = 0;
+    std::vector<std::thread> readers;
+
+    for (int reader = 0; reader < 4; reader++)
+    {
+        readers.emplace_back(
+            [&processTable, &writerDone, &inconsistentSnapshots]()
+            {
+                uint64_t lastVersion = 0;
+                while (!writerDone)
+                {
+                    auto snapshot = processTable.getSnapshot();
+                    if (snapshot->version < lastVersion ||
+                        snapshot->processInformationByPid.size() != snapshot->pidsByBase.size())
+                    {
+                        inconsistentSnapshots++;
+                    }
+                    lastVersion = snapshot->version;
+                    for (const auto& [base, pid] : snapshot->pidsByBase)
+                    {
+                        auto processInformation = snapshot->findByBase(base);
+                        if (!processInformation || processInformation->pid != pid || processInformation->base != base)
+                        {
+                            inconsistentSnapshots++;
+                        }
+                    }
+                }
+            });
+    }
+
+    for (int iteration = 0; iteration < numberOfWriterIterations; iteration++)
+    {
+        auto pid = static_cast<pid_t>(iteration % numberOfProcesses);
+        // Alternate the base to also exercise pid reuse by a different process
+        auto base = 0x10000 * static_cast<uint64_t>(pid) + (iteration / numberOfProcesses % 2) * 0x8000;
+        if (iteration % 3 == 0)
+        {
+            processTable.remove(base);
+        }
+        else
+        {
+            processTable.insert(createProcessInformation(base, pid));
+        }
+    }
+    writerDone = true;
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(inconsistentSnapshots, 0);
+}
@@ -0,0 +1,195 @@
+#include "../../../src/os/linux/ActiveProcessesSupervisor.h"
+#include "../../io/grpc/mock_GRPCLogger.h"
+#include "../../io/mock_EventStream.h"
+#include "../../io/mock_Logging.h"
+#include "../../vmi/mock_LibvmiInterface.h"
+#include <cstring>
+#include <fmt/core.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <map>
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+using testing::StrEq;
+
+namespace
+{
+    constexpr uint64_t kernelDtb = 0x1aa000;
+
+    constexpr uint64_t tasksOffset = 0x10, mmOffset = 0x20, pidOffset = 0x30, tgidOffset = 0x34,
+                       realParentOffset = 0x40, commOffset = 0x50, pgdOffset = 0x8, exeFileOffset = 0x18,
+                       fPathOffset = 0x28, pathMntOffset = 0x0, pathDentryOffset = 0x8, dNameOffset = 0x20,
+                       dParentOffset = 0x18, qstrNameOffset = 0x8, mountMntOffset = 0x20,
+                       mntMountpointOffset = 0x10, mntParentOffset = 0x8;
+
+    constexpr uint64_t taskStruct = 0x11000, parentTaskStruct = 0x12000;
+    constexpr uint64_t mm = 0x20000, pgd = 0x21000, processCr3 = 0x22000;
+    constexpr uint64_t exeFile = 0x30000, mount = 0x31000, fileDentry = 0x32000, rootDentry = 0x33000,
+                       fileDentryName = 0x34000, rootDentryName = 0x35000;
+    constexpr pid_t pid = 332, parentPid = 1;
+    const std::string comm = "bash";
+    const std::string exeFileName = "bash-static";
+}
+
+class LinuxActiveProcessesSupervisorFixture : public testing::Test
+{
+  protected:
+    std::shared_ptr<NiceMock<MockLibvmiInterface>> mockVmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+    std::shared_ptr<NiceMock<MockLogging>> mockLogging = std::make_shared<NiceMock<MockLogging>>();
+    std::shared_ptr<MockEventStream> mockEventStream = std::make_shared<MockEventStream>();
+    std::map<uint64_t, uint64_t> kernelMemory;
+    std::map<uint64_t, std::string> kernelStrings;
+    std::shared_ptr<Linux::ActiveProcessesSupervisor> activeProcessesSupervisor;
+
+    void SetUp() override
+    {
+        ON_CALL(*mockLogging, newNamedLogger(_))
+            .WillByDefault([](const std::string& /*name*/) { return std::make_unique<NiceMock<MockGRPCLogger>>(); });
+        setupKernelOffsets();
+        setupKernelMemoryAccess();
+        setupProcess();
+
+        activeProcessesSupervisor =
+            std::make_shared<Linux::ActiveProcessesSupervisor>(mockVmiInterface, mockLogging, mockEventStream);
+    }
+
+    void setupKernelOffsets()
+    {
+        ON_CALL(*mockVmiInterface, isInitialized()).WillByDefault(Return(true));
+        std::map<std::string, uint64_t> offsets{{"linux_tasks", tasksOffset},
+                                                {"linux_pid", pidOffset},
+                                                {"linux_name", commOffset},
+                                                {"linux_pgd", pgdOffset}};
+        ON_CALL(*mockVmiInterface, getOffset(_))
+            .WillByDefault([offsets](const std::string& name) { return offsets.at(name); });
+        std::map<std::string, uint64_t> structOffsets{{"task_struct.mm", mmOffset},
+                                                      {"task_struct.tgid", tgidOffset},
+                                                      {"task_struct.real_parent", realParentOffset},
+                                                      {"mm_struct.exe_file", exeFileOffset},
+                                                      {"file.f_path", fPathOffset},
+                                                      {"path.mnt", pathMntOffset},
+                                                      {"path.dentry", pathDentryOffset},
+                                                      {"dentry.d_name", dNameOffset},
+                                                      {"dentry.d_parent", dParentOffset},
+                                                      {"qstr.name", qstrNameOffset},
+                                                      {"mount.mnt", mountMntOffset},
+                                                      {"mount.mnt_mountpoint", mntMountpointOffset},
+                                                      {"mount.mnt_parent", mntParentOffset}};
+        ON_CALL(*mockVmiInterface, getKernelStructOffset(_, _))
+            .WillByDefault(
+                [structOffsets](const std::string& structName, const std::string& member)
+                {
+                    auto offset = structOffsets.find(structName + "." + member);
+                    return offset != structOffsets.end() ? offset->second : 0;
+                });
+    }
+
+    void setupKernelMemoryAccess()
+    {
+        ON_CALL(*mockVmiInterface, getKernelDtb()).WillByDefault(Return(kernelDtb));
+        ON_CALL(*mockVmiInterface, readKernel64(_))
+            .WillByDefault([this](uint64_t virtualAddress) { return kernelMemory.at(virtualAddress); });
+        ON_CALL(*mockVmiInterface, tryReadKernel64(_))
+            .WillByDefault(
+                [this](uint64_t virtualAddress) -> std::optional<uint64_t>
+                {
+                    auto value = kernelMemory.find(virtualAddress);
+                    return value != kernelMemory.end() ? std::optional(value->second) : std::nullopt;
+                });
+        ON_CALL(*mockVmiInterface, readBatchVA(kernelDtb, _))
+            .WillByDefault(
+                [this](uint64_t /*cr3*/, std::span<ReadRequest> requests)
+                {
+                    for (auto& request : requests)
+                    {
+                        auto value = kernelMemory.at(request.virtualAddress);
+                        std::memcpy(request.destination, &value, request.size);
+                        request.success = true;
+                    }
+                    return true;
+                });
+        ON_CALL(*mockVmiInterface, extractStringAtVA(_, kernelDtb))
+            .WillByDefault([this](uint64_t virtualAddress, uint64_t /*cr3*/)
+                           { return std::make_unique<std::string>(kernelStrings.at(virtualAddress)); });
+        ON_CALL(*mockVmiInterface, tryExtractStringAtVA(_, kernelDtb))
+            .WillByDefault([this](uint64_t virtualAddress, uint64_t /*cr3*/)
+                           { return std::optional(kernelStrings.at(virtualAddress)); });
+        ON_CALL(*mockVmiInterface, convertVAToPA(pgd, kernelDtb)).WillByDefault(Return(processCr3));
+    }
+
+    // Process with the executable /bash-static, whose parent is pid 1
+    void setupProcess()
+    {
+        kernelMemory[taskStruct + mmOffset] = mm;
+        kernelMemory[taskStruct + realParentOffset] = parentTaskStruct;
+        kernelMemory[taskStruct + pidOffset] = pid;
+        kernelMemory[parentTaskStruct + tgidOffset] = parentPid;
+        kernelStrings[taskStruct + commOffset] = comm;
+        kernelMemory[mm + pgdOffset] = pgd;
+        kernelMemory[mm + exeFileOffset] = exeFile;
+
+        kernelMemory[exeFile + fPathOffset + pathMntOffset] = mount + mountMntOffset;
+        kernelMemory[exeFile + fPathOffset + pathDentryOffset] = fileDentry;
+        kernelMemory[mount + mountMntOffset] = rootDentry;
+        kernelMemory[mount + mntMountpointOffset] = rootDentry;
+        kernelMemory[mount + mntParentOffset] = mount;
+        kernelMemory[fileDentry + dNameOffset + qstrNameOffset] = fileDentryName;
+        kernelMemory[fileDentry + dParentOffset] = rootDentry;
+        kernelStrings[fileDentryName] = exeFileName;
+        kernelMemory[rootDentry + dNameOffset + qstrNameOffset] = rootDentryName;
+        kernelMemory[rootDentry + dParentOffset] = rootDentry;
+        kernelStrings[rootDentryName] = "/";
+    }
+};
+
+TEST_F(LinuxActiveProcessesSupervisorFixture, registerNewProcess_newProcess_pendingWithCommandNameWithoutStartEvent)
+{
+    EXPECT_CALL(*mockEventStream, sendProcessEvent(_, _, _, _)).Times(0);
+    EXPECT_CALL(*mockVmiInterface, readKernel64(mm + exeFileOffset)).Times(0);
+
+    EXPECT_NO_THROW(activeProcessesSupervisor->registerNewProcess(taskStruct));
+
+    auto processInformation = activeProcessesSupervisor->getProcessInformationByBase(taskStruct);
+    EXPECT_TRUE(processInformation->enrichmentPending);
+    EXPECT_EQ(processInformation->pid, pid);
+    EXPECT_EQ(processInformation->parentPid, parentPid);
+    EXPECT_EQ(processInformation->processCR3, processCr3);
+    EXPECT_EQ(*processInformation->fullName, comm);
+    EXPECT_TRUE(processInformation->processPath->empty());
+}
+
+TEST_F(LinuxActiveProcessesSupervisorFixture, enrichProcess_registeredProcess_completeWithPathAndStartEvent)
+{
+    activeProcessesSupervisor->registerNewProcess(taskStruct);
+
+    EXPECT_CALL(*mockEventStream,
+                sendProcessEvent(::grpc::ProcessState::Started,
+                                 StrEq(comm),
+                                 static_cast<uint32_t>(pid),
+                                 StrEq(fmt::format("{:#x}", processCr3))))
+        .Times(1);
+    EXPECT_NO_THROW(activeProcessesSupervisor->enrichProcess(taskStruct));
+
+    auto processInformation = activeProcessesSupervisor->getProcessInformationByBase(taskStruct);
+    EXPECT_FALSE(processInformation->enrichmentPending);
+    EXPECT_EQ(*processInformation->processPath, "/" + exeFileName);
+    EXPECT_EQ(*processInformation->fullName, exeFileName);
+}
+
+TEST_F(LinuxActiveProcessesSupervisorFixture, enrichProcess_alreadyEnrichedProcess_noSecondStartEvent)
+{
+    activeProcessesSupervisor->registerNewProcess(taskStruct);
+
+    EXPECT_CALL(*mockEventStream, sendProcessEvent(::grpc::ProcessState::Started, _, _, _)).Times(1);
+    activeProcessesSupervisor->enrichProcess(taskStruct);
+    activeProcessesSupervisor->enrichProcess(taskStruct);
+}
+
+TEST_F(LinuxActiveProcessesSupervisorFixture, enrichProcess_unknownProcess_noStartEvent)
+{
+    EXPECT_CALL(*mockEventStream, sendProcessEvent(_, _, _, _)).Times(0);
+
+    EXPECT_NO_THROW(activeProcessesSupervisor->enrichProcess(taskStruct));
+}
@@ -0,0 +1,107 @@
+#include "../../../src/os/linux/KernelOffsets.h"
+#include "../../../src/vmi/VmiException.h"
+#include "../../vmi/mock_LibvmiInterface.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <map>
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+using testing::Throw;
+
+namespace
+{
+    constexpr uint64_t vmAreaStructSize = 0xb8;
+}
+
+class LinuxKernelOffsetsFixture : public testing::Test
+{
+  protected:
+    std::shared_ptr<NiceMock<MockLibvmiInterface>> mockVmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+    // Every offset is distinct, so an offset resolved from the wrong member is detected
+    std::map<std::string, uint64_t> offsets{
+        {"linux_tasks", 0x10}, {"linux_pid", 0x30}, {"linux_name", 0x50}, {"linux_pgd", 0x8}};
+    std::map<std::string, uint64_t> structOffsets{{"task_struct.mm", 0x20},
+                                                  {"task_struct.tgid", 0x34},
+                                                  {"task_struct.real_parent", 0x40},
+                                                  {"mm_struct.exe_file", 0x18},
+                                                  {"vm_area_struct.vm_start", 0x0},
+                                                  {"vm_area_struct.vm_end", 0x28},
+                                                  {"vm_area_struct.vm_next", 0x38},
+                                                  {"vm_area_struct.vm_flags", 0x48},
+                                                  {"vm_area_struct.vm_file", 0x58},
+                                                  {"file.f_path", 0x68},
+                                                  {"path.mnt", 0x70},
+                                                  {"path.dentry", 0x78},
+                                                  {"dentry.d_name", 0x80},
+                                                  {"dentry.d_parent", 0x88},
+                                                  {"qstr.name", 0x90},
+                                                  {"mount.mnt", 0x98},
+                                                  {"mount.mnt_mountpoint", 0xa0},
+                                                  {"mount.mnt_parent", 0xa8}};
+
+    void SetUp() override
+    {
+        ON_CALL(*mockVmiInterface, isInitialized()).WillByDefault(Return(true));
+        ON_CALL(*mockVmiInterface, getOffset(_))
+            .WillByDefault([this](const std::string& name) { return offsets.at(name); });
+        ON_CALL(*mockVmiInterface, getKernelStructOffset(_, _))
+            .WillByDefault([this](const std::string& structName, const std::string& member)
+                           { return structOffsets.at(structName + "." + member); });
+        ON_CALL(*mockVmiInterface, getStructSizeFromJson("vm_area_struct")).WillByDefault(Return(vmAreaStructSize));
+    }
+};
+
+TEST_F(LinuxKernelOffsetsFixture, init_vmiInterfaceNotInitialized_throwsInvalidArgument)
+{
+    ON_CALL(*mockVmiInterface, isInitialized()).WillByDefault(Return(false));
+
+    EXPECT_THROW((void)Linux::KernelOffsets::init(mockVmiInterface), std::invalid_argument);
+}
+
+TEST_F(LinuxKernelOffsetsFixture, init_validProfile_offsetsResolvedFromProfile)
+{
+    auto kernelOffsets = Linux::KernelOffsets::init(mockVmiInterface);
+
+    EXPECT_EQ(kernelOffsets.taskStruct.tasks, offsets.at("linux_tasks"));
+    EXPECT_EQ(kernelOffsets.taskStruct.mm, structOffsets.at("task_struct.mm"));
+    EXPECT_EQ(kernelOffsets.taskStruct.pid, offsets.at("linux_pid"));
+    EXPECT_EQ(kernelOffsets.taskStruct.tgid, structOffsets.at("task_struct.tgid"));
+    EXPECT_EQ(kernelOffsets.taskStruct.real_parent, structOffsets.at("task_struct.real_parent"));
+    EXPECT_EQ(kernelOffsets.taskStruct.comm, offsets.at("linux_name"));
+    EXPECT_EQ(kernelOffsets.mmStruct.pgd, offsets.at("linux_pgd"));
+    EXPECT_EQ(kernelOffsets.mmStruct.exe_file, structOffsets.at("mm_struct.exe_file"));
+    EXPECT_EQ(kernelOffsets.vmAreaStruct.vm_start, structOffsets.at("vm_area_struct.vm_start"));
+    EXPECT_EQ(kernelOffsets.vmAreaStruct.vm_end, structOffsets.at("vm_area_struct.vm_end"));
+    EXPECT_EQ(kernelOffsets.vmAreaStruct.vm_next, structOffsets.at("vm_area_struct.vm_next"));
+    EXPECT_EQ(kernelOffsets.vmAreaStruct.vm_flags, structOffsets.at("vm_area_struct.vm_flags"));
+    EXPECT_EQ(kernelOffsets.vmAreaStruct.vm_file, structOffsets.at("vm_area_struct.vm_file"));
+    EXPECT_EQ(kernelOffsets.vmAreaStruct.size, vmAreaStructSize);
+    EXPECT_EQ(kernelOffsets.file.f_path, structOffsets.at("file.f_path"));
+    EXPECT_EQ(kernelOffsets.path.mnt, structOffsets.at("path.mnt"));
+    EXPECT_EQ(kernelOffsets.path.dentry, structOffsets.at("path.dentry"));
+    EXPECT_EQ(kernelOffsets.dentry.d_name, structOffsets.at("dentry.d_name"));
+    EXPECT_EQ(kernelOffsets.dentry.d_parent, structOffsets.at("dentry.d_parent"));
+    EXPECT_EQ(kernelOffsets.qstr.name, structOffsets.at("qstr.name"));
+    EXPECT_EQ(kernelOffsets.mount.mnt, structOffsets.at("mount.mnt"));
+    EXPECT_EQ(kernelOffsets.mount.mnt_mountpoint, structOffsets.at("mount.mnt_mountpoint"));
+    EXPECT_EQ(kernelOffsets.mount.mnt_parent, structOffsets.at("mount.mnt_parent"));
+}
+
+TEST_F(LinuxKernelOffsetsFixture, init_validProfile_eachOffsetLookedUpOnce)
+{
+    EXPECT_CALL(*mockVmiInterface, getOffset(_)).Times(offsets.size());
+    EXPECT_CALL(*mockVmiInterface, getKernelStructOffset(_, _)).Times(structOffsets.size());
+    EXPECT_CALL(*mockVmiInterface, getStructSizeFromJson(_)).Times(1);
+
+    (void)Linux::KernelOffsets::init(mockVmiInterface);
+}
+
+TEST_F(LinuxKernelOffsetsFixture, init_memberMissingFromProfile_throwsVmiException)
+{
+    ON_CALL(*mockVmiInterface, getKernelStructOffset("vm_area_struct", "vm_next"))
+        .WillByDefault(Throw(VmiException("Member vm_next not found in profile")));
+
+    EXPECT_THROW((void)Linux::KernelOffsets::init(mockVmiInterface), VmiException);
+}
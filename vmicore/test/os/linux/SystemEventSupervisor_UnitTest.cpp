@@ -0,0 +1,283 @@
+#include "../../../src/os/linux/SystemEventSupervisor.h"
+#include "../../config/mock_ConfigInterface.h"
+#include "../../io/grpc/mock_GRPCLogger.h"
+#include "../../io/mock_EventStream.h"
+#include "../../io/mock_Logging.h"
+#include "../../plugins/mock_PluginSystem.h"
+#include "../../vmi/mock_InterruptFactory.h"
+#include "../../vmi/mock_LibvmiInterface.h"
+#include "../mock_ActiveProcessesSupervisor.h"
+#include <chrono>
+#include <config.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using testing::_;
+using testing::InSequence;
+using testing::InvokeWithoutArgs;
+using testing::NiceMock;
+using testing::Return;
+
+namespace
+{
+    constexpr uint64_t testTaskStructBase = 0xffff888012345000;
+    constexpr uint64_t otherTestTaskStructBase = 0xffff888012346000;
+    constexpr uint testNumberOfVcpus = 2;
+    constexpr uint32_t testVcpuId = 1;
+}
+
+class SystemEventSupervisorFixture : public testing::Test
+{
+  protected:
+    std::shared_ptr<MockLibvmiInterface> vmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+    std::shared_ptr<MockPluginSystem> pluginSystem = std::make_shared<NiceMock<MockPluginSystem>>();
+    std::shared_ptr<MockActiveProcessesSupervisor> activeProcessSupervisor =
+        std::make_shared<NiceMock<MockActiveProcessesSupervisor>>();
+    std::shared_ptr<MockConfigInterface> configInterface = std::make_shared<NiceMock<MockConfigInterface>>();
+    std::shared_ptr<MockInterruptFactory> interruptFactory = std::make_shared<MockInterruptFactory>();
+    std::shared_ptr<MockLogging> logging = std::make_shared<NiceMock<MockLogging>>();
+    std::shared_ptr<MockEventStream> eventStream = std::make_shared<MockEventStream>();
+    std::shared_ptr<Linux::SystemEventSupervisor> systemEventSupervisor =
+        std::make_shared<Linux::SystemEventSupervisor>(vmiInterface,
+                                                       pluginSystem,
+                                                       activeProcessSupervisor,
+                                                       configInterface,
+                                                       interruptFactory,
+                                                       logging,
+                                                       eventStream);
+    std::shared_ptr<InterruptEvent> procForkInterruptEvent;
+    std::shared_ptr<InterruptEvent> procExecInterruptEvent;
+    std::shared_ptr<InterruptEvent> procExitInterruptEvent;
+    std::function<InterruptEvent::InterruptResponse(InterruptEvent&)> procForkCallback;
+    std::function<InterruptEvent::InterruptResponse(InterruptEvent&)> procExecCallback;
+    std::function<InterruptEvent::InterruptResponse(InterruptEvent&)> procExitCallback;
+    registers_t registers{};
+
+    void SetUp() override
+    {
+        ON_CALL(*logging, newNamedLogger(_))
+            .WillByDefault([](const std::string& /*name*/) { return std::make_unique<NiceMock<MockGRPCLogger>>(); });
+    }
+
+    void TearDown() override
+    {
+        InterruptEvent::clearInterruptEventHandling(*vmiInterface);
+    }
+
+    void initializeWithPerVcpuEventProcessing()
+    {
+        ON_CALL(*configInterface, isPerVcpuEventProcessingEnabled()).WillByDefault(Return(true));
+        ON_CALL(*vmiInterface, getNumberOfVCPUs()).WillByDefault(Return(testNumberOfVcpus));
+        // The registers of an interrupt are read from the event registered with libvmi
+        ON_CALL(*vmiInterface, registerEvent(_))
+            .WillByDefault(
+                [this](vmi_event_t& event)
+                {
+                    event.x86_regs = &registers.x86;
+                    event.vcpu_id = testVcpuId;
+                });
+        InterruptEvent::initializeInterruptEventHandling(*vmiInterface);
+
+        EXPECT_CALL(*interruptFactory, initialize()).Times(1);
+        EXPECT_CALL(*interruptFactory, createInterruptEvent(_, _, _, _))
+            .WillRepeatedly(
+                [this](const std::string& name,
+                       uint64_t /*targetVA*/,
+                       uint64_t /*systemCr3*/,
+                       const std::function<InterruptEvent::InterruptResponse(InterruptEvent&)>& callback)
+                {
+                    if (name == "procForkConnectorEvent")
+                    {
+                        procForkCallback = callback;
+                    }
+                    else if (name == "procExecConnectorEvent")
+                    {
+                        procExecCallback = callback;
+                    }
+                    else if (name == "procExitConnectorEvent")
+                    {
+                        procExitCallback = callback;
+                    }
+                    return nullptr;
+                });
+        systemEventSupervisor->initialize();
+
+        procForkInterruptEvent = std::make_shared<InterruptEvent>(
+            vmiInterface, 0, nullptr, nullptr, nullptr, procForkCallback, nullptr, nullptr);
+        procExecInterruptEvent = std::make_shared<InterruptEvent>(
+            vmiInterface, 0, nullptr, nullptr, nullptr, procExecCallback, nullptr, nullptr);
+        procExitInterruptEvent = std::make_shared<InterruptEvent>(
+            vmiInterface, 0, nullptr, nullptr, nullptr, procExitCallback, nullptr, nullptr);
+    }
+
+    void setTaskStructArgument(uint64_t taskStructBase)
+    {
+#if defined(X86_64)
+        registers.x86.rdi = taskStructBase;
+#elif defined(ARM64)
+        registers.arm.regs[0] = taskStructBase;
+#endif
+    }
+
+    InterruptEvent::InterruptResponse forkProcess(uint64_t taskStructBase)
+    {
+        setTaskStructArgument(taskStructBase);
+        return procForkCallback(*procForkInterruptEvent);
+    }
+
+    InterruptEvent::InterruptResponse execProcess(uint64_t taskStructBase)
+    {
+        setTaskStructArgument(taskStructBase);
+        return procExecCallback(*procExecInterruptEvent);
+    }
+
+    InterruptEvent::InterruptResponse exitProcess(uint64_t taskStructBase)
+    {
+        setTaskStructArgument(taskStructBase);
+        return procExitCallback(*procExitInterruptEvent);
+    }
+};
+
+TEST_F(SystemEventSupervisorFixture, teardown_validState_interruptFactoryTeardownCalled)
+{
+    EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+
+    EXPECT_NO_THROW(systemEventSupervisor->teardown());
+}
+
+TEST_F(SystemEventSupervisorFixture, procExitConnectorCallback_exitEvent_deferredPluginsNotifiedOnWorkerAfterRemoval)
+{
+    initializeWithPerVcpuEventProcessing();
+    auto notifyingThread = std::thread::id{};
+    auto deferredNotifyingThread = std::thread::id{};
+    {
+        InSequence s;
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToRegisteredPlugins(_))
+            .WillOnce(InvokeWithoutArgs([&notifyingThread]() { notifyingThread = std::this_thread::get_id(); }));
+        EXPECT_CALL(*activeProcessSupervisor, removeActiveProcess(testTaskStructBase));
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToDeferredPlugins(_))
+            .WillOnce(InvokeWithoutArgs([&deferredNotifyingThread]()
+                                        { deferredNotifyingThread = std::this_thread::get_id(); }));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+
+    exitProcess(testTaskStructBase);
+    systemEventSupervisor->teardown();
+
+    EXPECT_EQ(notifyingThread, std::this_thread::get_id());
+    EXPECT_NE(deferredNotifyingThread, std::this_thread::get_id());
+}
+
+TEST_F(SystemEventSupervisorFixture, teardown_pendingDeferredPluginNotification_drainedBeforeInterruptFactoryTeardown)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToDeferredPlugins(_))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    exitProcess(testTaskStructBase);
+
+    systemEventSupervisor->teardown();
+}
+
+TEST_F(SystemEventSupervisorFixture, procExitConnectorCallback_exitEvent_pendingWorkDrainedFirst)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToRegisteredPlugins(_));
+        EXPECT_CALL(*activeProcessSupervisor, removeActiveProcess(testTaskStructBase));
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToDeferredPlugins(_))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToRegisteredPlugins(_));
+        EXPECT_CALL(*activeProcessSupervisor, removeActiveProcess(otherTestTaskStructBase));
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToDeferredPlugins(_));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    exitProcess(testTaskStructBase);
+
+    exitProcess(otherTestTaskStructBase);
+    systemEventSupervisor->teardown();
+}
+
+TEST_F(SystemEventSupervisorFixture, procForkConnectorCallback_processStart_registeredBeforeResponse)
+{
+    initializeWithPerVcpuEventProcessing();
+    bool processRegistered = false;
+    auto registeringThread = std::thread::id{};
+    auto enrichingThread = std::thread::id{};
+    {
+        InSequence s;
+        EXPECT_CALL(*activeProcessSupervisor, registerNewProcess(testTaskStructBase))
+            .WillOnce(InvokeWithoutArgs(
+                [&processRegistered, &registeringThread]()
+                {
+                    processRegistered = true;
+                    registeringThread = std::this_thread::get_id();
+                }));
+        EXPECT_CALL(*activeProcessSupervisor, enrichProcess(testTaskStructBase))
+            .WillOnce(InvokeWithoutArgs([&enrichingThread]() { enrichingThread = std::this_thread::get_id(); }));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    EXPECT_CALL(*activeProcessSupervisor, addNewProcess(_)).Times(0);
+
+    forkProcess(testTaskStructBase);
+    EXPECT_TRUE(processRegistered);
+    systemEventSupervisor->teardown();
+
+    EXPECT_EQ(registeringThread, std::this_thread::get_id());
+    EXPECT_NE(enrichingThread, std::this_thread::get_id());
+}
+
+TEST_F(SystemEventSupervisorFixture, teardown_pendingProcessEnrichment_drainedBeforeInterruptFactoryTeardown)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*activeProcessSupervisor, enrichProcess(testTaskStructBase))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    forkProcess(testTaskStructBase);
+
+    systemEventSupervisor->teardown();
+}
+
+TEST_F(SystemEventSupervisorFixture, procExecConnectorCallback_pendingForkEnrichment_drainedFirst)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*activeProcessSupervisor, enrichProcess(testTaskStructBase))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*activeProcessSupervisor, registerNewProcess(testTaskStructBase));
+        EXPECT_CALL(*activeProcessSupervisor, enrichProcess(testTaskStructBase));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    // The registration by the fork itself
+    EXPECT_CALL(*activeProcessSupervisor, registerNewProcess(testTaskStructBase)).RetiresOnSaturation();
+    forkProcess(testTaskStructBase);
+
+    execProcess(testTaskStructBase);
+    systemEventSupervisor->teardown();
+}
+
+TEST_F(SystemEventSupervisorFixture, procExitConnectorCallback_exitEvent_pendingEnrichmentDrainedFirst)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*activeProcessSupervisor, enrichProcess(testTaskStructBase))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*activeProcessSupervisor, getProcessInformationByBase(testTaskStructBase));
+        EXPECT_CALL(*activeProcessSupervisor, removeActiveProcess(testTaskStructBase));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    forkProcess(testTaskStructBase);
+
+    exitProcess(testTaskStructBase);
+    systemEventSupervisor->teardown();
+}
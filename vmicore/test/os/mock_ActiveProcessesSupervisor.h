@@ -1,4 +1,4 @@
-#include "../../../src/os/IActiveProcessesSupervisor.h"
+#include "../../src/os/IActiveProcessesSupervisor.h"
 #include <gmock/gmock.h>
 
 class MockActiveProcessesSupervisor : public IActiveProcessesSupervisor
@@ -12,10 +12,19 @@ class MockActiveProcessesSupervisor : public IActiveProcessesSupervisor
 
     MOCK_METHOD(void, addNewProcess, (uint64_t), (override));
 
+    MOCK_METHOD(void, registerNewProcess, (uint64_t), (override));
+
+    MOCK_METHOD(void, enrichProcess, (uint64_t), (override));
+
     MOCK_METHOD(void, removeActiveProcess, (uint64_t), (override));
 
     MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
                 getActiveProcesses,
                 (),
                 (const override));
+
+    MOCK_METHOD(std::vector<std::unique_ptr<std::list<MemoryRegion>>>,
+                extractAllMemoryRegions,
+                (const std::vector<std::shared_ptr<const ActiveProcessInformation>>&),
+                (const override));
 };
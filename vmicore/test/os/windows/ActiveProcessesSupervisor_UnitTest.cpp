@@ -3,7 +3,10 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+using testing::_;
+using testing::AnyNumber;
 using testing::Contains;
+using testing::Mock;
 using testing::Not;
 using testing::StrEq;
 using testing::UnorderedElementsAre;
@@ -86,6 +89,95 @@ TEST_F(ActiveProcessesSupervisorFixture, addNewProcess_process332_processStartEv
     EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process332.eprocessBase));
 }
 
+TEST_F(ActiveProcessesSupervisorFixture, initialize_preexistingProcesses_processPathsReadOnFirstAccess)
+{
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(0);
+    EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+    Mock::VerifyAndClearExpectations(mockVmiInterface.get());
+    auto processInformation = activeProcessesSupervisor->getProcessInformationByPid(process248.processId);
+
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(1);
+    EXPECT_EQ(*processInformation->fullName, process248.fullName);
+    EXPECT_EQ(*processInformation->processPath, process248.filePath);
+}
+
+TEST_F(ActiveProcessesSupervisorFixture, enrichProcess_registeredProcess332_processPathReadOnFirstAccess)
+{
+    EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+    setupProcessWithLink(process332, process0.eprocessBase);
+
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(0);
+    activeProcessesSupervisor->registerNewProcess(process332.eprocessBase);
+    activeProcessesSupervisor->enrichProcess(process332.eprocessBase);
+    Mock::VerifyAndClearExpectations(mockVmiInterface.get());
+    auto processInformation = activeProcessesSupervisor->getProcessInformationByBase(process332.eprocessBase);
+
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(1);
+    EXPECT_EQ(*processInformation->fullName, process332.fullName);
+}
+
+TEST_F(ActiveProcessesSupervisorFixture, removeActiveProcess_processPathNotAccessedYet_processPathReadBeforeRemoval)
+{
+    EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+    auto processInformation = activeProcessesSupervisor->getProcessInformationByPid(process248.processId);
+
+    activeProcessesSupervisor->removeActiveProcess(process248.eprocessBase);
+
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(0);
+    EXPECT_EQ(*processInformation->fullName, process248.fullName);
+    EXPECT_EQ(*processInformation->processPath, process248.filePath);
+}
+
+TEST_F(ActiveProcessesSupervisorFixture, registerNewProcess_process332_processPendingWithoutStartEvent)
+{
+    EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+    setupProcessWithLink(process332, process0.eprocessBase);
+
+    EXPECT_CALL(*mockEventStream,
+                sendProcessEvent(
+                    ::grpc::ProcessState::Started, StrEq(process332.imageFileName), process332.processId, _))
+        .Times(0);
+    EXPECT_NO_THROW(activeProcessesSupervisor->registerNewProcess(process332.eprocessBase));
+
+    auto processInformation = activeProcessesSupervisor->getProcessInformationByBase(process332.eprocessBase);
+    EXPECT_TRUE(processInformation->enrichmentPending);
+    EXPECT_EQ(processInformation->processCR3, process332.directoryTableBase);
+    EXPECT_EQ(processInformation->pid, process332.processId);
+    EXPECT_NE(processInformation->memoryRegionExtractor.get(), nullptr);
+}
+
+TEST_F(ActiveProcessesSupervisorFixture, registerNewProcess_process332_imageNameAsFullNameWithoutPath)
+{
+    EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+    setupProcessWithLink(process332, process0.eprocessBase);
+
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(0);
+    EXPECT_NO_THROW(activeProcessesSupervisor->registerNewProcess(process332.eprocessBase));
+
+    auto processInformation = activeProcessesSupervisor->getProcessInformationByBase(process332.eprocessBase);
+    EXPECT_EQ(*processInformation->fullName, process332.imageFileName);
+    EXPECT_TRUE(processInformation->processPath->empty());
+}
+
+TEST_F(ActiveProcessesSupervisorFixture, enrichProcess_registeredProcess332_processCompleteWithStartEvent)
+{
+    EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+    setupProcessWithLink(process332, process0.eprocessBase);
+    activeProcessesSupervisor->registerNewProcess(process332.eprocessBase);
+
+    EXPECT_CALL(*mockEventStream,
+                sendProcessEvent(::grpc::ProcessState::Started,
+                                 StrEq(process332.imageFileName),
+                                 process332.processId,
+                                 StrEq(fmt::format("{:#x}", process332.cr3))))
+        .Times(1);
+    EXPECT_NO_THROW(activeProcessesSupervisor->enrichProcess(process332.eprocessBase));
+
+    auto processInformation = activeProcessesSupervisor->getProcessInformationByBase(process332.eprocessBase);
+    EXPECT_FALSE(processInformation->enrichmentPending);
+    EXPECT_THAT(processInformation, IsEqualProcess(process332));
+}
+
 TEST_F(ActiveProcessesSupervisorFixture, removeActiveProcess_presentProcess_processRemoved)
 {
     EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
@@ -121,6 +213,33 @@ TEST_F(ActiveProcessesSupervisorFixture, removeNotActiveProcess_inactiveProcess_
     EXPECT_THAT(*activeProcesses, UnorderedElementsAre(IsEqualProcess(process4), IsEqualProcess(process248)));
 }
 
+TEST_F(ActiveProcessesSupervisorFixture, getActiveProcesses_calledTwice_exitStatusesReadOnceInBatch)
+{
+    EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+
+    EXPECT_CALL(*mockVmiInterface, readBatchVA(_, _)).Times(1);
+    EXPECT_CALL(*mockVmiInterface, read32VA(_, _)).Times(AnyNumber());
+    EXPECT_CALL(*mockVmiInterface, read32VA(process4.eprocessBase + _EPROCESS_OFFSETS::ExitStatus, _)).Times(1);
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>> activeProcesses;
+    EXPECT_NO_THROW(activeProcesses = activeProcessesSupervisor->getActiveProcesses());
+    EXPECT_NO_THROW(activeProcesses = activeProcessesSupervisor->getActiveProcesses());
+
+    EXPECT_THAT(*activeProcesses, UnorderedElementsAre(IsEqualProcess(process4), IsEqualProcess(process248)));
+}
+
+TEST_F(ActiveProcessesSupervisorFixture, getActiveProcesses_processAddedAfterPreviousCall_containsNewProcess)
+{
+    EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
+    EXPECT_NO_THROW(static_cast<void>(activeProcessesSupervisor->getActiveProcesses()));
+    setupProcessWithLink(process332, process0.eprocessBase);
+
+    EXPECT_NO_THROW(activeProcessesSupervisor->addNewProcess(process332.eprocessBase));
+
+    std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>> activeProcesses;
+    EXPECT_NO_THROW(activeProcesses = activeProcessesSupervisor->getActiveProcesses());
+    EXPECT_THAT(*activeProcesses, Contains(IsEqualProcess(process332)));
+}
+
 TEST_F(ActiveProcessesSupervisorFixture, getProcessInformationByPid_validPid_correctProcessInformation)
 {
     EXPECT_NO_THROW(activeProcessesSupervisor->initialize());
@@ -1,8 +1,10 @@
 #include "../../src/os/PagingDefinitions.h"
 #include "../../vmi/ProcessesMemoryState.h"
+#include <array>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+using testing::_;
 using testing::Contains;
 using testing::Not;
 using testing::StrEq;
@@ -32,3 +34,83 @@ TEST_F(KernelAccessFixture, extractFileName_MalformedKernelspaceAddress_Throws)
     EXPECT_THROW(auto filename = kernelAccess->extractFileName(~PagingDefinitions::kernelspaceLowerBoundary),
                  std::invalid_argument);
 }
+
+TEST_F(KernelAccessFixture, extractPID_ValidEprocess_UsesCachedKernelDtb)
+{
+    setupReturns(process248);
+    EXPECT_CALL(*mockVmiInterface, convertPidToDtb(_)).Times(0);
+
+    EXPECT_EQ(kernelAccess->extractPID(process248.eprocessBase), process248.processId);
+}
+
+TEST_F(KernelAccessFixture, extractMmVadSnapshot_ValidVadEntry_SingleReadForAllVadShortFields)
+{
+    systemVadTreeRootNodeMemoryState();
+    EXPECT_CALL(*mockVmiInterface, readXVA(vadRootNodeBase, systemCR3, _)).Times(1);
+
+    auto mmVad = kernelAccess->extractMmVadSnapshot(vadRootNodeBase);
+    auto vadShortValues = kernelAccess->extractMmVadShortValues(mmVad);
+    auto [leftChildAddress, rightChildAddress] = kernelAccess->extractMmVadShortChildNodeAddresses(mmVad);
+
+    EXPECT_EQ(mmVad.size(), _MMVAD_SIZES::MMVAD);
+    EXPECT_EQ(vadShortValues.startingVpn, vadRootNodeStartingVpn);
+    EXPECT_EQ(vadShortValues.endingVpn, vadRootNodeEndingVpn);
+    EXPECT_EQ(leftChildAddress, vadRootNodeLeftChildBase);
+    EXPECT_EQ(rightChildAddress, vadRootNodeRightChildBase);
+}
+
+TEST_F(KernelAccessFixture, extractMmVadSnapshot_FullVadUnreadable_FallsBackToVadShort)
+{
+    systemVadTreeRootNodeMemoryState();
+    ON_CALL(*mockVmiInterface, readXVA(vadRootNodeBase, systemCR3, testing::SizeIs(_MMVAD_SIZES::MMVAD)))
+        .WillByDefault(Return(false));
+
+    auto mmVad = kernelAccess->extractMmVadSnapshot(vadRootNodeBase);
+
+    EXPECT_EQ(mmVad.size(), _MMVAD_OFFSETS::BaseAddress + _MMVAD_SIZES::MMVAD_SHORT);
+    EXPECT_THROW((void)kernelAccess->extractControlAreaBasePointer(mmVad), VmiException);
+}
+
+TEST_F(KernelAccessFixture, tryExtractMmVadSnapshot_UnreadableVadEntry_ReturnsNulloptWithoutThrowing)
+{
+    systemVadTreeRootNodeMemoryState();
+    ON_CALL(*mockVmiInterface, readXVA(vadRootNodeBase, systemCR3, _)).WillByDefault(Return(false));
+
+    std::optional<StructSnapshot> mmVad;
+    ASSERT_NO_THROW(mmVad = kernelAccess->tryExtractMmVadSnapshot(vadRootNodeBase));
+
+    EXPECT_FALSE(mmVad.has_value());
+    EXPECT_THROW((void)kernelAccess->extractMmVadSnapshot(vadRootNodeBase), VmiException);
+}
+
+TEST_F(KernelAccessFixture, tryExtractMmVadSnapshot_UserspaceAddress_ReturnsNullopt)
+{
+    EXPECT_CALL(*mockVmiInterface, readXVA(_, _, _)).Times(0);
+
+    EXPECT_FALSE(kernelAccess->tryExtractMmVadSnapshot(0x1000).has_value());
+}
+
+TEST_F(KernelAccessFixture, tryExtractMmVadSnapshot_FullSharedVadUnreadable_ReturnsNullopt)
+{
+    systemVadTreeRightChildOfRootNodeMemoryState();
+    ON_CALL(*mockVmiInterface, readXVA(vadRootNodeRightChildBase, systemCR3, testing::SizeIs(_MMVAD_SIZES::MMVAD)))
+        .WillByDefault(Return(false));
+
+    EXPECT_FALSE(kernelAccess->tryExtractMmVadSnapshot(vadRootNodeRightChildBase).has_value());
+}
+
+TEST_F(KernelAccessFixture, tryExtractMmVadSnapshots_FullVadsUnreadable_FallsBackToVadShortOnlyForPrivateVads)
+{
+    systemVadTreeRootNodeMemoryState();
+    systemVadTreeRightChildOfRootNodeMemoryState();
+    ON_CALL(*mockVmiInterface, readXVA(_, systemCR3, testing::SizeIs(_MMVAD_SIZES::MMVAD)))
+        .WillByDefault(Return(false));
+    std::array vadEntryBaseVAs{vadRootNodeBase, vadRootNodeRightChildBase};
+
+    auto mmVads = kernelAccess->tryExtractMmVadSnapshots(vadEntryBaseVAs);
+
+    ASSERT_EQ(mmVads.size(), 2);
+    ASSERT_TRUE(mmVads[0].has_value());
+    EXPECT_EQ(mmVads[0]->size(), _MMVAD_OFFSETS::BaseAddress + _MMVAD_SIZES::MMVAD_SHORT);
+    EXPECT_FALSE(mmVads[1].has_value());
+}
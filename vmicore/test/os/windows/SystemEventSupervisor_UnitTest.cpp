@@ -1,15 +1,31 @@
 #include "../../../src/os/windows/SystemEventSupervisor.h"
 #include "../../config/mock_ConfigInterface.h"
+#include "../../io/grpc/mock_GRPCLogger.h"
 #include "../../io/mock_EventStream.h"
 #include "../../io/mock_Logging.h"
 #include "../../plugins/mock_PluginSystem.h"
 #include "../../vmi/mock_InterruptFactory.h"
 #include "../../vmi/mock_LibvmiInterface.h"
-#include "mock_ActiveProcessesSupervisor.h"
+#include "../mock_ActiveProcessesSupervisor.h"
+#include <chrono>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <thread>
 
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+using testing::InvokeWithoutArgs;
 using testing::NiceMock;
+using testing::Return;
+
+namespace
+{
+    constexpr uint64_t testEprocessBase = 0xffff800012345000;
+    constexpr uint64_t otherTestEprocessBase = 0xffff800012346000;
+    constexpr uint testNumberOfVcpus = 2;
+    constexpr uint32_t testVcpuId = 1;
+}
 
 class SystemEventSupervisorFixture : public testing::Test
 {
@@ -30,6 +46,59 @@ class SystemEventSupervisorFixture : public testing::Test
                                                          interruptFactory,
                                                          logging,
                                                          eventStream);
+    std::shared_ptr<InterruptEvent> notifyProcessInterruptEvent;
+    std::function<InterruptEvent::InterruptResponse(InterruptEvent&)> notifyProcessCallback;
+    x86_registers_t registers{};
+
+    void SetUp() override
+    {
+        ON_CALL(*logging, newNamedLogger(_))
+            .WillByDefault([](const std::string& /*name*/) { return std::make_unique<NiceMock<MockGRPCLogger>>(); });
+    }
+
+    void TearDown() override
+    {
+        InterruptEvent::clearInterruptEventHandling(*vmiInterface);
+    }
+
+    void initializeWithPerVcpuEventProcessing()
+    {
+        ON_CALL(*configInterface, isPerVcpuEventProcessingEnabled()).WillByDefault(Return(true));
+        ON_CALL(*vmiInterface, getNumberOfVCPUs()).WillByDefault(Return(testNumberOfVcpus));
+        // The registers of an interrupt are read from the event registered with libvmi
+        ON_CALL(*vmiInterface, registerEvent(_))
+            .WillByDefault(
+                [this](vmi_event_t& event)
+                {
+                    event.x86_regs = &registers;
+                    event.vcpu_id = testVcpuId;
+                });
+        InterruptEvent::initializeInterruptEventHandling(*vmiInterface);
+
+        EXPECT_CALL(*interruptFactory, initialize()).Times(1);
+        EXPECT_CALL(*interruptFactory, createInterruptEvent(_, _, _, _)).Times(AnyNumber());
+        EXPECT_CALL(*interruptFactory, createInterruptEvent("PspCallProcessNotifyRoutinesInterruptEvent", _, _, _))
+            .WillOnce(
+                [this](const std::string& /*name*/,
+                       uint64_t /*targetVA*/,
+                       uint64_t /*systemCr3*/,
+                       const std::function<InterruptEvent::InterruptResponse(InterruptEvent&)>& callback)
+                {
+                    notifyProcessCallback = callback;
+                    return nullptr;
+                });
+        systemEventSupervisor->initialize();
+
+        notifyProcessInterruptEvent = std::make_shared<InterruptEvent>(
+            vmiInterface, 0, nullptr, nullptr, nullptr, notifyProcessCallback, nullptr, nullptr);
+    }
+
+    InterruptEvent::InterruptResponse notifyProcess(uint64_t eprocessBase, bool isTerminationEvent)
+    {
+        registers.rcx = eprocessBase;
+        registers.r8 = isTerminationEvent ? 0 : 1;
+        return notifyProcessCallback(*notifyProcessInterruptEvent);
+    }
 };
 
 TEST_F(SystemEventSupervisorFixture, teardown_validState_interruptFactoryTeardownCalled)
@@ -38,3 +107,122 @@ TEST_F(SystemEventSupervisorFixture, teardown_validState_interruptFactoryTeardow
 
     EXPECT_NO_THROW(systemEventSupervisor->teardown());
 }
+
+TEST_F(SystemEventSupervisorFixture,
+       pspCallProcessNotifyRoutinesCallback_terminationEvent_deferredPluginsNotifiedOnWorkerAfterRemoval)
+{
+    initializeWithPerVcpuEventProcessing();
+    auto notifyingThread = std::thread::id{};
+    auto deferredNotifyingThread = std::thread::id{};
+    {
+        InSequence s;
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToRegisteredPlugins(_))
+            .WillOnce(InvokeWithoutArgs([&notifyingThread]() { notifyingThread = std::this_thread::get_id(); }));
+        EXPECT_CALL(*activeProcessSupervisor, removeActiveProcess(testEprocessBase));
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToDeferredPlugins(_))
+            .WillOnce(InvokeWithoutArgs([&deferredNotifyingThread]()
+                                        { deferredNotifyingThread = std::this_thread::get_id(); }));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+
+    notifyProcess(testEprocessBase, true);
+    systemEventSupervisor->teardown();
+
+    EXPECT_EQ(notifyingThread, std::this_thread::get_id());
+    EXPECT_NE(deferredNotifyingThread, std::this_thread::get_id());
+}
+
+TEST_F(SystemEventSupervisorFixture, teardown_pendingDeferredPluginNotification_drainedBeforeInterruptFactoryTeardown)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToDeferredPlugins(_))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    notifyProcess(testEprocessBase, true);
+
+    systemEventSupervisor->teardown();
+}
+
+TEST_F(SystemEventSupervisorFixture, pspCallProcessNotifyRoutinesCallback_terminationEvent_pendingWorkDrainedFirst)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToRegisteredPlugins(_));
+        EXPECT_CALL(*activeProcessSupervisor, removeActiveProcess(testEprocessBase));
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToDeferredPlugins(_))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToRegisteredPlugins(_));
+        EXPECT_CALL(*activeProcessSupervisor, removeActiveProcess(otherTestEprocessBase));
+        EXPECT_CALL(*pluginSystem, passProcessTerminationEventToDeferredPlugins(_));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    notifyProcess(testEprocessBase, true);
+
+    notifyProcess(otherTestEprocessBase, true);
+    systemEventSupervisor->teardown();
+}
+
+TEST_F(SystemEventSupervisorFixture, pspCallProcessNotifyRoutinesCallback_processStart_registeredBeforeResponse)
+{
+    initializeWithPerVcpuEventProcessing();
+    bool processRegistered = false;
+    auto registeringThread = std::thread::id{};
+    auto enrichingThread = std::thread::id{};
+    {
+        InSequence s;
+        EXPECT_CALL(*activeProcessSupervisor, registerNewProcess(testEprocessBase))
+            .WillOnce(InvokeWithoutArgs(
+                [&processRegistered, &registeringThread]()
+                {
+                    processRegistered = true;
+                    registeringThread = std::this_thread::get_id();
+                }));
+        EXPECT_CALL(*activeProcessSupervisor, enrichProcess(testEprocessBase))
+            .WillOnce(InvokeWithoutArgs([&enrichingThread]() { enrichingThread = std::this_thread::get_id(); }));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    EXPECT_CALL(*activeProcessSupervisor, addNewProcess(_)).Times(0);
+
+    notifyProcess(testEprocessBase, false);
+    EXPECT_TRUE(processRegistered);
+    systemEventSupervisor->teardown();
+
+    EXPECT_EQ(registeringThread, std::this_thread::get_id());
+    EXPECT_NE(enrichingThread, std::this_thread::get_id());
+}
+
+TEST_F(SystemEventSupervisorFixture, teardown_pendingProcessEnrichment_drainedBeforeInterruptFactoryTeardown)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*activeProcessSupervisor, enrichProcess(testEprocessBase))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    notifyProcess(testEprocessBase, false);
+
+    systemEventSupervisor->teardown();
+}
+
+TEST_F(SystemEventSupervisorFixture,
+       pspCallProcessNotifyRoutinesCallback_terminationEvent_pendingEnrichmentDrainedFirst)
+{
+    initializeWithPerVcpuEventProcessing();
+    {
+        InSequence s;
+        EXPECT_CALL(*activeProcessSupervisor, enrichProcess(testEprocessBase))
+            .WillOnce(InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }));
+        EXPECT_CALL(*activeProcessSupervisor, getProcessInformationByBase(testEprocessBase));
+        EXPECT_CALL(*activeProcessSupervisor, removeActiveProcess(testEprocessBase));
+        EXPECT_CALL(*interruptFactory, teardown()).Times(1);
+    }
+    notifyProcess(testEprocessBase, false);
+
+    notifyProcess(testEprocessBase, true);
+    systemEventSupervisor->teardown();
+}
@@ -0,0 +1,126 @@
+#include "../../vmi/ProcessesMemoryState.h"
+#include <algorithm>
+#include <array>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using testing::_;
+using testing::Return;
+using testing::Throw;
+
+class VadTreeWin10Fixture : public ProcessesMemoryStateFixture
+{
+  protected:
+    std::unique_ptr<Windows::VadTreeWin10> vadTree;
+
+    void SetUp() override
+    {
+        ProcessesMemoryStateFixture::SetUp();
+        kernelAccess->initWindowsOffsets();
+        process4VadTreeMemoryState();
+        vadTree = std::make_unique<Windows::VadTreeWin10>(
+            mockVmiInterface, kernelAccess, process4.eprocessBase, process4.processId, "System", mockLogging);
+    }
+};
+
+TEST_F(VadTreeWin10Fixture, extractAllMemoryRegions_unchangedTree_fileNamesResolvedOnce)
+{
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(1);
+
+    auto firstMemoryRegions = vadTree->extractAllMemoryRegions();
+    auto secondMemoryRegions = vadTree->extractAllMemoryRegions();
+
+    ASSERT_EQ(secondMemoryRegions->size(), firstMemoryRegions->size());
+    for (auto first = firstMemoryRegions->cbegin(), second = secondMemoryRegions->cbegin();
+         first != firstMemoryRegions->cend();
+         first++, second++)
+    {
+        EXPECT_EQ(second->base, first->base);
+        EXPECT_EQ(second->size, first->size);
+        EXPECT_EQ(second->moduleName, first->moduleName);
+        EXPECT_EQ(second->isProcessBaseImage, first->isProcessBaseImage);
+    }
+}
+
+TEST_F(VadTreeWin10Fixture, extractAllMemoryRegions_changedNode_onlyChangedNodeResolvedAgain)
+{
+    // The file name of the unchanged file backed node is taken from the cache
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(1);
+    auto firstMemoryRegions = vadTree->extractAllMemoryRegions();
+    ON_CALL(*mockVmiInterface, read32VA(vadRootNodeBase + __MMVAD_SHORT_OFFSETS::EndingVpn, systemCR3))
+        .WillByDefault(Return(vadRootNodeEndingVpn + 1));
+
+    auto secondMemoryRegions = vadTree->extractAllMemoryRegions();
+
+    auto changedRegionSize = vadRootNodeMemoryRegionSize + PagingDefinitions::pageSizeInBytes;
+    EXPECT_EQ(std::count_if(secondMemoryRegions->cbegin(),
+                            secondMemoryRegions->cend(),
+                            [changedRegionSize](const MemoryRegion& region)
+                            { return region.size == changedRegionSize; }),
+              1);
+}
+
+TEST_F(VadTreeWin10Fixture, extractAllMemoryRegions_onlyControlAreaChanged_nodeResolvedAgain)
+{
+    auto isBeingDeleted = [this](const std::list<MemoryRegion>& memoryRegions)
+    {
+        return std::find_if(memoryRegions.cbegin(),
+                            memoryRegions.cend(),
+                            [this](const MemoryRegion& region)
+                            { return region.base == vadRootNodeRightChildStartingAddress; })
+            ->isBeingDeleted;
+    };
+    EXPECT_CALL(*mockVmiInterface, extractUnicodeStringAtVA(_, _)).Times(2);
+    auto firstMemoryRegions = vadTree->extractAllMemoryRegions();
+    auto sectionFlagsNotBeingDeleted = createSectionFlags(true, false, true);
+    ON_CALL(*mockVmiInterface,
+            read64VA(vadRootNodeRightChildControlAreaAddress + _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, systemCR3))
+        .WillByDefault(Return(sectionFlagsNotBeingDeleted));
+    ON_CALL(*mockVmiInterface,
+            read32VA(vadRootNodeRightChildControlAreaAddress + _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, systemCR3))
+        .WillByDefault(Return(sectionFlagsNotBeingDeleted));
+
+    auto secondMemoryRegions = vadTree->extractAllMemoryRegions();
+
+    EXPECT_TRUE(isBeingDeleted(*firstMemoryRegions));
+    EXPECT_FALSE(isBeingDeleted(*secondMemoryRegions));
+}
+
+TEST_F(VadTreeWin10Fixture, extractAllMemoryRegions_multipleVadTrees_sameRegionsAsSeparateWalks)
+{
+    Windows::VadTreeWin10 secondVadTree(
+        mockVmiInterface, kernelAccess, process4.eprocessBase, process4.processId, "System", mockLogging);
+    auto expectedMemoryRegions = vadTree->extractAllMemoryRegions();
+    std::array<const Windows::VadTreeWin10*, 2> vadTrees{vadTree.get(), &secondVadTree};
+
+    auto memoryRegions = Windows::VadTreeWin10::extractAllMemoryRegions(vadTrees);
+
+    ASSERT_EQ(memoryRegions.size(), 2);
+    for (const auto& regions : memoryRegions)
+    {
+        ASSERT_NE(regions, nullptr);
+        ASSERT_EQ(regions->size(), expectedMemoryRegions->size());
+        EXPECT_TRUE(std::equal(regions->cbegin(),
+                               regions->cend(),
+                               expectedMemoryRegions->cbegin(),
+                               [](const MemoryRegion& lhs, const MemoryRegion& rhs)
+                               { return lhs.base == rhs.base && lhs.size == rhs.size; }));
+    }
+}
+
+TEST_F(VadTreeWin10Fixture, extractAllMemoryRegions_unreadableVadRoot_nullResultOnlyForThatTree)
+{
+    constexpr uint64_t unknownEprocessBase = 0xffffa00000000000;
+    Windows::VadTreeWin10 unreadableVadTree(
+        mockVmiInterface, kernelAccess, unknownEprocessBase, 1234, "Unknown", mockLogging);
+    ON_CALL(*mockVmiInterface, read64VA(unknownEprocessBase + _EPROCESS_OFFSETS::VadRoot, systemCR3))
+        .WillByDefault(Throw(VmiException("Unable to read VadRoot")));
+    std::array<const Windows::VadTreeWin10*, 2> vadTrees{&unreadableVadTree, vadTree.get()};
+
+    auto memoryRegions = Windows::VadTreeWin10::extractAllMemoryRegions(vadTrees);
+
+    ASSERT_EQ(memoryRegions.size(), 2);
+    EXPECT_EQ(memoryRegions[0], nullptr);
+    ASSERT_NE(memoryRegions[1], nullptr);
+    EXPECT_FALSE(memoryRegions[1]->empty());
+}
@@ -1,8 +1,10 @@
+#include "../../src/GlobalControl.h"
 #include "../vmi/ProcessesMemoryState.h"
 #include <gtest/gtest.h>
 #include <memory>
 
 using testing::_;
+using testing::Return;
 using testing::UnorderedElementsAre;
 using testing::Unused;
 
@@ -263,26 +265,51 @@ class ReadProcessMemoryRegionFixture : public PluginSystemFixture
         }
     }
 
+    // Guest pages are identity mapped, so the virtual address of a page doubles as its physical address
+    std::map<std::pair<uint64_t, uint64_t>, std::vector<uint8_t>> mappedPages;
+
     void setupMemoryRegionReturns(const memoryRegionTestInformation& memoryRegionInfo)
     {
         if (!memoryRegionInfo.memoryPageContent.empty())
         {
-            ON_CALL(*mockVmiInterface, readXVA(memoryRegionInfo.virtualAddress, memoryRegionInfo.cr3, _))
-                .WillByDefault(
-                    [memoryPageContent = memoryRegionInfo.memoryPageContent](
-                        uint64_t virtualAddress, uint64_t cr3, std::vector<uint8_t>& buffer)
-                    {
-                        buffer = memoryPageContent;
-                        return true;
-                    });
-        }
-        else
-        {
-            ON_CALL(*mockVmiInterface, readXVA(memoryRegionInfo.virtualAddress, memoryRegionInfo.cr3, _))
-                .WillByDefault(Return(false));
+            mappedPages[{memoryRegionInfo.cr3, memoryRegionInfo.virtualAddress}] = memoryRegionInfo.memoryPageContent;
         }
     }
 
+    void setupPageTranslationReturns()
+    {
+        ON_CALL(*mockVmiInterface, translateRange(_, _, _))
+            .WillByDefault(
+                [&mappedPages = mappedPages](uint64_t virtualAddress, uint64_t size, uint64_t cr3)
+                {
+                    std::vector<PageTranslation> translations;
+                    for (auto pageVA = virtualAddress; pageVA < virtualAddress + size;
+                         pageVA += PagingDefinitions::pageSizeInBytes)
+                    {
+                        translations.push_back({pageVA,
+                                                pageVA,
+                                                PagingDefinitions::pageSizeInBytes,
+                                                PagingDefinitions::pageSizeInBytes,
+                                                mappedPages.contains({cr3, pageVA})});
+                    }
+                    return translations;
+                });
+        ON_CALL(*mockVmiInterface, readPA(_, _))
+            .WillByDefault(
+                [&mappedPages = mappedPages](uint64_t physicalAddress, std::span<uint8_t> content)
+                {
+                    for (const auto& [page, pageContent] : mappedPages)
+                    {
+                        if (page.second == physicalAddress && pageContent.size() == content.size())
+                        {
+                            std::copy(pageContent.cbegin(), pageContent.cend(), content.begin());
+                            return true;
+                        }
+                    }
+                    return false;
+                });
+    }
+
     void setupSevenPagesRegionReturns()
     {
         sevenPagesMemoryRegionInfo = createMultipageRegionInformation(6666 * PagingDefinitions::pageSizeInBytes,
@@ -306,6 +333,7 @@ class ReadProcessMemoryRegionFixture : public PluginSystemFixture
         setupMemoryRegionReturns(singlePageMemoryRegion);
         setupThreePagesRegionReturns();
         setupSevenPagesRegionReturns();
+        setupPageTranslationReturns();
     }
 };
 
@@ -392,3 +420,78 @@ TEST_F(ReadProcessMemoryRegionFixture, readProcessMemoryRegion_memoryRegionWithM
 
     EXPECT_EQ(expectedMemoryRegion, *data);
 }
+
+TEST_F(PluginSystemFixture, mapProcessMemoryRegion_virtualAddressNotPageAligned_invalidArgumentException)
+{
+    EXPECT_THROW((void)pluginInterface->mapProcessMemoryRegion(
+                     process4.processId, 1234, PagingDefinitions::pageSizeInBytes),
+                 std::invalid_argument);
+}
+
+TEST_F(PluginSystemFixture, mapProcessMemoryRegion_validRegion_mapsPagesWithProcessDtb)
+{
+    uint64_t regionBaseVA = 2345 * PagingDefinitions::pageSizeInBytes;
+
+    EXPECT_CALL(*mockVmiInterface, mmapGuest(regionBaseVA, process4.directoryTableBase, 3)).Times(1);
+
+    EXPECT_NO_THROW((void)pluginInterface->mapProcessMemoryRegion(
+        process4.processId, regionBaseVA, 3 * PagingDefinitions::pageSizeInBytes));
+}
+
+TEST_F(ReadProcessMemoryRegionFixture, readProcessMemoryRegion_largePageBackedRegion_singlePhysicalRead)
+{
+    uint64_t largePageRegionBaseVA = 0x40000000;
+    uint64_t largePagePA = 0x80000000;
+    ON_CALL(*mockVmiInterface, translateRange(largePageRegionBaseVA, _, _))
+        .WillByDefault(Return(std::vector<PageTranslation>{{largePageRegionBaseVA,
+                                                            largePagePA,
+                                                            PagingDefinitions::largePageSizeInBytes,
+                                                            PagingDefinitions::largePageSizeInBytes,
+                                                            true}}));
+    std::unique_ptr<std::vector<uint8_t>> data;
+
+    EXPECT_CALL(*mockVmiInterface, readPA(largePagePA, _)).WillOnce(Return(true));
+    EXPECT_CALL(*mockVmiInterface, readPA(testing::Ne(largePagePA), _)).Times(0);
+    ASSERT_NO_THROW(data = pluginInterface->readProcessMemoryRegion(
+                        process4.processId, largePageRegionBaseVA, PagingDefinitions::largePageSizeInBytes));
+
+    EXPECT_EQ(data->size(), PagingDefinitions::largePageSizeInBytes);
+}
+
+TEST_F(ReadProcessMemoryRegionFixture, readProcessMemoryRegion_unreadableFrameInLargePage_readableLargePageReadAsWhole)
+{
+    uint64_t largePageRegionBaseVA = 0x40000000;
+    uint64_t largePagePA = 0x80000000;
+    uint64_t unreadableFramePA = largePagePA + PagingDefinitions::largePageSizeInBytes;
+    ON_CALL(*mockVmiInterface, translateRange(largePageRegionBaseVA, _, _))
+        .WillByDefault(Return(std::vector<PageTranslation>{{largePageRegionBaseVA,
+                                                            largePagePA,
+                                                            2 * PagingDefinitions::largePageSizeInBytes,
+                                                            PagingDefinitions::largePageSizeInBytes,
+                                                            true}}));
+    ON_CALL(*mockVmiInterface, readPA(_, _)).WillByDefault(Return(true));
+    ON_CALL(*mockVmiInterface, readPA(largePagePA, testing::SizeIs(2 * PagingDefinitions::largePageSizeInBytes)))
+        .WillByDefault(Return(false));
+    ON_CALL(*mockVmiInterface, readPA(unreadableFramePA, _)).WillByDefault(Return(false));
+    std::unique_ptr<std::vector<uint8_t>> data;
+
+    EXPECT_CALL(*mockVmiInterface, readPA(_, _)).Times(testing::AnyNumber());
+    EXPECT_CALL(*mockVmiInterface, readPA(largePagePA, testing::SizeIs(PagingDefinitions::largePageSizeInBytes)))
+        .Times(1);
+    ASSERT_NO_THROW(data = pluginInterface->readProcessMemoryRegion(
+                        process4.processId, largePageRegionBaseVA, 2 * PagingDefinitions::largePageSizeInBytes));
+
+    // The unreadable frame is replaced by a single padding page
+    EXPECT_EQ(data->size(), 2 * PagingDefinitions::largePageSizeInBytes);
+}
+
+TEST_F(PluginSystemFixture, requestShutdown_validState_endsVmiAndWakesEventLoop)
+{
+    (void)GlobalControl::consumeEventLoopWakeup();
+
+    pluginInterface->requestShutdown();
+
+    EXPECT_TRUE(GlobalControl::endVmi);
+    EXPECT_TRUE(GlobalControl::consumeEventLoopWakeup());
+    GlobalControl::endVmi = false;
+}
@@ -9,6 +9,11 @@ class MockPluginSystem : public IPluginSystem
                 (pid_t, Plugin::virtual_address_t, size_t),
                 (const override));
 
+    MOCK_METHOD(std::unique_ptr<IMemoryMapping>,
+                mapProcessMemoryRegion,
+                (pid_t, Plugin::virtual_address_t, size_t),
+                (const override));
+
     MOCK_METHOD(std::unique_ptr<std::vector<MemoryRegion>>, getProcessMemoryRegions, (pid_t), (const override));
 
     MOCK_METHOD(std::unique_ptr<std::vector<std::shared_ptr<const ActiveProcessInformation>>>,
@@ -16,8 +21,15 @@ class MockPluginSystem : public IPluginSystem
                 (),
                 (const override));
 
+    MOCK_METHOD(std::vector<std::unique_ptr<std::list<MemoryRegion>>>,
+                extractAllMemoryRegions,
+                (const std::vector<std::shared_ptr<const ActiveProcessInformation>>&),
+                (const override));
+
     MOCK_METHOD(void, registerProcessTerminationEvent, (Plugin::processTerminationCallback_f), (override));
 
+    MOCK_METHOD(void, registerDeferredProcessTerminationEvent, (Plugin::processTerminationCallback_f), (override));
+
     MOCK_METHOD(void, registerShutdownEvent, (Plugin::shutdownCallback_f), (override));
 
     MOCK_METHOD(std::unique_ptr<std::string>, getResultsDir, (), (const override));
@@ -32,6 +44,8 @@ class MockPluginSystem : public IPluginSystem
 
     MOCK_METHOD(void, sendInMemDetectionEvent, (const std::string&), (const override));
 
+    MOCK_METHOD(void, requestShutdown, (), (const override));
+
     MOCK_METHOD(void,
                 initializePlugin,
                 (const std::string&, std::shared_ptr<Plugin::IPluginConfig>, const std::vector<std::string>& args),
@@ -42,5 +56,10 @@ class MockPluginSystem : public IPluginSystem
                 (std::shared_ptr<const ActiveProcessInformation>),
                 (override));
 
+    MOCK_METHOD(void,
+                passProcessTerminationEventToDeferredPlugins,
+                (std::shared_ptr<const ActiveProcessInformation>),
+                (override));
+
     MOCK_METHOD(void, passShutdownEventToRegisteredPlugins, (), (override));
 };
@@ -0,0 +1,209 @@
+#include "../../src/os/PagingDefinitions.h"
+#include "../../src/vmi/AltP2mBreakpointEngine.h"
+#include "../io/grpc/mock_GRPCLogger.h"
+#include "../io/mock_Logging.h"
+#include "mock_LibvmiInterface.h"
+#include "mock_SingleStepSupervisor.h"
+#include <gtest/gtest.h>
+
+using testing::_;
+using testing::AnyNumber;
+using testing::NiceMock;
+using testing::Return;
+using testing::SaveArg;
+
+namespace
+{
+    constexpr uint16_t testExecuteView = 3;
+    constexpr uint64_t testGfn = 0x1234, testShadowGfn = 0x100000;
+    constexpr uint64_t testPA = (testGfn << PagingDefinitions::numberOfPageIndexBits) + 0x10,
+                       testPA2 = (testGfn << PagingDefinitions::numberOfPageIndexBits) + 0x20;
+    constexpr uint64_t testShadowPA = (testShadowGfn << PagingDefinitions::numberOfPageIndexBits) + 0x10;
+    constexpr uint64_t testShadowPA2 = (testShadowGfn << PagingDefinitions::numberOfPageIndexBits) + 0x20;
+    constexpr uint8_t testOriginalValue = 0x55;
+    constexpr uint32_t testVcpuId = 1;
+}
+
+class AltP2mBreakpointEngineFixture : public testing::Test
+{
+  protected:
+    std::shared_ptr<NiceMock<MockLibvmiInterface>> vmiInterface = std::make_shared<NiceMock<MockLibvmiInterface>>();
+    std::shared_ptr<NiceMock<MockSingleStepSupervisor>> singleStepSupervisor =
+        std::make_shared<NiceMock<MockSingleStepSupervisor>>();
+    std::shared_ptr<NiceMock<MockLogging>> mockLogging = std::make_shared<NiceMock<MockLogging>>();
+    std::shared_ptr<AltP2mBreakpointEngine> engine;
+    vmi_event_t* accessEvent = nullptr;
+
+    void SetUp() override
+    {
+        ON_CALL(*mockLogging, newNamedLogger(_))
+            .WillByDefault([](const std::string& /*name*/) { return std::make_unique<NiceMock<MockGRPCLogger>>(); });
+        ON_CALL(*vmiInterface, createSlatView()).WillByDefault(Return(testExecuteView));
+        ON_CALL(*vmiInterface, allocateGfn()).WillByDefault(Return(testShadowGfn));
+        ON_CALL(*vmiInterface, readPA(_, _)).WillByDefault(Return(true));
+        ON_CALL(*vmiInterface, registerEvent(_)).WillByDefault([this](vmi_event_t& event) { accessEvent = &event; });
+        engine = std::make_shared<AltP2mBreakpointEngine>(vmiInterface, singleStepSupervisor, mockLogging);
+        engine->initialize();
+    }
+
+    event_response_t accessShadowPage(uint8_t access)
+    {
+        accessEvent->mem_event.out_access = access;
+        accessEvent->vcpu_id = testVcpuId;
+        return accessEvent->callback(nullptr, accessEvent);
+    }
+};
+
+TEST_F(AltP2mBreakpointEngineFixture, initialize_validState_switchesToExecuteView)
+{
+    auto freshEngine = std::make_shared<AltP2mBreakpointEngine>(vmiInterface, singleStepSupervisor, mockLogging);
+    testing::InSequence s;
+
+    EXPECT_CALL(*vmiInterface, setSlatEnabled(true)).Times(1);
+    EXPECT_CALL(*vmiInterface, createSlatView()).WillOnce(Return(testExecuteView));
+    EXPECT_CALL(*vmiInterface, switchSlatView(testExecuteView)).Times(1);
+
+    freshEngine->initialize();
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, setBreakpoint_newPage_remapsGfnToShadowCopyWithBreakpoint)
+{
+    testing::InSequence s;
+
+    EXPECT_CALL(*vmiInterface, readPA(testGfn << PagingDefinitions::numberOfPageIndexBits, _)).WillOnce(Return(true));
+    EXPECT_CALL(*vmiInterface, writePA(testShadowGfn << PagingDefinitions::numberOfPageIndexBits, _)).Times(1);
+    EXPECT_CALL(*vmiInterface, changeSlatGfn(testExecuteView, testGfn, testShadowGfn)).Times(1);
+    EXPECT_CALL(*vmiInterface, registerEvent(_)).Times(1);
+    EXPECT_CALL(*vmiInterface, write8PA(testShadowPA, 0xCC)).Times(1);
+
+    engine->setBreakpoint(testPA, 0xCC);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, setBreakpoint_twoBreakpointsOnSamePage_shadowCopyCreatedOnce)
+{
+    EXPECT_CALL(*vmiInterface, allocateGfn()).WillOnce(Return(testShadowGfn));
+    EXPECT_CALL(*vmiInterface, changeSlatGfn(testExecuteView, testGfn, testShadowGfn)).Times(1);
+
+    engine->setBreakpoint(testPA, 0xCC);
+    engine->setBreakpoint(testPA2, 0xCC);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, removeBreakpoint_lastBreakpointOnPage_shadowCopyReleased)
+{
+    engine->setBreakpoint(testPA, 0xCC);
+    testing::InSequence s;
+
+    EXPECT_CALL(*vmiInterface, write8PA(testShadowPA, testOriginalValue)).Times(1);
+    EXPECT_CALL(*vmiInterface, clearEvent(_, true)).Times(1);
+    EXPECT_CALL(*vmiInterface, changeSlatGfn(testExecuteView, testGfn, ~0ull)).Times(1);
+    EXPECT_CALL(*vmiInterface, freeGfn(testShadowGfn)).Times(1);
+
+    engine->removeBreakpoint(testPA, testOriginalValue);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, removeBreakpoint_calledTwice_shadowCopyReleasedOnce)
+{
+    engine->setBreakpoint(testPA, 0xCC);
+
+    EXPECT_CALL(*vmiInterface, write8PA(testShadowPA, testOriginalValue)).Times(1);
+    EXPECT_CALL(*vmiInterface, freeGfn(testShadowGfn)).Times(1);
+
+    engine->removeBreakpoint(testPA, testOriginalValue);
+    engine->removeBreakpoint(testPA, testOriginalValue);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, removeBreakpoint_otherBreakpointOnPageRemains_shadowCopyKept)
+{
+    engine->setBreakpoint(testPA, 0xCC);
+    engine->setBreakpoint(testPA2, 0xCC);
+
+    EXPECT_CALL(*vmiInterface, freeGfn(_)).Times(0);
+
+    engine->removeBreakpoint(testPA, testOriginalValue);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, teardown_activeShadowPage_restoresHostView)
+{
+    engine->setBreakpoint(testPA, 0xCC);
+    testing::InSequence s;
+
+    EXPECT_CALL(*vmiInterface, pauseVm()).Times(1);
+    EXPECT_CALL(*vmiInterface, switchSlatView(AltP2mBreakpointEngine::hostView)).Times(1);
+    EXPECT_CALL(*vmiInterface, freeGfn(testShadowGfn)).Times(1);
+    EXPECT_CALL(*vmiInterface, destroySlatView(testExecuteView)).Times(1);
+    EXPECT_CALL(*vmiInterface, setSlatEnabled(false)).Times(1);
+    EXPECT_CALL(*vmiInterface, resumeVm()).Times(1);
+
+    engine->teardown();
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, stepInHostView_validEvent_fastSingleStepBackToExecuteView)
+{
+    vmi_event_t event{};
+
+    auto response = engine->stepInHostView(&event);
+
+    EXPECT_EQ(response,
+              VMI_EVENT_RESPONSE_SLAT_ID | VMI_EVENT_RESPONSE_NEXT_SLAT_ID | VMI_EVENT_RESPONSE_TOGGLE_SINGLESTEP);
+    EXPECT_EQ(event.slat_id, AltP2mBreakpointEngine::hostView);
+    EXPECT_EQ(event.next_slat_id, testExecuteView);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, shadowPageAccess_read_fastSingleStepBackToExecuteView)
+{
+    engine->setBreakpoint(testPA, 0xCC);
+
+    EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(_, _)).Times(0);
+
+    EXPECT_EQ(accessShadowPage(VMI_MEMACCESS_R),
+              VMI_EVENT_RESPONSE_SLAT_ID | VMI_EVENT_RESPONSE_NEXT_SLAT_ID | VMI_EVENT_RESPONSE_TOGGLE_SINGLESTEP);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, shadowPageAccess_write_stepsInHostViewWithoutReturningToExecuteView)
+{
+    engine->setBreakpoint(testPA, 0xCC);
+
+    EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(testVcpuId, _)).Times(1);
+
+    EXPECT_EQ(accessShadowPage(VMI_MEMACCESS_W), VMI_EVENT_RESPONSE_SLAT_ID);
+    EXPECT_EQ(accessEvent->slat_id, AltP2mBreakpointEngine::hostView);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, shadowPageAccess_writeStepped_shadowCopyRefreshedWithBreakpoints)
+{
+    engine->setBreakpoint(testPA, 0xCC);
+    engine->setBreakpoint(testPA2, 0xCC);
+    std::function<void(vmi_event_t*)> singleStepCallback;
+    EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(testVcpuId, _)).WillOnce(SaveArg<1>(&singleStepCallback));
+    (void)accessShadowPage(VMI_MEMACCESS_W);
+    ASSERT_TRUE(singleStepCallback);
+    vmi_event_t singleStepEvent{};
+    singleStepEvent.vcpu_id = testVcpuId;
+    testing::InSequence s;
+
+    EXPECT_CALL(*vmiInterface, readPA(testGfn << PagingDefinitions::numberOfPageIndexBits, _)).WillOnce(Return(true));
+    EXPECT_CALL(*vmiInterface, writePA(testShadowGfn << PagingDefinitions::numberOfPageIndexBits, _)).Times(1);
+    EXPECT_CALL(*vmiInterface, write8PA(testShadowPA, 0xCC)).Times(1);
+    EXPECT_CALL(*vmiInterface, write8PA(testShadowPA2, 0xCC)).Times(1);
+
+    singleStepCallback(&singleStepEvent);
+
+    EXPECT_EQ(singleStepEvent.slat_id, testExecuteView);
+}
+
+TEST_F(AltP2mBreakpointEngineFixture, shadowPageAccess_shadowCopyReleasedBeforeWriteStepped_returnsToExecuteView)
+{
+    engine->setBreakpoint(testPA, 0xCC);
+    std::function<void(vmi_event_t*)> singleStepCallback;
+    EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(testVcpuId, _)).WillOnce(SaveArg<1>(&singleStepCallback));
+    (void)accessShadowPage(VMI_MEMACCESS_W);
+    ASSERT_TRUE(singleStepCallback);
+    engine->removeBreakpoint(testPA, testOriginalValue);
+    vmi_event_t singleStepEvent{};
+
+    EXPECT_CALL(*vmiInterface, writePA(_, _)).Times(0);
+
+    singleStepCallback(&singleStepEvent);
+
+    EXPECT_EQ(singleStepEvent.slat_id, testExecuteView);
+}
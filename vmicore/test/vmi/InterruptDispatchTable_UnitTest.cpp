@@ -0,0 +1,69 @@
+#include "../../src/vmi/InterruptDispatchTable.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+    constexpr uint64_t breakpointPA = 0x1234567;
+    int handler = 0;
+}
+
+TEST(InterruptDispatchTableTest, find_registeredAddress_handlerReturned)
+{
+    InterruptDispatchTable<int> dispatchTable;
+    dispatchTable.insert(breakpointPA, &handler);
+
+    EXPECT_EQ(dispatchTable.find(breakpointPA), &handler);
+}
+
+TEST(InterruptDispatchTableTest, find_foreignAddressOnRegisteredFrame_nullptr)
+{
+    InterruptDispatchTable<int> dispatchTable;
+    dispatchTable.insert(breakpointPA, &handler);
+
+    EXPECT_EQ(dispatchTable.find(breakpointPA + 1), nullptr);
+    EXPECT_EQ(dispatchTable.find(breakpointPA + PagingDefinitions::pageSizeInBytes), nullptr);
+    EXPECT_EQ(dispatchTable.find(0xFFFFFFFFFFFF), nullptr);
+}
+
+TEST(InterruptDispatchTableTest, insert_alreadyRegisteredAddress_false)
+{
+    InterruptDispatchTable<int> dispatchTable;
+    int otherHandler = 0;
+    dispatchTable.insert(breakpointPA, &handler);
+
+    EXPECT_FALSE(dispatchTable.insert(breakpointPA, &otherHandler));
+    EXPECT_EQ(dispatchTable.find(breakpointPA), &handler);
+}
+
+TEST(InterruptDispatchTableTest, erase_everySecondOfManyAddresses_remainingAddressesStillFound)
+{
+    InterruptDispatchTable<int> dispatchTable;
+    std::vector<int> handlers(1000);
+    // Several breakpoints per frame so that probe sequences collide and the table has to grow
+    for (uint64_t i = 0; i < handlers.size(); i++)
+    {
+        ASSERT_TRUE(dispatchTable.insert(0x100000 + i * 0x300, &handlers[i]));
+    }
+
+    for (uint64_t i = 0; i < handlers.size(); i += 2)
+    {
+        ASSERT_TRUE(dispatchTable.erase(0x100000 + i * 0x300));
+    }
+
+    EXPECT_EQ(dispatchTable.size(), handlers.size() / 2);
+    for (uint64_t i = 0; i < handlers.size(); i++)
+    {
+        EXPECT_EQ(dispatchTable.find(0x100000 + i * 0x300), i % 2 == 0 ? nullptr : &handlers[i]);
+    }
+}
+
+TEST(InterruptDispatchTableTest, clear_registeredAddress_notFoundAnymore)
+{
+    InterruptDispatchTable<int> dispatchTable;
+    dispatchTable.insert(breakpointPA, &handler);
+
+    dispatchTable.clear();
+
+    EXPECT_EQ(dispatchTable.find(breakpointPA), nullptr);
+    EXPECT_EQ(dispatchTable.size(), 0);
+}
@@ -2,11 +2,13 @@
 #include "../../src/os/PagingDefinitions.h"
 #include "../../src/vmi/InterruptEvent.h"
 #include "../../src/vmi/InterruptFactory.h"
+#include "../config/mock_ConfigInterface.h"
 #include "../io/grpc/mock_GRPCLogger.h"
 #include "../io/mock_EventStream.h"
 #include "../io/mock_Logging.h"
 #include "mock_LibvmiInterface.h"
 #include "mock_SingleStepSupervisor.h"
+#include <algorithm>
 #include <gtest/gtest.h>
 
 using testing::_;
@@ -26,6 +28,10 @@ namespace
                        testVA2 = 8765 * PagingDefinitions::pageSizeInBytes;
     constexpr uint64_t testPA = 1234 * PagingDefinitions::pageSizeInBytes,
                        testPA2 = 5678 * PagingDefinitions::pageSizeInBytes;
+    // Second breakpoint on the page of testVA
+    constexpr uint64_t testSamePageOffset = 0x10;
+    constexpr uint64_t testSamePageVA = testVA + testSamePageOffset, testSamePagePA = testPA + testSamePageOffset;
+    constexpr uint8_t testSamePageOriginalMemoryContent = 0x42;
     constexpr uint64_t testSystemCr3 = 0xaaa;
     constexpr uint64_t testOriginalMemoryContent = 0xFE, testOriginalMemoryContent2 = 0xFF;
 }
@@ -57,7 +63,17 @@ class InterruptEventFixture : public testing::Test
     interruptCallbackFunction_t interruptCallback = InterruptEvent::createInterruptCallback(
         std::weak_ptr(mockFunction), &testing::MockFunction<InterruptEvent::InterruptResponse(InterruptEvent&)>::Call);
     std::shared_ptr<NiceMock<MockLogging>> mockLogging = std::make_shared<NiceMock<MockLogging>>();
-    InterruptFactory interruptFactory = InterruptFactory(vmiInterface, singleStepSupervisor, mockLogging);
+    std::shared_ptr<MockConfigInterface> configInterface = createConfigInterface("int3");
+    std::shared_ptr<EventMetrics> eventMetrics = std::make_shared<EventMetrics>();
+    InterruptFactory interruptFactory =
+        InterruptFactory(configInterface, vmiInterface, singleStepSupervisor, mockLogging, eventMetrics);
+
+    static std::shared_ptr<MockConfigInterface> createConfigInterface(const std::string& breakpointEngine)
+    {
+        auto configInterface = std::make_shared<MockConfigInterface>();
+        ON_CALL(*configInterface, getBreakpointEngine()).WillByDefault(Return(breakpointEngine));
+        return configInterface;
+    }
 
     void SetUp() override
     {
@@ -65,6 +81,8 @@ class InterruptEventFixture : public testing::Test
         ON_CALL(*vmiInterface, convertVAToPA(testVA2, testSystemCr3)).WillByDefault(Return(testPA2));
         ON_CALL(*vmiInterface, read8PA(testPA)).WillByDefault(Return(testOriginalMemoryContent));
         ON_CALL(*vmiInterface, read8PA(testPA2)).WillByDefault(Return(testOriginalMemoryContent2));
+        ON_CALL(*vmiInterface, convertVAToPA(testSamePageVA, testSystemCr3)).WillByDefault(Return(testSamePagePA));
+        ON_CALL(*vmiInterface, read8PA(testSamePagePA)).WillByDefault(Return(testSamePageOriginalMemoryContent));
         ON_CALL(*vmiInterface, readXVA(_, _, _)).WillByDefault(Return(true));
         ON_CALL(*mockLogging, newNamedLogger(_))
             .WillByDefault([](const std::string& /*name*/) { return std::make_unique<MockGRPCLogger>(); });
@@ -161,6 +179,18 @@ TEST_F(InterruptEventCallbackFixture, createInterruptEvent_interruptEventTrigger
     EXPECT_NO_THROW(InterruptEvent::_defaultInterruptCallback(vmiInstance_stub, &event));
 }
 
+TEST_F(InterruptEventCallbackFixture, createInterruptEvent_interruptEventTriggered_invalidatesCachesBeforeCallback)
+{
+    auto interruptEvent =
+        interruptFactory.createInterruptEvent("InterruptName", testVA, testSystemCr3, interruptCallback);
+    testing::InSequence s;
+
+    EXPECT_CALL(*vmiInterface, invalidateCaches()).Times(1);
+    EXPECT_CALL(*mockFunction, Call(Ref(*interruptEvent))).Times(1);
+    EXPECT_CALL(*vmiInterface, flushV2PCache(_)).Times(0);
+    EXPECT_NO_THROW(InterruptEvent::_defaultInterruptCallback(vmiInstance_stub, &event));
+}
+
 TEST_F(InterruptEventCallbackFixture, createInterruptEvent_interruptEventTriggered_disablesEvent)
 {
     auto interruptEvent =
@@ -239,6 +269,20 @@ TEST_F(InterruptEventFixtureWithoutTeardown, clearInterruptEventHandling_twoActi
     InterruptEvent::clearInterruptEventHandling(*vmiInterface);
 }
 
+TEST_F(InterruptEventFixtureWithoutTeardown, clearInterruptEventHandling_twoInterruptsOnSamePage_guardDisabledOnce)
+{
+    EXPECT_CALL(*vmiInterface, clearEvent(_, _)).Times(AnyNumber());
+    EXPECT_CALL(*vmiInterface, clearEvent(IsCorrectMemEvent(testPA >> PagingDefinitions::numberOfPageIndexBits), true))
+        .Times(1);
+
+    [[maybe_unused]] auto _interruptEvent1 =
+        interruptFactory.createInterruptEvent("InterruptName", testVA, testSystemCr3, interruptCallback);
+    [[maybe_unused]] auto _interruptEvent2 =
+        interruptFactory.createInterruptEvent("InterruptName2", testSamePageVA, testSystemCr3, interruptCallback);
+
+    InterruptEvent::clearInterruptEventHandling(*vmiInterface);
+}
+
 TEST_F(InterruptEventFixtureWithoutTeardown, clearInterruptEventHandling_twoActiveInterrupts_interruptGuardsDisabled)
 {
     EXPECT_CALL(*vmiInterface, clearEvent(_, _)).Times(AnyNumber());
@@ -254,3 +298,102 @@ TEST_F(InterruptEventFixtureWithoutTeardown, clearInterruptEventHandling_twoActi
 
     InterruptEvent::clearInterruptEventHandling(*vmiInterface);
 }
+
+TEST_F(InterruptEventFixture, createInterruptEvent_twoInterruptsOnSamePage_oneGuardEventRegistered)
+{
+    EXPECT_CALL(*vmiInterface, registerEvent(_)).Times(AnyNumber());
+    EXPECT_CALL(*vmiInterface, registerEvent(IsCorrectMemEvent(testPA >> PagingDefinitions::numberOfPageIndexBits)))
+        .Times(1);
+
+    [[maybe_unused]] auto _interruptEvent1 =
+        interruptFactory.createInterruptEvent("InterruptName", testVA, testSystemCr3, interruptCallback);
+    [[maybe_unused]] auto _interruptEvent2 =
+        interruptFactory.createInterruptEvent("InterruptName2", testSamePageVA, testSystemCr3, interruptCallback);
+}
+
+TEST_F(InterruptEventFixture, guardCallback_readAtBreakpointOnSharedPage_originalValueEmulated)
+{
+    constexpr uint8_t shadowPageContent = 0xAB;
+    vmi_event_t* guardEvent = nullptr;
+    ON_CALL(*vmiInterface, readXVA(testVA, testSystemCr3, _))
+        .WillByDefault(
+            [shadowPageContent](uint64_t, uint64_t, std::vector<uint8_t>& content)
+            {
+                std::fill(content.begin(), content.end(), shadowPageContent);
+                return true;
+            });
+    EXPECT_CALL(*vmiInterface, registerEvent(_)).Times(AnyNumber());
+    EXPECT_CALL(*vmiInterface, registerEvent(IsCorrectMemEvent(testPA >> PagingDefinitions::numberOfPageIndexBits)))
+        .WillOnce([&guardEvent](vmi_event_t& event) { guardEvent = &event; });
+    [[maybe_unused]] auto _interruptEvent1 =
+        interruptFactory.createInterruptEvent("InterruptName", testVA, testSystemCr3, interruptCallback);
+    [[maybe_unused]] auto _interruptEvent2 =
+        interruptFactory.createInterruptEvent("InterruptName2", testSamePageVA, testSystemCr3, interruptCallback);
+    ASSERT_NE(guardEvent, nullptr);
+    guardEvent->mem_event.offset = testSamePageOffset;
+
+    EXPECT_EQ(guardEvent->callback(vmiInstance_stub, guardEvent), VMI_EVENT_RESPONSE_SET_EMUL_READ_DATA);
+
+    EXPECT_EQ(guardEvent->emul_read->data[0], testSamePageOriginalMemoryContent);
+    EXPECT_EQ(guardEvent->emul_read->data[1], shadowPageContent);
+}
+
+class InterruptEventAltP2mFixture : public InterruptEventFixture
+{
+  protected:
+    static constexpr uint16_t testExecuteView = 1;
+    static constexpr uint64_t testShadowGfn = 0x100000;
+    static constexpr uint64_t testShadowPA = (testShadowGfn << PagingDefinitions::numberOfPageIndexBits) +
+                                             (testPA & ~PagingDefinitions::stripPageOffsetMask);
+    vmi_event_t event{};
+
+    void SetUp() override
+    {
+        ON_CALL(*vmiInterface, createSlatView()).WillByDefault(Return(testExecuteView));
+        ON_CALL(*vmiInterface, allocateGfn()).WillByDefault(Return(testShadowGfn));
+        ON_CALL(*vmiInterface, readPA(_, _)).WillByDefault(Return(true));
+        interruptFactory = InterruptFactory(
+            createConfigInterface("altp2m"), vmiInterface, singleStepSupervisor, mockLogging, eventMetrics);
+        InterruptEventFixture::SetUp();
+        event.interrupt_event.gfn = 0;
+        event.interrupt_event.offset = testPA;
+    }
+};
+
+TEST_F(InterruptEventAltP2mFixture, createInterruptEvent_altP2mEngine_guestMemoryNotPatched)
+{
+    EXPECT_CALL(*vmiInterface, write8PA(_, _)).Times(AnyNumber());
+    EXPECT_CALL(*vmiInterface, write8PA(testPA, _)).Times(0);
+    EXPECT_CALL(*vmiInterface, write8PA(testShadowPA, INT3_BREAKPOINT)).Times(1);
+
+    [[maybe_unused]] auto _interruptEvent =
+        interruptFactory.createInterruptEvent("InterruptName", testVA, testSystemCr3, interruptCallback);
+}
+
+TEST_F(InterruptEventAltP2mFixture,
+       createInterruptEvent_interruptEventTriggered_stepsInHostViewWithoutSingleStepCallback)
+{
+    auto interruptEvent =
+        interruptFactory.createInterruptEvent("InterruptName", testVA, testSystemCr3, interruptCallback);
+    EXPECT_CALL(*singleStepSupervisor, setSingleStepCallback(_, _)).Times(0);
+    EXPECT_CALL(*vmiInterface, write8PA(_, _)).Times(0);
+
+    auto response = InterruptEvent::_defaultInterruptCallback(vmiInstance_stub, &event);
+
+    EXPECT_EQ(response,
+              VMI_EVENT_RESPONSE_SLAT_ID | VMI_EVENT_RESPONSE_NEXT_SLAT_ID | VMI_EVENT_RESPONSE_TOGGLE_SINGLESTEP);
+    EXPECT_EQ(event.slat_id, AltP2mBreakpointEngine::hostView);
+    EXPECT_EQ(event.next_slat_id, testExecuteView);
+}
+
+TEST_F(InterruptEventAltP2mFixture, createInterruptEvent_interruptEventDeactivated_shadowPageRestored)
+{
+    auto interruptEvent =
+        interruptFactory.createInterruptEvent("InterruptName", testVA, testSystemCr3, interruptCallback);
+    EXPECT_CALL(*mockFunction, Call(Ref(*interruptEvent)))
+        .WillOnce(Return(InterruptEvent::InterruptResponse::Deactivate));
+    EXPECT_CALL(*vmiInterface, write8PA(_, _)).Times(AnyNumber());
+    EXPECT_CALL(*vmiInterface, write8PA(testShadowPA, testOriginalMemoryContent)).Times(1).RetiresOnSaturation();
+
+    EXPECT_EQ(InterruptEvent::_defaultInterruptCallback(vmiInstance_stub, &event), VMI_EVENT_RESPONSE_NONE);
+}
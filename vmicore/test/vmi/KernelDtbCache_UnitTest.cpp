@@ -0,0 +1,49 @@
+#include "../../src/vmi/KernelDtbCache.h"
+#include "../../src/vmi/VmiException.h"
+#include "mock_LibvmiInterface.h"
+#include <gtest/gtest.h>
+
+using testing::_;
+using testing::NiceMock;
+using testing::Return;
+using testing::Throw;
+
+namespace
+{
+    constexpr pid_t kernelPid = 4;
+    constexpr uint64_t kernelDtb = 0x1aa000;
+}
+
+class KernelDtbCacheFixture : public testing::Test
+{
+  protected:
+    NiceMock<MockLibvmiInterface> mockVmiInterface;
+    KernelDtbCache kernelDtbCache{mockVmiInterface};
+};
+
+TEST_F(KernelDtbCacheFixture, get_repeatedCalls_resolvedOnce)
+{
+    kernelDtbCache.setKernelPid(kernelPid);
+    EXPECT_CALL(mockVmiInterface, convertPidToDtb(kernelPid)).WillOnce(Return(kernelDtb));
+
+    EXPECT_EQ(kernelDtbCache.get(), kernelDtb);
+    EXPECT_EQ(kernelDtbCache.get(), kernelDtb);
+}
+
+TEST_F(KernelDtbCacheFixture, get_resolutionFailed_resolvedAgainOnNextCall)
+{
+    kernelDtbCache.setKernelPid(kernelPid);
+    EXPECT_CALL(mockVmiInterface, convertPidToDtb(kernelPid))
+        .WillOnce(Throw(VmiException("Unable to obtain the dtb")))
+        .WillOnce(Return(kernelDtb));
+
+    EXPECT_THROW((void)kernelDtbCache.get(), VmiException);
+    EXPECT_EQ(kernelDtbCache.get(), kernelDtb);
+}
+
+TEST_F(KernelDtbCacheFixture, get_unknownKernelPid_throwsVmiException)
+{
+    EXPECT_CALL(mockVmiInterface, convertPidToDtb(_)).Times(0);
+
+    EXPECT_THROW((void)kernelDtbCache.get(), VmiException);
+}
@@ -0,0 +1,116 @@
+#include "../../src/vmi/EventMetrics.h"
+#include "../../src/vmi/LatencyHistogram.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(LatencyHistogramTest, getBucketIndex_smallValues_areExact)
+{
+    for (uint64_t value = 0; value < 2 * LatencyHistogram::subBucketCount; value++)
+    {
+        EXPECT_EQ(LatencyHistogram::getHighestEquivalentValue(LatencyHistogram::getBucketIndex(value)), value);
+    }
+}
+
+TEST(LatencyHistogramTest, getHighestEquivalentValue_largeValues_withinRelativeError)
+{
+    for (uint64_t value : {100ull, 4097ull, 123456789ull, 1ull << 40, ~0ull})
+    {
+        auto bucketIndex = LatencyHistogram::getBucketIndex(value);
+        auto highestEquivalentValue = LatencyHistogram::getHighestEquivalentValue(bucketIndex);
+
+        ASSERT_LT(bucketIndex, LatencyHistogram::numberOfBuckets);
+        EXPECT_GE(highestEquivalentValue, value);
+        EXPECT_LE(highestEquivalentValue - value, value / LatencyHistogram::subBucketCount);
+    }
+}
+
+TEST(LatencyHistogramTest, getValueAtPercentile_uniformValues_returnsPercentiles)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 1000; value++)
+    {
+        histogram.record(value * 1000);
+    }
+
+    EXPECT_EQ(histogram.getCount(), 1000);
+    EXPECT_EQ(histogram.getMaxNanoseconds(), 1000000);
+    EXPECT_NEAR(static_cast<double>(histogram.getValueAtPercentile(50)), 500000, 500000.0 / 16);
+    EXPECT_NEAR(static_cast<double>(histogram.getValueAtPercentile(99)), 990000, 990000.0 / 16);
+    EXPECT_EQ(histogram.getValueAtPercentile(100), 1000000);
+}
+
+TEST(LatencyHistogramTest, getValueAtPercentile_empty_returnsZero)
+{
+    LatencyHistogram histogram;
+
+    EXPECT_EQ(histogram.getValueAtPercentile(50), 0);
+}
+
+TEST(LatencyHistogramTest, record_concurrentThreads_countsAllValues)
+{
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (uint64_t thread = 1; thread <= 4; thread++)
+    {
+        threads.emplace_back(
+            [&histogram, thread]()
+            {
+                for (int i = 0; i < 10000; i++)
+                {
+                    histogram.record(thread);
+                }
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(histogram.getCount(), 40000);
+    EXPECT_EQ(histogram.getTotalNanoseconds(), 100000);
+    EXPECT_EQ(histogram.getMaxNanoseconds(), 4);
+}
+
+TEST(EventMetricsTest, createSnapshot_recordedPauses_pausesOnlyInPauseTotals)
+{
+    EventMetrics eventMetrics;
+    eventMetrics.getLatencyHistogram("TestInterrupt")->record(42);
+    eventMetrics.recordVmPause(std::chrono::microseconds(2));
+    eventMetrics.recordVmPause(std::chrono::microseconds(3));
+
+    auto snapshot = eventMetrics.createSnapshot();
+
+    EXPECT_EQ(snapshot.totalVmPauseNanoseconds, 5000);
+    EXPECT_EQ(snapshot.numberOfVmPauses, 2);
+    ASSERT_EQ(snapshot.eventLatencies.size(), 1);
+    EXPECT_EQ(snapshot.eventLatencies[0].source, "TestInterrupt");
+    EXPECT_EQ(snapshot.eventLatencies[0].maxNanoseconds, 42);
+}
+
+TEST(EventMetricsTest, getLatencyHistogram_builtInSourceName_throws)
+{
+    EventMetrics eventMetrics;
+
+    EXPECT_THROW(eventMetrics.getLatencyHistogram(EventMetrics::vmPauseSource), std::invalid_argument);
+    EXPECT_THROW(eventMetrics.getLatencyHistogram(EventMetrics::singleStepSource), std::invalid_argument);
+    EXPECT_THROW(eventMetrics.getLatencyHistogram(EventMetrics::interruptGuardSource), std::invalid_argument);
+}
+
+TEST(EventMetricsTest, getSingleStepLatencyHistogram_recorded_reportedUnderBuiltInName)
+{
+    EventMetrics eventMetrics;
+    eventMetrics.getSingleStepLatencyHistogram()->record(42);
+
+    auto snapshot = eventMetrics.createSnapshot();
+
+    ASSERT_EQ(snapshot.eventLatencies.size(), 1);
+    EXPECT_EQ(snapshot.eventLatencies[0].source, EventMetrics::singleStepSource);
+}
+
+TEST(EventMetricsTest, getLatencyHistogram_sameSource_returnsSameHistogram)
+{
+    EventMetrics eventMetrics;
+
+    EXPECT_EQ(eventMetrics.getLatencyHistogram("TestInterrupt"), eventMetrics.getLatencyHistogram("TestInterrupt"));
+}
@@ -1,8 +1,12 @@
 #include "../../src/vmi/LibvmiInterface.h"
+#include "../../src/vmi/MemoryDumpInterface.h"
 #include "../../src/vmi/VmiException.h"
 #include "../io/grpc/mock_GRPCLogger.h"
 #include "../io/mock_EventStream.h"
 #include "../io/mock_Logging.h"
+#include "mock_LibvmiInterface.h"
+#include <array>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <memory>
 
@@ -10,23 +14,143 @@ using testing::_;
 using testing::Invoke;
 using testing::NiceMock;
 using testing::Return;
+using testing::StrEq;
+using testing::ThrowsMessage;
 using testing::Unused;
 
+namespace
+{
+    // Exposes the pause accounting, which otherwise requires a running VM to pause
+    class PauseAccountingLibvmiInterface : public LibvmiInterface
+    {
+      public:
+        using LibvmiInterface::beginVmPause;
+        using LibvmiInterface::endVmPause;
+        using LibvmiInterface::LibvmiInterface;
+    };
+}
+
 TEST(LibvmiInterfaceTest, constructor_validVmState_doesNotThrow)
 {
     EXPECT_NO_THROW(LibvmiInterface vmiInterface(std::shared_ptr<IConfigParser>(),
                                                  std::make_shared<NiceMock<MockLogging>>(),
-                                                 std::make_shared<NiceMock<MockEventStream>>()));
+                                                 std::make_shared<NiceMock<MockEventStream>>(),
+                                                 std::make_shared<EventMetrics>()));
 }
 
 TEST(LibvmiInterfaceTest, constructor_initializeSecondInstance_throwsRuntimeError)
 {
     LibvmiInterface firstVmiInterface(std::shared_ptr<IConfigParser>(),
                                       std::make_shared<NiceMock<MockLogging>>(),
-                                      std::make_shared<NiceMock<MockEventStream>>());
+                                      std::make_shared<NiceMock<MockEventStream>>(),
+                                      std::make_shared<EventMetrics>());
 
     EXPECT_THROW(LibvmiInterface secondVmiInterface(std::shared_ptr<IConfigParser>(),
                                                     std::make_shared<NiceMock<MockLogging>>(),
-                                                    std::make_shared<NiceMock<MockEventStream>>()),
+                                                    std::make_shared<NiceMock<MockEventStream>>(),
+                                                    std::make_shared<EventMetrics>()),
                  std::runtime_error);
 }
+
+TEST(LibvmiInterfaceTest, parseCacheInvalidationPolicy_knownPolicies_returnsPolicy)
+{
+    EXPECT_EQ(LibvmiInterface::parseCacheInvalidationPolicy("full"), CacheInvalidationPolicy::Full);
+    EXPECT_EQ(LibvmiInterface::parseCacheInvalidationPolicy("per_address_space"),
+              CacheInvalidationPolicy::PerAddressSpace);
+}
+
+TEST(LibvmiInterfaceTest, parseCacheInvalidationPolicy_unknownPolicy_throwsInvalidArgument)
+{
+    EXPECT_THROW(LibvmiInterface::parseCacheInvalidationPolicy("none"), std::invalid_argument);
+}
+
+TEST(LibvmiInterfaceTest, validateNumberOfReadHandles_readHandlesOnKvm_throwsInvalidArgument)
+{
+    EXPECT_THROW(LibvmiInterface::validateNumberOfReadHandles(VMI_KVM, 2), std::invalid_argument);
+}
+
+TEST(LibvmiInterfaceTest, validateNumberOfReadHandles_noReadHandlesOnKvm_doesNotThrow)
+{
+    EXPECT_NO_THROW(LibvmiInterface::validateNumberOfReadHandles(VMI_KVM, 0));
+}
+
+TEST(LibvmiInterfaceTest, validateNumberOfReadHandles_readHandlesOnXenOrFile_doesNotThrow)
+{
+    EXPECT_NO_THROW(LibvmiInterface::validateNumberOfReadHandles(VMI_XEN, 2));
+    EXPECT_NO_THROW(LibvmiInterface::validateNumberOfReadHandles(VMI_FILE, 2));
+}
+
+TEST(LibvmiInterfaceTest, readBatchVAOrThrow_allRequestsSucceeded_doesNotThrow)
+{
+    NiceMock<MockLibvmiInterface> vmiInterface;
+    ON_CALL(vmiInterface, readBatchVA(_, _)).WillByDefault(Return(true));
+    uint64_t value = 0;
+    std::array requests{ReadRequest::create(0xffff800000001000, value)};
+
+    EXPECT_NO_THROW(vmiInterface.readBatchVAOrThrow(0x1aa000, requests, "caller"));
+}
+
+TEST(LibvmiInterfaceTest, readBatchVAOrThrow_failedRequest_throwsVmiExceptionNamingRequest)
+{
+    NiceMock<MockLibvmiInterface> vmiInterface;
+    ON_CALL(vmiInterface, readBatchVA(_, _))
+        .WillByDefault(
+            [](uint64_t /*cr3*/, std::span<ReadRequest> requests)
+            {
+                requests[0].success = true;
+                return false;
+            });
+    uint64_t firstValue = 0;
+    uint64_t secondValue = 0;
+    std::array requests{ReadRequest::create(0xffff800000001000, firstValue),
+                        ReadRequest::create(0xffff800000002000, secondValue)};
+
+    EXPECT_THAT([&vmiInterface, &requests]() { vmiInterface.readBatchVAOrThrow(0x1aa000, requests, "caller"); },
+                ThrowsMessage<VmiException>(StrEq("caller: Unable to read 8 bytes from VA 0xffff800000002000")));
+}
+
+TEST(LibvmiInterfaceTest, endVmPause_nestedPauses_accountedOnceInPauseTotalsOnly)
+{
+    auto eventMetrics = std::make_shared<EventMetrics>();
+    (void)eventMetrics->getLatencyHistogram("TestInterrupt");
+    PauseAccountingLibvmiInterface vmiInterface(std::shared_ptr<IConfigParser>(),
+                                                std::make_shared<NiceMock<MockLogging>>(),
+                                                std::make_shared<NiceMock<MockEventStream>>(),
+                                                eventMetrics);
+
+    vmiInterface.beginVmPause();
+    vmiInterface.beginVmPause();
+    vmiInterface.endVmPause();
+    vmiInterface.endVmPause();
+
+    auto snapshot = eventMetrics->createSnapshot();
+    EXPECT_EQ(snapshot.numberOfVmPauses, 1);
+    ASSERT_EQ(snapshot.eventLatencies.size(), 1);
+    EXPECT_EQ(snapshot.eventLatencies[0].source, "TestInterrupt");
+    EXPECT_EQ(snapshot.eventLatencies[0].count, 0);
+}
+
+TEST(MemoryDumpInterfaceTest, eventHandling_memoryDump_isNoOp)
+{
+    MemoryDumpInterface dumpInterface(std::shared_ptr<IConfigParser>(),
+                                      std::make_shared<NiceMock<MockLogging>>(),
+                                      std::make_shared<NiceMock<MockEventStream>>(),
+                                      std::make_shared<EventMetrics>());
+    vmi_event_t event{};
+
+    EXPECT_NO_THROW(dumpInterface.pauseVm());
+    EXPECT_NO_THROW(dumpInterface.registerEvent(event));
+    EXPECT_NO_THROW(dumpInterface.waitForEvent());
+    EXPECT_FALSE(dumpInterface.areEventsPending());
+    EXPECT_NO_THROW(dumpInterface.resumeVm());
+}
+
+TEST(MemoryDumpInterfaceTest, write8PA_memoryDump_throwsVmiException)
+{
+    MemoryDumpInterface dumpInterface(std::shared_ptr<IConfigParser>(),
+                                      std::make_shared<NiceMock<MockLogging>>(),
+                                      std::make_shared<NiceMock<MockEventStream>>(),
+                                      std::make_shared<EventMetrics>());
+
+    EXPECT_THROW(dumpInterface.write8PA(0x1000, 0xCC), VmiException);
+}
@@ -0,0 +1,49 @@
+#include "../../src/vmi/LruCache.h"
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(LruCacheTest, find_missingKey_returnsNullptr)
+{
+    LruCache<int, std::string> cache(2);
+
+    EXPECT_EQ(cache.find(1), nullptr);
+}
+
+TEST(LruCacheTest, insert_capacityExceeded_evictsLeastRecentlyUsedEntry)
+{
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+    cache.insert(2, "two");
+    ASSERT_NE(cache.find(1), nullptr);
+
+    cache.insert(3, "three");
+
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(*cache.find(1), "one");
+    EXPECT_EQ(cache.find(2), nullptr);
+    EXPECT_EQ(*cache.find(3), "three");
+}
+
+TEST(LruCacheTest, insert_existingKey_replacesValue)
+{
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+
+    cache.insert(1, "uno");
+
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(*cache.find(1), "uno");
+}
+
+TEST(LruCacheTest, clear_filledCache_removesAllEntries)
+{
+    LruCache<int, std::string> cache(2);
+    cache.insert(1, "one");
+    cache.insert(2, "two");
+
+    cache.clear();
+
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.find(1), nullptr);
+    EXPECT_EQ(cache.find(2), nullptr);
+}
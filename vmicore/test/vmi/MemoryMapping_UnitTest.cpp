@@ -0,0 +1,94 @@
+#include "../../src/os/PagingDefinitions.h"
+#include "../../src/vmi/MemoryMapping.h"
+#include "../io/grpc/mock_GRPCLogger.h"
+#include "../io/mock_Logging.h"
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+
+using testing::_;
+using testing::NiceMock;
+
+class MemoryMappingFixture : public testing::Test
+{
+  protected:
+    const uint64_t guestBaseVA = 0x1234000;
+    const size_t numberOfPages = 3;
+
+    std::shared_ptr<NiceMock<MockLogging>> mockLogging = std::make_shared<NiceMock<MockLogging>>();
+    uint8_t* hostMapping = nullptr;
+
+    void SetUp() override
+    {
+        ON_CALL(*mockLogging, newNamedLogger(_))
+            .WillByDefault([](const std::string& /*name*/) { return std::make_unique<NiceMock<MockGRPCLogger>>(); });
+
+        // Simulates the host pages libvmi maps for the present guest pages
+        hostMapping = static_cast<uint8_t*>(mmap(nullptr,
+                                                 numberOfPages * PagingDefinitions::pageSizeInBytes,
+                                                 PROT_READ | PROT_WRITE,
+                                                 MAP_PRIVATE | MAP_ANONYMOUS,
+                                                 -1,
+                                                 0));
+        ASSERT_NE(hostMapping, MAP_FAILED);
+    }
+
+    [[nodiscard]] void* hostPage(size_t index) const
+    {
+        return hostMapping + index * PagingDefinitions::pageSizeInBytes;
+    }
+};
+
+TEST_F(MemoryMappingFixture, constructor_allPagesMapped_singleRegion)
+{
+    std::vector<void*> accessPointers{hostPage(0), hostPage(1), hostPage(2)};
+
+    MemoryMapping memoryMapping(guestBaseVA, accessPointers, mockLogging);
+
+    ASSERT_EQ(memoryMapping.getMappedRegions().size(), 1);
+    EXPECT_EQ(memoryMapping.getMappedRegions().front().guestBaseVA, guestBaseVA);
+    EXPECT_EQ(memoryMapping.getMappedRegions().front().mapping.data(), hostMapping);
+    EXPECT_EQ(memoryMapping.getMappedRegions().front().mapping.size(),
+              numberOfPages * PagingDefinitions::pageSizeInBytes);
+}
+
+TEST_F(MemoryMappingFixture, constructor_unmappedPageInBetween_twoRegionsWithCorrectGuestAddresses)
+{
+    // libvmi packs present pages densely, so the third guest page is backed by the second host page
+    std::vector<void*> accessPointers{hostPage(0), nullptr, hostPage(1)};
+
+    MemoryMapping memoryMapping(guestBaseVA, accessPointers, mockLogging);
+
+    ASSERT_EQ(memoryMapping.getMappedRegions().size(), 2);
+    EXPECT_EQ(memoryMapping.getMappedRegions()[0].guestBaseVA, guestBaseVA);
+    EXPECT_EQ(memoryMapping.getMappedRegions()[0].mapping.size(), PagingDefinitions::pageSizeInBytes);
+    EXPECT_EQ(memoryMapping.getMappedRegions()[1].guestBaseVA, guestBaseVA + 2 * PagingDefinitions::pageSizeInBytes);
+    EXPECT_EQ(memoryMapping.getMappedRegions()[1].mapping.data(), hostPage(1));
+    EXPECT_EQ(memoryMapping.getSizeInGuest(), numberOfPages * PagingDefinitions::pageSizeInBytes);
+}
+
+TEST_F(MemoryMappingFixture, constructor_noPageMapped_noRegions)
+{
+    std::vector<void*> accessPointers(numberOfPages, nullptr);
+
+    MemoryMapping memoryMapping(guestBaseVA, accessPointers, mockLogging);
+
+    EXPECT_TRUE(memoryMapping.getMappedRegions().empty());
+    EXPECT_EQ(memoryMapping.getSizeInGuest(), numberOfPages * PagingDefinitions::pageSizeInBytes);
+    munmap(hostMapping, numberOfPages * PagingDefinitions::pageSizeInBytes);
+}
+
+TEST_F(MemoryMappingFixture, destructor_hostPagesNotAdjacent_onlyMappedPagesUnmapped)
+{
+    // The second host page is not part of the mapping and has to survive it
+    std::vector<void*> accessPointers{hostPage(0), hostPage(2)};
+
+    {
+        MemoryMapping memoryMapping(guestBaseVA, accessPointers, mockLogging);
+        ASSERT_EQ(memoryMapping.getMappedRegions().size(), 2);
+    }
+
+    EXPECT_NE(msync(hostPage(0), PagingDefinitions::pageSizeInBytes, MS_ASYNC), 0);
+    EXPECT_EQ(msync(hostPage(1), PagingDefinitions::pageSizeInBytes, MS_ASYNC), 0);
+    EXPECT_NE(msync(hostPage(2), PagingDefinitions::pageSizeInBytes, MS_ASYNC), 0);
+    munmap(hostPage(1), PagingDefinitions::pageSizeInBytes);
+}
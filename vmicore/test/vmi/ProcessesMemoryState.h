@@ -44,6 +44,12 @@ namespace _MMVAD_OFFSETS
     constexpr addr_t Subsection = 0x72;
 }
 
+namespace _MMVAD_SIZES
+{
+    constexpr size_t MMVAD = 0x80;
+    constexpr size_t MMVAD_SHORT = 0x38;
+}
+
 namespace __MMVAD_SHORT_OFFSETS
 {
     constexpr addr_t VadNode = 0x0;
@@ -193,9 +199,55 @@ class ProcessesMemoryStateFixture : public testing::Test
 
     std::shared_ptr<Windows::ActiveProcessesSupervisor> activeProcessesSupervisor;
 
+    template <typename Read> static auto tryReadFromMock(Read read) -> std::optional<decltype(read())>
+    {
+        try
+        {
+            return read();
+        }
+        catch (const VmiException&)
+        {
+            return std::nullopt;
+        }
+    }
+
     void setupReturnsForVmiInterface()
     {
         ON_CALL(*mockVmiInterface, convertPidToDtb(Windows::systemPid)).WillByDefault(Return(systemCR3));
+        ON_CALL(*mockVmiInterface, getKernelDtb()).WillByDefault(Return(systemCR3));
+        ON_CALL(*mockVmiInterface, readKernel8(_))
+            .WillByDefault([mockVmiInterface = mockVmiInterface.get(), systemCR3 = systemCR3](uint64_t virtualAddress)
+                           { return mockVmiInterface->read8VA(virtualAddress, systemCR3); });
+        ON_CALL(*mockVmiInterface, readKernel32(_))
+            .WillByDefault([mockVmiInterface = mockVmiInterface.get(), systemCR3 = systemCR3](uint64_t virtualAddress)
+                           { return mockVmiInterface->read32VA(virtualAddress, systemCR3); });
+        ON_CALL(*mockVmiInterface, readKernel64(_))
+            .WillByDefault([mockVmiInterface = mockVmiInterface.get(), systemCR3 = systemCR3](uint64_t virtualAddress)
+                           { return mockVmiInterface->read64VA(virtualAddress, systemCR3); });
+        ON_CALL(*mockVmiInterface, tryRead8VA(_, _))
+            .WillByDefault(
+                [mockVmiInterface = mockVmiInterface.get()](uint64_t virtualAddress, uint64_t cr3)
+                { return tryReadFromMock([&] { return mockVmiInterface->read8VA(virtualAddress, cr3); }); });
+        ON_CALL(*mockVmiInterface, tryRead32VA(_, _))
+            .WillByDefault(
+                [mockVmiInterface = mockVmiInterface.get()](uint64_t virtualAddress, uint64_t cr3)
+                { return tryReadFromMock([&] { return mockVmiInterface->read32VA(virtualAddress, cr3); }); });
+        ON_CALL(*mockVmiInterface, tryRead64VA(_, _))
+            .WillByDefault(
+                [mockVmiInterface = mockVmiInterface.get()](uint64_t virtualAddress, uint64_t cr3)
+                { return tryReadFromMock([&] { return mockVmiInterface->read64VA(virtualAddress, cr3); }); });
+        ON_CALL(*mockVmiInterface, tryReadKernel64(_))
+            .WillByDefault(
+                [mockVmiInterface = mockVmiInterface.get(), systemCR3 = systemCR3](uint64_t virtualAddress)
+                { return tryReadFromMock([&] { return mockVmiInterface->read64VA(virtualAddress, systemCR3); }); });
+        ON_CALL(*mockVmiInterface, tryExtractStringAtVA(_, _))
+            .WillByDefault(
+                [mockVmiInterface = mockVmiInterface.get()](uint64_t virtualAddress, uint64_t cr3)
+                {
+                    auto string =
+                        tryReadFromMock([&] { return mockVmiInterface->extractStringAtVA(virtualAddress, cr3); });
+                    return string && *string ? std::make_optional(**string) : std::nullopt;
+                });
         ON_CALL(*mockVmiInterface, getKernelStructOffset("_KPROCESS", "DirectoryTableBase"))
             .WillByDefault(Return(_KPROCESS_OFFSETS::DirectoryTableBase));
         ON_CALL(*mockVmiInterface, getKernelStructOffset("_EPROCESS", "InheritedFromUniqueProcessId"))
@@ -247,6 +299,54 @@ class ProcessesMemoryStateFixture : public testing::Test
         ON_CALL(*mockVmiInterface, getKernelStructOffset("_RTL_BALANCED_NODE", "Right"))
             .WillByDefault(Return(_RTL_BALANCED_NODE_OFFSETS::Right));
         ON_CALL(*mockVmiInterface, isInitialized()).WillByDefault(Return(true));
+        ON_CALL(*mockVmiInterface, readBatchVA(_, _))
+            .WillByDefault(
+                [mockVmiInterface = mockVmiInterface.get()](uint64_t cr3, std::span<ReadRequest> requests)
+                {
+                    bool allSucceeded = true;
+                    for (auto& request : requests)
+                    {
+                        uint64_t value = 0;
+                        request.success = true;
+                        try
+                        {
+                            switch (request.size)
+                            {
+                                case sizeof(uint8_t):
+                                    value = mockVmiInterface->read8VA(request.virtualAddress, cr3);
+                                    break;
+                                case sizeof(uint32_t):
+                                    value = mockVmiInterface->read32VA(request.virtualAddress, cr3);
+                                    break;
+                                case sizeof(uint64_t):
+                                    value = mockVmiInterface->read64VA(request.virtualAddress, cr3);
+                                    break;
+                                default:
+                                {
+                                    // Struct sized reads, e.g. batched snapshots
+                                    std::vector<uint8_t> buffer(request.size);
+                                    request.success = mockVmiInterface->readXVA(request.virtualAddress, cr3, buffer);
+                                    if (request.success)
+                                    {
+                                        std::memcpy(request.destination, buffer.data(), request.size);
+                                    }
+                                    allSucceeded &= request.success;
+                                    continue;
+                                }
+                            }
+                        }
+                        catch (const VmiException&)
+                        {
+                            request.success = false;
+                        }
+                        if (request.success)
+                        {
+                            std::memcpy(request.destination, &value, request.size);
+                        }
+                        allSucceeded &= request.success;
+                    }
+                    return allSucceeded;
+                });
         ON_CALL(*mockVmiInterface, getBitfieldOffsetAndSizeFromJson("_MMSECTION_FLAGS", "BeingDeleted"))
             .WillByDefault(Return(std::make_tuple(0, SECTION_FLAGS_OFFSETS::beingDeleted, 1)));
         ON_CALL(*mockVmiInterface, getBitfieldOffsetAndSizeFromJson("_MMSECTION_FLAGS", "Image"))
@@ -261,6 +361,12 @@ class ProcessesMemoryStateFixture : public testing::Test
             .WillByDefault(Return(4));
         ON_CALL(*mockVmiInterface, getStructSizeFromJson(KernelStructOffsets::mmsection_flags::structName))
             .WillByDefault(Return(4));
+        ON_CALL(*mockVmiInterface, getStructSizeFromJson("_MMVAD")).WillByDefault(Return(_MMVAD_SIZES::MMVAD));
+        ON_CALL(*mockVmiInterface, getStructSizeFromJson("_MMVAD_SHORT"))
+            .WillByDefault(Return(_MMVAD_SIZES::MMVAD_SHORT));
+        ON_CALL(*mockVmiInterface, readXVA(_, systemCR3, _))
+            .WillByDefault([this](uint64_t virtualAddress, uint64_t cr3, std::vector<uint8_t>& content)
+                           { return composeMmVadSnapshot(virtualAddress, cr3, content); });
     }
 
     void setupProcessWithLink(const processValues& process, uint64_t linkEprocessBase)
@@ -367,6 +473,7 @@ class ProcessesMemoryStateFixture : public testing::Test
 
     uint32_t vadRootNodeRightChildStartingVpn = 444;
     uint32_t vadRootNodeRightChildEndingVpn = 445;
+    uint64_t vadRootNodeRightChildControlAreaAddress = 0x99900 + PagingDefinitions::kernelspaceLowerBoundary;
     uint64_t vadRootNodeRightChildStartingAddress = vadRootNodeRightChildStartingVpn
                                                     << PagingDefinitions::numberOfPageIndexBits;
     uint64_t vadRootNodeChildEndingAddress =
@@ -435,7 +542,6 @@ class ProcessesMemoryStateFixture : public testing::Test
     void systemVadTreeRightChildOfRootNodeMemoryState()
     {
         uint64_t subsectionAddress = 0x88800 + PagingDefinitions::kernelspaceLowerBoundary;
-        uint64_t controlAreaAddress = 0x99900 + PagingDefinitions::kernelspaceLowerBoundary;
         uint64_t filePointerObjectAddress = 0x2340 + PagingDefinitions::kernelspaceLowerBoundary;
 
         ON_CALL(*mockVmiInterface,
@@ -463,14 +569,17 @@ class ProcessesMemoryStateFixture : public testing::Test
         ON_CALL(*mockVmiInterface, read64VA(vadRootNodeRightChildBase + _MMVAD_OFFSETS::Subsection, systemCR3))
             .WillByDefault(Return(subsectionAddress));
         ON_CALL(*mockVmiInterface, read64VA(subsectionAddress + _SUBSECTION_OFFSETS::ControlArea, systemCR3))
-            .WillByDefault(Return(controlAreaAddress));
-        ON_CALL(*mockVmiInterface, read64VA(controlAreaAddress + _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, systemCR3))
+            .WillByDefault(Return(vadRootNodeRightChildControlAreaAddress));
+        ON_CALL(*mockVmiInterface,
+                read64VA(vadRootNodeRightChildControlAreaAddress + _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, systemCR3))
             .WillByDefault(Return(process4.sectionFlags));
-        ON_CALL(*mockVmiInterface, read32VA(controlAreaAddress + _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, systemCR3))
+        ON_CALL(*mockVmiInterface,
+                read32VA(vadRootNodeRightChildControlAreaAddress + _CONTROL_AREA_OFFSETS::MMSECTION_FLAGS, systemCR3))
             .WillByDefault(Return(process4.sectionFlags));
-        ON_CALL(
-            *mockVmiInterface,
-            read64VA(controlAreaAddress + _CONTROL_AREA_OFFSETS::FilePointer + _EX_FAST_REF_OFFSETS::Object, systemCR3))
+        ON_CALL(*mockVmiInterface,
+                read64VA(vadRootNodeRightChildControlAreaAddress + _CONTROL_AREA_OFFSETS::FilePointer +
+                             _EX_FAST_REF_OFFSETS::Object,
+                         systemCR3))
             .WillByDefault(Return(filePointerObjectAddress));
         ON_CALL(*mockVmiInterface,
                 extractUnicodeStringAtVA((filePointerObjectAddress) + _FILE_OBJECT_OFFSETS::FileName, systemCR3))
@@ -511,6 +620,52 @@ class ProcessesMemoryStateFixture : public testing::Test
                 Return(createMmvadFlags(static_cast<uint32_t>(Windows::ProtectionValues::MM_READWRITE), true)));
     }
 
+    // Assembles a _MMVAD snapshot from the values returned by the single field read mocks
+    bool composeMmVadSnapshot(uint64_t vadEntryBaseVA, uint64_t cr3, std::vector<uint8_t>& content)
+    {
+        const std::vector<std::pair<addr_t, size_t>> fields{
+            {_MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::VadNode + _RTL_BALANCED_NODE_OFFSETS::Left,
+             sizeof(uint64_t)},
+            {_MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::VadNode + _RTL_BALANCED_NODE_OFFSETS::Right,
+             sizeof(uint64_t)},
+            {_MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::StartingVpn, sizeof(uint32_t)},
+            {_MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::EndingVpn, sizeof(uint32_t)},
+            {_MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::StartingVpnHigh, sizeof(uint8_t)},
+            {_MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::EndingVpnHigh, sizeof(uint8_t)},
+            {_MMVAD_OFFSETS::BaseAddress + __MMVAD_SHORT_OFFSETS::Flags, sizeof(uint32_t)},
+            {_MMVAD_OFFSETS::Subsection, sizeof(uint64_t)}};
+
+        std::fill(content.begin(), content.end(), 0);
+        try
+        {
+            for (const auto& [offset, size] : fields)
+            {
+                if (offset + size > content.size())
+                {
+                    continue;
+                }
+                uint64_t value = 0;
+                switch (size)
+                {
+                    case sizeof(uint8_t):
+                        value = mockVmiInterface->read8VA(vadEntryBaseVA + offset, cr3);
+                        break;
+                    case sizeof(uint32_t):
+                        value = mockVmiInterface->read32VA(vadEntryBaseVA + offset, cr3);
+                        break;
+                    default:
+                        value = mockVmiInterface->read64VA(vadEntryBaseVA + offset, cr3);
+                }
+                std::memcpy(content.data() + offset, &value, size);
+            }
+        }
+        catch (const VmiException&)
+        {
+            return false;
+        }
+        return true;
+    }
+
     static uint32_t createMmvadFlags(uint32_t protection, bool privateMemory)
     {
         uint32_t flags = protection << MMVAD_FLAGS_OFFSETS::protection | privateMemory
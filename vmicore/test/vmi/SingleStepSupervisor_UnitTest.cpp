@@ -16,9 +16,10 @@ TEST(SingleStepSupervisorTest, constructor_multipleInstances_throwsRuntimeError)
         .WillByDefault([](const std::string& /*name*/) { return std::make_unique<MockGRPCLogger>(); });
 
     std::shared_ptr<ILibvmiInterface> vmiInterface = std::make_shared<MockLibvmiInterface>();
-    SingleStepSupervisor firstInstance(vmiInterface, mockLogging);
+    SingleStepSupervisor firstInstance(vmiInterface, mockLogging, std::make_shared<EventMetrics>());
 
-    EXPECT_THROW(SingleStepSupervisor secondInstance(vmiInterface, mockLogging), std::runtime_error);
+    EXPECT_THROW(SingleStepSupervisor secondInstance(vmiInterface, mockLogging, std::make_shared<EventMetrics>()),
+                 std::runtime_error);
 }
 
 class SingleStepSupvervisorValidStateFixture : public testing::Test
@@ -42,7 +43,8 @@ class SingleStepSupvervisorValidStateFixture : public testing::Test
             .WillByDefault([](const std::string& /*name*/) { return std::make_unique<MockGRPCLogger>(); });
 
         ON_CALL(*vmiInterface, getNumberOfVCPUs()).WillByDefault(Return(numberOfTestVcpus));
-        singleStepSupervisor = std::make_unique<SingleStepSupervisor>(vmiInterface, mockLogging);
+        singleStepSupervisor =
+            std::make_unique<SingleStepSupervisor>(vmiInterface, mockLogging, std::make_shared<EventMetrics>());
         singleStepSupervisor->initializeSingleStepEvents();
     }
 };
@@ -84,3 +86,23 @@ TEST_F(SingleStepSupvervisorValidStateFixture, setSingleStepCallback_validCallba
     EXPECT_CALL(*vmiInterface, stopSingleStepForVcpu(&testEvent, testVcpuId)).Times(AtLeast(1));
     EXPECT_NO_THROW(SingleStepSupervisor::_defaultSingleStepCallback(0, &testEvent));
 }
+
+TEST_F(SingleStepSupvervisorValidStateFixture, setSingleStepCallback_callbackChangesSlatView_respondsWithSlatId)
+{
+    singleStepSupervisor->setSingleStepCallback(testVcpuId, callbackFunction);
+    vmi_event_t testEvent{};
+    testEvent.vcpu_id = testVcpuId;
+
+    EXPECT_CALL(*mockFunction, Call(_)).WillOnce([](vmi_event_t* event) { event->slat_id = 1; });
+    EXPECT_EQ(SingleStepSupervisor::_defaultSingleStepCallback(0, &testEvent), VMI_EVENT_RESPONSE_SLAT_ID);
+}
+
+TEST_F(SingleStepSupvervisorValidStateFixture, setSingleStepCallback_callbackKeepsSlatView_respondsWithNone)
+{
+    singleStepSupervisor->setSingleStepCallback(testVcpuId, callbackFunction);
+    vmi_event_t testEvent{};
+    testEvent.vcpu_id = testVcpuId;
+
+    EXPECT_CALL(*mockFunction, Call(_)).Times(1);
+    EXPECT_EQ(SingleStepSupervisor::_defaultSingleStepCallback(0, &testEvent), VMI_EVENT_RESPONSE_NONE);
+}
@@ -0,0 +1,77 @@
+#include "../../src/vmi/TranslationCacheInvalidator.h"
+#include "mock_LibvmiInterface.h"
+#include <gtest/gtest.h>
+
+using testing::_;
+using testing::NiceMock;
+
+namespace
+{
+    constexpr uint64_t kernelDtb = 0x1aa000;
+    constexpr uint64_t processDtb = 0x2bb000;
+}
+
+class TranslationCacheInvalidatorFixture : public testing::Test
+{
+  protected:
+    NiceMock<MockLibvmiInterface> mockVmiInterface;
+    TranslationCacheInvalidator translationCacheInvalidator{mockVmiInterface};
+};
+
+TEST_F(TranslationCacheInvalidatorFixture, invalidate_fullPolicy_flushesAllTranslations)
+{
+    EXPECT_CALL(mockVmiInterface, flushV2PCache(ILibvmiInterface::flushAllPTs)).Times(1);
+
+    translationCacheInvalidator.invalidate();
+}
+
+TEST_F(TranslationCacheInvalidatorFixture, expireStaleTranslations_fullPolicy_noFlush)
+{
+    translationCacheInvalidator.invalidate();
+    EXPECT_CALL(mockVmiInterface, flushV2PCache(_)).Times(0);
+
+    translationCacheInvalidator.expireStaleTranslations(processDtb);
+}
+
+TEST_F(TranslationCacheInvalidatorFixture, invalidate_perAddressSpacePolicy_noImmediateFlush)
+{
+    translationCacheInvalidator.setPolicy(CacheInvalidationPolicy::PerAddressSpace);
+    EXPECT_CALL(mockVmiInterface, flushV2PCache(_)).Times(0);
+
+    translationCacheInvalidator.invalidate();
+}
+
+TEST_F(TranslationCacheInvalidatorFixture, expireStaleTranslations_noEventSinceFirstAccess_noFlush)
+{
+    translationCacheInvalidator.setPolicy(CacheInvalidationPolicy::PerAddressSpace);
+    EXPECT_CALL(mockVmiInterface, flushV2PCache(_)).Times(0);
+
+    translationCacheInvalidator.expireStaleTranslations(processDtb);
+    translationCacheInvalidator.expireStaleTranslations(processDtb);
+}
+
+TEST_F(TranslationCacheInvalidatorFixture, expireStaleTranslations_eventSinceLastAccess_flushesOnlyThisAddressSpaceOnce)
+{
+    translationCacheInvalidator.setPolicy(CacheInvalidationPolicy::PerAddressSpace);
+    translationCacheInvalidator.expireStaleTranslations(processDtb);
+    translationCacheInvalidator.expireStaleTranslations(kernelDtb);
+    translationCacheInvalidator.invalidate();
+    EXPECT_CALL(mockVmiInterface, flushV2PCache(_)).Times(0);
+    EXPECT_CALL(mockVmiInterface, flushV2PCache(processDtb)).Times(1);
+
+    translationCacheInvalidator.expireStaleTranslations(processDtb);
+    translationCacheInvalidator.expireStaleTranslations(processDtb);
+}
+
+TEST_F(TranslationCacheInvalidatorFixture, expireStaleTranslations_kernelDtbAfterEvent_flushesKernelTranslations)
+{
+    translationCacheInvalidator.setPolicy(CacheInvalidationPolicy::PerAddressSpace);
+    translationCacheInvalidator.expireStaleTranslations(kernelDtb);
+    EXPECT_CALL(mockVmiInterface, flushV2PCache(kernelDtb)).Times(2);
+
+    for (int event = 0; event < 2; event++)
+    {
+        translationCacheInvalidator.invalidate();
+        translationCacheInvalidator.expireStaleTranslations(kernelDtb);
+    }
+}
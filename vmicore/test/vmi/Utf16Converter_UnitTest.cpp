@@ -0,0 +1,32 @@
+#include "../../src/vmi/Utf16Converter.h"
+#include <gtest/gtest.h>
+
+TEST(Utf16ConverterTest, toUtf8_emptyString_returnsEmptyString)
+{
+    EXPECT_EQ(Utf16Converter::toUtf8(u""), "");
+}
+
+TEST(Utf16ConverterTest, toUtf8_asciiPath_returnsIdenticalBytes)
+{
+    EXPECT_EQ(Utf16Converter::toUtf8(u"\\Windows\\System32\\ntdll.dll"), "\\Windows\\System32\\ntdll.dll");
+}
+
+TEST(Utf16ConverterTest, toUtf8_multiByteCharacters_encodesEachCodePoint)
+{
+    EXPECT_EQ(Utf16Converter::toUtf8(u"C:\\Users\\J\u00FCrgen\\\u6587\u4EF6.txt"),
+              "C:\\Users\\J\xC3\xBCrgen\\\xE6\x96\x87\xE4\xBB\xB6.txt");
+}
+
+TEST(Utf16ConverterTest, toUtf8_surrogatePairAcrossVectorBoundary_encodesSupplementaryCodePoint)
+{
+    // The emoji's high surrogate is the eighth code unit, so the pair spans two vectors
+    EXPECT_EQ(Utf16Converter::toUtf8(u"abcdefg\U0001F600hij"), "abcdefg\xF0\x9F\x98\x80hij");
+}
+
+TEST(Utf16ConverterTest, toUtf8_unpairedSurrogates_replacedByReplacementCharacter)
+{
+    const std::u16string utf16{u'a', char16_t{0xD800}, u'b', char16_t{0xDC00}};
+
+    EXPECT_EQ(Utf16Converter::toUtf8(utf16), "a\xEF\xBF\xBD"
+                                             "b\xEF\xBF\xBD");
+}
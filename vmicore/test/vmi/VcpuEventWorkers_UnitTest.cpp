@@ -0,0 +1,54 @@
+#include "../../src/vmi/VcpuEventWorkers.h"
+#include "../../src/vmi/VmiException.h"
+#include <atomic>
+#include <future>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(VcpuEventWorkersTest, dispatch_multipleWorkItemsForOneVcpu_processedInDispatchOrder)
+{
+    std::vector<int> processingOrder;
+    VcpuEventWorkers eventWorkers(2);
+
+    for (int i = 0; i < 10; i++)
+    {
+        eventWorkers.dispatch(1, [&processingOrder, i]() { processingOrder.push_back(i); });
+    }
+    eventWorkers.drain();
+
+    EXPECT_EQ(processingOrder, std::vector<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+}
+
+TEST(VcpuEventWorkersTest, dispatch_blockedWorkOnOtherVcpu_workProcessedAnyway)
+{
+    std::promise<void> unblockVcpu0;
+    std::promise<void> vcpu1Done;
+    VcpuEventWorkers eventWorkers(2);
+
+    eventWorkers.dispatch(0, [future = unblockVcpu0.get_future().share()]() { future.wait(); });
+    eventWorkers.dispatch(1, [&vcpu1Done]() { vcpu1Done.set_value(); });
+
+    EXPECT_EQ(vcpu1Done.get_future().wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    unblockVcpu0.set_value();
+}
+
+TEST(VcpuEventWorkersTest, drain_workOnAllVcpus_allWorkFinished)
+{
+    std::atomic<int> numberOfFinishedWorkItems = 0;
+    VcpuEventWorkers eventWorkers(4);
+
+    for (uint vcpuId = 0; vcpuId < 4; vcpuId++)
+    {
+        eventWorkers.dispatch(vcpuId, [&numberOfFinishedWorkItems]() { numberOfFinishedWorkItems++; });
+    }
+    eventWorkers.drain();
+
+    EXPECT_EQ(numberOfFinishedWorkItems, 4);
+}
+
+TEST(VcpuEventWorkersTest, dispatch_unknownVcpu_throws)
+{
+    VcpuEventWorkers eventWorkers(1);
+
+    EXPECT_THROW(eventWorkers.dispatch(1, []() {}), VmiException);
+}
@@ -0,0 +1,55 @@
+#include "../../src/vmi/VmiReadHandlePool.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <thread>
+
+namespace
+{
+    // Instances are never used for actual reads in these tests. vmi_destroy ignores null instances.
+    const std::vector<vmi_instance_t> twoInstances{nullptr, nullptr};
+}
+
+TEST(VmiReadHandlePoolTest, getHandleIndexForCurrentThread_repeatedCalls_sameHandle)
+{
+    VmiReadHandlePool readHandlePool(twoInstances);
+
+    auto firstIndex = readHandlePool.getHandleIndexForCurrentThread();
+
+    EXPECT_EQ(readHandlePool.getHandleIndexForCurrentThread(), firstIndex);
+}
+
+TEST(VmiReadHandlePoolTest, getHandleIndexForCurrentThread_fourThreads_threadsDistributedEvenly)
+{
+    VmiReadHandlePool readHandlePool(twoInstances);
+    std::vector<size_t> handleIndices(4);
+
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < handleIndices.size(); i++)
+    {
+        threads.emplace_back([&readHandlePool, &handleIndices, i]()
+                             { handleIndices[i] = readHandlePool.getHandleIndexForCurrentThread(); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(std::count(handleIndices.begin(), handleIndices.end(), 0), 2);
+    EXPECT_EQ(std::count(handleIndices.begin(), handleIndices.end(), 1), 2);
+}
+
+TEST(VmiReadHandlePoolTest, read_threeReadsFromOneThread_readsCountedForHandleOfThread)
+{
+    VmiReadHandlePool readHandlePool(twoInstances);
+    auto handleIndex = readHandlePool.getHandleIndexForCurrentThread();
+
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(readHandlePool.read([](vmi_instance_t /*instance*/) { return VMI_SUCCESS; }), VMI_SUCCESS);
+    }
+
+    auto utilization = readHandlePool.getUtilization();
+    ASSERT_EQ(utilization.size(), 2);
+    EXPECT_EQ(utilization[handleIndex].numberOfReads, 3);
+    EXPECT_EQ(utilization[1 - handleIndex].numberOfReads, 0);
+}
@@ -15,6 +15,8 @@ class MockLibvmiInterface : public ILibvmiInterface
 
     MOCK_METHOD(uint32_t, read32PA, (const uint64_t pyhsicalAddress), (override));
 
+    MOCK_METHOD(bool, readPA, (uint64_t physicalAddress, std::span<uint8_t> content), (override));
+
     MOCK_METHOD(uint8_t, read8VA, (const uint64_t virtualAddress, const uint64_t cr3), (override));
 
     MOCK_METHOD(uint32_t, read32VA, (const uint64_t virtualAddress, const uint64_t cr3), (override));
@@ -26,11 +28,34 @@ class MockLibvmiInterface : public ILibvmiInterface
                 (const uint64_t virtualAddress, const uint64_t cr3, std::vector<uint8_t>& content),
                 (override));
 
+    MOCK_METHOD(uint8_t, readKernel8, (const uint64_t virtualAddress), (override));
+
+    MOCK_METHOD(uint32_t, readKernel32, (const uint64_t virtualAddress), (override));
+
+    MOCK_METHOD(uint64_t, readKernel64, (const uint64_t virtualAddress), (override));
+
+    MOCK_METHOD(std::optional<uint8_t>, tryRead8VA, (uint64_t virtualAddress, uint64_t cr3), (override));
+
+    MOCK_METHOD(std::optional<uint32_t>, tryRead32VA, (uint64_t virtualAddress, uint64_t cr3), (override));
+
+    MOCK_METHOD(std::optional<uint64_t>, tryRead64VA, (uint64_t virtualAddress, uint64_t cr3), (override));
+
+    MOCK_METHOD(std::optional<uint64_t>, tryReadKernel64, (uint64_t virtualAddress), (override));
+
+    MOCK_METHOD(bool, readBatchVA, (uint64_t cr3, std::span<ReadRequest> requests), (override));
+
+    MOCK_METHOD(std::unique_ptr<IMemoryMapping>,
+                mmapGuest,
+                (uint64_t baseVA, uint64_t cr3, size_t numberOfPages),
+                (override));
+
     MOCK_METHOD(void, write8PA, (const uint64_t physicalAddress, const uint8_t value), (override));
 
     MOCK_METHOD(void, write32PA, (const uint64_t physicalAddress, const uint32_t value), (override));
 
-    MOCK_METHOD(void, waitForEvent, (), (override));
+    MOCK_METHOD(void, writePA, (uint64_t physicalAddress, std::span<const uint8_t> content), (override));
+
+    MOCK_METHOD(uint, waitForEvent, (), (override));
 
     MOCK_METHOD(void, registerEvent, (vmi_event_t & event), (override));
 
@@ -42,10 +67,19 @@ class MockLibvmiInterface : public ILibvmiInterface
 
     MOCK_METHOD(uint64_t, convertVAToPA, (uint64_t virtualAddress, uint64_t cr3Register), (override));
 
+    MOCK_METHOD(std::vector<PageTranslation>,
+                translateRange,
+                (uint64_t virtualAddress, uint64_t size, uint64_t cr3),
+                (override));
+
     MOCK_METHOD(uint64_t, convertPidToDtb, (pid_t processID), (override));
 
     MOCK_METHOD(pid_t, convertDtbToPid, (uint64_t dtb), (override));
 
+    MOCK_METHOD(void, setKernelPid, (pid_t pid), (override));
+
+    MOCK_METHOD(uint64_t, getKernelDtb, (), (override));
+
     MOCK_METHOD(void, pauseVm, (), (override));
 
     MOCK_METHOD(void, resumeVm, (), (override));
@@ -62,8 +96,27 @@ class MockLibvmiInterface : public ILibvmiInterface
                 (const uint64_t virtualAddress, const uint64_t cr3),
                 (override));
 
+    MOCK_METHOD(std::optional<std::string>,
+                tryExtractStringAtVA,
+                (uint64_t virtualAddress, uint64_t cr3),
+                (override));
+
     MOCK_METHOD(void, stopSingleStepForVcpu, (vmi_event_t * event, uint vcpuId), (override));
 
+    MOCK_METHOD(void, setSlatEnabled, (bool enabled), (override));
+
+    MOCK_METHOD(uint16_t, createSlatView, (), (override));
+
+    MOCK_METHOD(void, destroySlatView, (uint16_t view), (override));
+
+    MOCK_METHOD(void, switchSlatView, (uint16_t view), (override));
+
+    MOCK_METHOD(void, changeSlatGfn, (uint16_t view, uint64_t gfn, uint64_t newGfn), (override));
+
+    MOCK_METHOD(uint64_t, allocateGfn, (), (override));
+
+    MOCK_METHOD(void, freeGfn, (uint64_t gfn), (override));
+
     MOCK_METHOD(os_t, getOsType, (), (override));
 
     MOCK_METHOD(uint64_t, getOffset, (const std::string& name), (override));
@@ -82,6 +135,10 @@ class MockLibvmiInterface : public ILibvmiInterface
     MOCK_METHOD(void, flushV2PCache, (addr_t), (override));
 
     MOCK_METHOD(void, flushPageCache, (), (override));
+
+    MOCK_METHOD(void, invalidateCaches, (), (override));
+
+    MOCK_METHOD(uint64_t, getNumberOfLibvmiCalls, (), (override));
 };
 
 #endif // VMICORE_MOCK_LIBVMIINTERFACE_H